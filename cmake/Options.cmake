@@ -11,3 +11,7 @@ set(protobuf_BUILD_SHARED_LIBS OFF)
 set(protobuf_MSVC_STATIC_RUNTIME OFF)
 set(protobuf_DISABLE_RTTI OFF)
 set(protobuf_BUILD_PROTOC_BINARIES ON)
+
+# Build-time minimum log level (TRACE, DEBUG, INFO, WARN, ERROR, CRITICAL); LOG_* calls below it compile out.
+# Empty keeps the default: TRACE for debug builds, INFO otherwise.
+set(ICECAP_LOG_ACTIVE_LEVEL "" CACHE STRING "Lowest log level compiled into the agent")
@@ -14,15 +14,41 @@ add_library(icecap-agent SHARED
     src/transport/TcpServer.cpp
     src/transport/ProtocolHandler.cpp
     src/transport/NetworkManager.cpp
+    src/transport/MetricsServer.cpp
 
     # Core business logic
     src/core/MessageProcessor.cpp
     src/core/CommandExecutor.cpp
     src/core/EventPublisher.cpp
+    src/core/WatchManager.cpp
+    src/core/PathFollower.cpp
+    src/core/TaskScheduler.cpp
+    src/core/TimerWheel.cpp
+    src/core/RecurringTaskManager.cpp
+    src/core/StateMachineEngine.cpp
+    src/core/ProcessMemoryRegionSource.cpp
+    src/core/ObjectSnapshot.cpp
+    src/core/SpatialIndex.cpp
+    src/core/GameStatePublisher.cpp
+    src/core/PositionHistory.cpp
+    src/core/MemoryGather.cpp
+    src/core/ObjectQuery.cpp
+    src/core/GameEventStream.cpp
+    src/core/PageCachedMemoryReader.cpp
+    src/core/GameEventAggregator.cpp
+    src/core/SignatureScanner.cpp
+    src/core/GameAddresses.cpp
+    src/core/CommandLatency.cpp
+    src/core/AgentMetrics.cpp
+    src/core/Tracer.cpp
+    src/core/FrameStallWatchdog.cpp
+    src/core/FrameTiming.cpp
+    src/core/ScriptProfiler.cpp
 
     # Hook implementations
     src/hooks/BaseHook.cpp
     src/hooks/D3D9Hook.cpp
+    src/hooks/FrameScriptHook.cpp
     src/hooks/HookRegistry.cpp
 
     # Public headers - Interfaces
@@ -30,20 +56,49 @@ add_library(icecap-agent SHARED
     include/icecap/agent/interfaces/IMessageHandler.hpp
     include/icecap/agent/interfaces/INetworkProtocol.hpp
     include/icecap/agent/interfaces/IHookRegistry.hpp
+    include/icecap/agent/interfaces/IMemoryReader.hpp
+    include/icecap/agent/interfaces/IMemoryRegionSource.hpp
+    include/icecap/agent/interfaces/IScriptObserver.hpp
 
     # Public headers - Transport
     include/icecap/agent/transport/TcpServer.hpp
     include/icecap/agent/transport/ProtocolHandler.hpp
     include/icecap/agent/transport/NetworkManager.hpp
+    include/icecap/agent/transport/MetricsServer.hpp
 
     # Public headers - Core
     include/icecap/agent/core/MessageProcessor.hpp
     include/icecap/agent/core/CommandExecutor.hpp
     include/icecap/agent/core/EventPublisher.hpp
+    include/icecap/agent/core/WatchManager.hpp
+    include/icecap/agent/core/PathFollower.hpp
+    include/icecap/agent/core/TaskScheduler.hpp
+    include/icecap/agent/core/TimerWheel.hpp
+    include/icecap/agent/core/RecurringTaskManager.hpp
+    include/icecap/agent/core/StateMachineEngine.hpp
+    include/icecap/agent/core/ProcessMemoryRegionSource.hpp
+    include/icecap/agent/core/ObjectSnapshot.hpp
+    include/icecap/agent/core/SpatialIndex.hpp
+    include/icecap/agent/core/GameStatePublisher.hpp
+    include/icecap/agent/core/PositionHistory.hpp
+    include/icecap/agent/core/MemoryGather.hpp
+    include/icecap/agent/core/ObjectQuery.hpp
+    include/icecap/agent/core/GameEventStream.hpp
+    include/icecap/agent/core/PageCachedMemoryReader.hpp
+    include/icecap/agent/core/GameEventAggregator.hpp
+    include/icecap/agent/core/SignatureScanner.hpp
+    include/icecap/agent/core/GameAddresses.hpp
+    include/icecap/agent/core/CommandLatency.hpp
+    include/icecap/agent/core/AgentMetrics.hpp
+    include/icecap/agent/core/Tracer.hpp
+    include/icecap/agent/core/FrameStallWatchdog.hpp
+    include/icecap/agent/core/FrameTiming.hpp
+    include/icecap/agent/core/ScriptProfiler.hpp
 
     # Public headers - Hooks
     include/icecap/agent/hooks/BaseHook.hpp
     include/icecap/agent/hooks/D3D9Hook.hpp
+    include/icecap/agent/hooks/FrameScriptHook.hpp
     include/icecap/agent/hooks/HookRegistry.hpp
 
     # Public headers - Legacy/General
@@ -64,10 +119,16 @@ endif()
 set_target_properties(icecap-agent PROPERTIES
     CXX_STANDARD 20
     CXX_STANDARD_REQUIRED ON
-    COMPILE_OPTIONS "-m32"
-    LINK_FLAGS "-m32 -static-libgcc -static-libstdc++"
 )
 
+# GCC/MinGW flags; MSVC targets 32-bit through the generator platform (-A Win32) and enables SSE2 by default
+if(NOT MSVC)
+    set_target_properties(icecap-agent PROPERTIES
+        COMPILE_OPTIONS "-m32;-msse2"
+        LINK_FLAGS "-m32 -static-libgcc -static-libstdc++"
+    )
+endif()
+
 
 target_compile_definitions(icecap-agent PRIVATE
     WIN32_LEAN_AND_MEAN
@@ -75,6 +136,12 @@ target_compile_definitions(icecap-agent PRIVATE
     _WINSOCK_DEPRECATED_NO_WARNINGS
 )
 
+if(ICECAP_LOG_ACTIVE_LEVEL)
+    target_compile_definitions(icecap-agent PRIVATE
+        ICECAP_LOG_ACTIVE_LEVEL=ICECAP_LOG_LEVEL_${ICECAP_LOG_ACTIVE_LEVEL}
+    )
+endif()
+
 # Include directories
 target_include_directories(icecap-agent
     PUBLIC include
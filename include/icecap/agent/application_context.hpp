@@ -11,7 +11,25 @@
 #include "icecap/agent/v1/commands.pb.h"
 #include "icecap/agent/v1/events.pb.h"
 
+#include "core/AgentMetrics.hpp"
+#include "core/FrameStallWatchdog.hpp"
+#include "core/FrameTiming.hpp"
+#include "core/GameEventAggregator.hpp"
+#include "core/GameEventStream.hpp"
+#include "core/GameStatePublisher.hpp"
+#include "core/ObjectSnapshot.hpp"
+#include "core/PageCachedMemoryReader.hpp"
+#include "core/PathFollower.hpp"
+#include "core/PositionHistory.hpp"
+#include "core/ProcessMemoryRegionSource.hpp"
+#include "core/SpatialIndex.hpp"
+#include "core/RecurringTaskManager.hpp"
+#include "core/ScriptProfiler.hpp"
+#include "core/StateMachineEngine.hpp"
+#include "core/TaskScheduler.hpp"
+#include "core/WatchManager.hpp"
 #include "interfaces/IApplicationContext.hpp"
+#include "transport/MetricsServer.hpp"
 #include "transport/NetworkManager.hpp"
 
 namespace icecap::agent {
@@ -19,6 +37,8 @@ namespace icecap::agent {
 // Message type aliases
 using IncomingMessage = icecap::agent::v1::Command;
 using OutgoingMessage = icecap::agent::v1::Event;
+using interfaces::QueuedCommand;
+using interfaces::QueuedEvent;
 
 /**
  * Application context that manages the lifecycle and dependencies
@@ -51,29 +71,91 @@ public:
     transport::NetworkManager& getNetworkManager();
 
     // Get message queues
-    std::queue<IncomingMessage>& getInboxQueue() override;
-    std::queue<OutgoingMessage>& getOutboxQueue() override;
+    std::queue<QueuedCommand>& getInboxQueue() override;
+    std::queue<QueuedEvent>& getOutboxQueue() override;
 
     // Get mutexes
     std::mutex& getInboxMutex() override;
     std::mutex& getOutboxMutex() override;
 
+    // Get render-thread state
+    core::WatchManager& getWatchManager() override;
+    core::PathFollower& getPathFollower() override;
+    core::TaskScheduler& getTaskScheduler() override;
+    core::RecurringTaskManager& getRecurringTaskManager() override;
+    core::StateMachineEngine& getStateMachineEngine() override;
+    core::ObjectSnapshotEngine& getObjectSnapshotEngine() override;
+    core::SpatialIndex& getSpatialIndex() override;
+    core::PositionHistory& getPositionHistory() override;
+    core::FrameStallWatchdog& getFrameStallWatchdog() override;
+    core::ScriptProfiler& getScriptProfiler() override;
+    core::FrameTimingStats& getFrameTiming() override;
+
+    // Get cross-thread game state
+    core::GameStatePublisher& getGameStatePublisher() override;
+    core::GameEventStream& getGameEventStream() override;
+    core::CommandLatencyRecorder& getCommandLatency() override;
+    core::AgentMetrics& getMetrics() override;
+    core::GameEventAggregator& getGameEventAggregator() override;
+    core::PageCachedMemoryReader& getMemoryReader() override;
+
     // Get module handle
     HMODULE getModuleHandle() const override;
 
 private:
+    // Resolved game addresses are cached in this file next to the agent DLL
+    static constexpr const char* kAddressCacheFile = "icecap-addresses.cache";
+
+    // Setting this environment variable to a port enables the metrics scrape listener
+    static constexpr const char* kMetricsPortVariable = "ICECAP_METRICS_PORT";
+
+    // Resolve core::GameAddresses for the running client
+    void resolveGameAddresses();
+
+    // Start the metrics listener if kMetricsPortVariable names a port
+    void startMetricsServer();
+
     std::atomic<bool> m_running{false};
     HMODULE m_hModule{nullptr};
 
     // Network management
     std::unique_ptr<transport::NetworkManager> m_networkManager;
+    std::unique_ptr<transport::MetricsServer> m_metricsServer;
 
     // Message queues and synchronization
-    std::queue<IncomingMessage> m_inboxQueue;
-    std::queue<OutgoingMessage> m_outboxQueue;
+    std::queue<QueuedCommand> m_inboxQueue;
+    std::queue<QueuedEvent> m_outboxQueue;
     std::mutex m_inboxMutex;
     std::mutex m_outboxMutex;
 
+    // Render-thread state (only touched from the EndScene hook)
+    core::WatchManager m_watchManager;
+    core::PathFollower m_pathFollower;
+    core::TaskScheduler m_taskScheduler;
+    core::RecurringTaskManager m_recurringTaskManager;
+    core::StateMachineEngine m_stateMachineEngine;
+    core::ObjectSnapshotEngine m_objectSnapshotEngine;
+    core::SpatialIndex m_spatialIndex;
+    core::PositionHistory m_positionHistory;
+    core::GameEventAggregator m_gameEventAggregator;
+    core::FrameStallWatchdog m_frameStallWatchdog;
+    core::ScriptProfiler m_scriptProfiler{m_frameStallWatchdog};
+
+    // Published by the render thread, read by the network thread
+    core::GameStatePublisher m_gameStatePublisher;
+    core::FrameTimingStats m_frameTiming;
+
+    // Filled by the FrameScript hook, drained by the EndScene hook
+    core::GameEventStream m_gameEventStream;
+
+    // Recorded by the network and render threads
+    core::CommandLatencyRecorder m_commandLatency;
+    core::AgentMetrics m_metrics;
+
+    // Game-thread memory access (EndScene and FrameScript hooks)
+    core::ProcessMemoryRegionSource m_memoryRegionSource;
+    core::PageCachedMemoryReader m_memoryReader{m_memoryRegionSource};
+
     // Thread management
     std::atomic<bool> m_initialized{false};
 };
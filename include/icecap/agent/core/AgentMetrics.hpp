@@ -0,0 +1,77 @@
+#ifndef ICECAP_AGENT_CORE_AGENT_METRICS_HPP
+#define ICECAP_AGENT_CORE_AGENT_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace icecap::agent::core {
+
+/**
+ * Operational counters and gauges of one agent, rendered in the Prometheus
+ * text exposition format. Every update is a single relaxed atomic operation,
+ * so recording never blocks the network or render thread. Counters written
+ * by only one thread are grouped on their own cache line to keep the two
+ * threads from contending.
+ */
+class AgentMetrics {
+public:
+    static constexpr uint32_t kMaxCommandTypes = 64;
+
+    AgentMetrics() = default;
+
+    // Non-copyable, non-movable
+    AgentMetrics(const AgentMetrics&) = delete;
+    AgentMetrics& operator=(const AgentMetrics&) = delete;
+    AgentMetrics(AgentMetrics&&) = delete;
+    AgentMetrics& operator=(AgentMetrics&&) = delete;
+
+    // Network thread
+    void recordBytesIn(size_t bytes);
+    void recordBytesOut(size_t bytes);
+    void recordConnection();
+    void recordInboxPush(size_t bytes);
+    void recordOutboxPop(size_t bytes);
+
+    // Render thread
+    void recordInboxPop(size_t bytes);
+    void recordOutboxPush(size_t bytes);
+    void recordFrame(int64_t hookMicros);
+
+    // Any thread: one command handled, `failed` when it was answered with an error
+    void recordCommand(uint32_t commandType, bool failed);
+
+    // Snapshot of every metric in the Prometheus text format (version 0.0.4)
+    std::string render() const;
+
+private:
+    struct alignas(64) NetworkCounters {
+        std::atomic<uint64_t> bytesIn{0};
+        std::atomic<uint64_t> bytesOut{0};
+        std::atomic<uint64_t> connections{0};
+    };
+
+    struct alignas(64) RenderCounters {
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> hookMicros{0};
+    };
+
+    // Gauges are raised by one thread and lowered by the other
+    struct alignas(64) QueueGauges {
+        std::atomic<int64_t> inboxDepth{0};
+        std::atomic<int64_t> inboxBytes{0};
+        std::atomic<int64_t> outboxDepth{0};
+        std::atomic<int64_t> outboxBytes{0};
+    };
+
+    NetworkCounters m_network;
+    RenderCounters m_render;
+    QueueGauges m_queues;
+    std::array<std::atomic<uint64_t>, kMaxCommandTypes> m_commands{};
+    std::array<std::atomic<uint64_t>, kMaxCommandTypes> m_failures{};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_AGENT_METRICS_HPP
@@ -6,6 +6,9 @@
 #include "icecap/agent/v1/commands.pb.h"
 #include "icecap/agent/v1/events.pb.h"
 
+#include "../interfaces/IMemoryReader.hpp"
+#include "../interfaces/IScriptObserver.hpp"
+
 namespace icecap::agent::core {
 
 using IncomingMessage = icecap::agent::v1::Command;
@@ -17,7 +20,8 @@ using OutgoingMessage = icecap::agent::v1::Event;
  */
 class CommandExecutor {
 public:
-    CommandExecutor() = default;
+    // `observer` (optional) is told the name and duration of every Lua chunk this executor runs
+    explicit CommandExecutor(interfaces::IScriptObserver* observer = nullptr) : m_observer(observer) {}
     ~CommandExecutor() = default;
 
     // Non-copyable, non-movable
@@ -26,17 +30,49 @@ public:
     CommandExecutor(CommandExecutor&&) = delete;
     CommandExecutor& operator=(CommandExecutor&&) = delete;
 
-    // Lua execution
-    bool executeLuaCode(const std::string& code, const std::string& scriptName = "source");
+    // Reload the game function pointers from GameAddresses once they have been resolved
+    static void bindGameFunctions();
+
+    // Lua execution; chunks without a name are named after a hash of their code
+    bool executeLuaCode(const std::string& code, const std::string& scriptName = {});
 
     // Lua variable reading
     std::string readLuaVariable(const std::string& variableName);
 
+    // Lua expression evaluation, stores tostring(expression) in `result`; unnamed ones are named like code
+    bool evaluateLuaExpression(const std::string& expression, std::string& result,
+                               const std::string& scriptName = {});
+
+    // Lua condition evaluation, stores the truthiness of `condition` in `result`
+    bool evaluateLuaCondition(const std::string& condition, bool& result, const std::string& scriptName = {});
+
+    // Unit position reading through `memory` (contract axis order, as accepted by executeClickToMove)
+    bool readUnitPosition(const interfaces::IMemoryReader& memory, uintptr_t unitBaseAddress,
+                          icecap::agent::v1::Position& position);
+
     // ClickToMove execution
     bool executeClickToMove(uintptr_t playerBaseAddress, const icecap::agent::v1::Position& position,
                             icecap::agent::v1::ClickToMoveAction action, float precision);
 
 private:
+    // Scratch global used to carry expression results out of the Lua state
+    static constexpr const char* kEvalResultVariable = "__icecap_eval_result";
+
+    // Prefixes of the content-hash names given to unnamed code and expressions
+    static constexpr const char* kCodeScriptPrefix = "lua_";
+    static constexpr const char* kEvalScriptPrefix = "eval_";
+
+    // `prefix` followed by the FNV-1a hash of `content` in hex, so the same snippet always profiles under one name
+    static std::string hashScriptName(const char* prefix, const std::string& content);
+
+    // Run a chunk through FrameScript_Execute, reporting it to the observer
+    int runDostring(const std::string& code, const std::string& scriptName);
+
+    // CGUnit_C field offsets for build 12340
+    struct UnitOffsets {
+        static constexpr uintptr_t kPosition = 0x798; // float[3]
+    };
+
     // Game function pointers (cached for performance)
     struct GameFunctions {
         using p_Dostring = int(__cdecl*)(const char* script, const char* scriptname, int null);
@@ -48,6 +84,8 @@ private:
         static p_GetText GetText;
         static p_ClickToMove CGPlayer_C__ClickToMove;
     };
+
+    interfaces::IScriptObserver* m_observer;
 };
 
 } // namespace icecap::agent::core
@@ -0,0 +1,125 @@
+#ifndef ICECAP_AGENT_CORE_COMMAND_LATENCY_HPP
+#define ICECAP_AGENT_CORE_COMMAND_LATENCY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace icecap::agent::core {
+
+// Points in a command's life, in the order a command normally passes them
+enum class CommandStage : uint8_t {
+    RECEIVED,       // recv() returned the bytes completing the frame
+    FRAMED,         // frame extracted from the receive buffer
+    PARSED,         // protobuf decoded
+    ENQUEUED,       // pushed to the inbox
+    DEQUEUED,       // popped by the EndScene hook
+    EXECUTED,       // handler finished its work (first event created)
+    EVENT_ENQUEUED, // first event pushed to the outbox
+    SENT,           // first event written to the socket
+    COUNT
+};
+
+inline constexpr size_t kCommandStageCount = static_cast<size_t>(CommandStage::COUNT);
+
+// Monotonic timestamps of one command; stages that were skipped stay 0
+struct CommandTimeline {
+    uint32_t commandType{0};
+    std::array<int64_t, kCommandStageCount> micros{};
+
+    bool isActive() const {
+        return micros[0] != 0;
+    }
+
+    void stamp(CommandStage stage) {
+        micros[static_cast<size_t>(stage)] = nowMicros();
+    }
+
+    // Microseconds on the steady clock
+    static int64_t nowMicros();
+};
+
+/**
+ * Log-linear latency histogram in microseconds (8 sub-buckets per power of
+ * two, so reported percentiles are within 12.5%). Recording is a handful of
+ * relaxed atomic operations and never blocks; readers see a slightly torn but
+ * monotonic view while writers are active.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t kSubBucketBits = 3;
+    static constexpr uint32_t kSubBuckets = 1u << kSubBucketBits;
+
+    // Values are clamped to 2^32 - 1 microseconds (about 71 minutes)
+    static constexpr size_t kBucketCount = (32 - kSubBucketBits + 1) * kSubBuckets;
+
+    struct Summary {
+        uint64_t count{0};
+        uint64_t sumMicros{0};
+        uint64_t maxMicros{0};
+        uint64_t p50Micros{0};
+        uint64_t p90Micros{0};
+        uint64_t p99Micros{0};
+    };
+
+    void record(uint64_t micros);
+    void reset();
+    Summary summarize() const;
+
+    static size_t bucketOf(uint64_t micros);
+
+    // Largest value that falls into `bucket`
+    static uint64_t upperBoundOf(size_t bucket);
+
+private:
+    std::array<std::atomic<uint32_t>, kBucketCount> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+/**
+ * Per-command-type histograms of the time spent between consecutive stages,
+ * plus one of the whole lifecycle. A type's histograms are allocated the
+ * first time it is recorded and published with a compare-exchange, so any
+ * thread may record or read without locking.
+ */
+class CommandLatencyRecorder {
+public:
+    static constexpr uint32_t kMaxCommandTypes = 64;
+
+    // Histogram i measures the time from the previous reached stage to stage i + 1; the last is the total
+    static constexpr size_t kIntervalCount = kCommandStageCount;
+    static constexpr size_t kTotalInterval = kIntervalCount - 1;
+
+    using Histograms = std::array<LatencyHistogram, kIntervalCount>;
+
+    CommandLatencyRecorder() = default;
+    ~CommandLatencyRecorder();
+
+    // Non-copyable, non-movable
+    CommandLatencyRecorder(const CommandLatencyRecorder&) = delete;
+    CommandLatencyRecorder& operator=(const CommandLatencyRecorder&) = delete;
+    CommandLatencyRecorder(CommandLatencyRecorder&&) = delete;
+    CommandLatencyRecorder& operator=(CommandLatencyRecorder&&) = delete;
+
+    // Any thread: fold a finished timeline into its command type's histograms
+    void record(const CommandTimeline& timeline);
+
+    // Any thread: zero every histogram
+    void reset();
+
+    // Histograms of `commandType`, null if it was never recorded
+    const Histograms* find(uint32_t commandType) const;
+
+    // Name of the stage interval `interval` ends at ("total" for kTotalInterval)
+    static const char* intervalName(size_t interval);
+
+private:
+    std::array<std::atomic<Histograms*>, kMaxCommandTypes> m_types{};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_COMMAND_LATENCY_HPP
@@ -1,11 +1,27 @@
 #ifndef ICECAP_AGENT_CORE_EVENT_PUBLISHER_HPP
 #define ICECAP_AGENT_CORE_EVENT_PUBLISHER_HPP
 
+#include <deque>
 #include <string>
+#include <vector>
 
 #include "icecap/agent/v1/commands.pb.h"
 #include "icecap/agent/v1/events.pb.h"
 
+#include "../interfaces/IHookRegistry.hpp"
+#include "CommandLatency.hpp"
+#include "FrameStallWatchdog.hpp"
+#include "FrameTiming.hpp"
+#include "GameEventAggregator.hpp"
+#include "GameStatePublisher.hpp"
+#include "ObjectSnapshot.hpp"
+#include "PathFollower.hpp"
+#include "PositionHistory.hpp"
+#include "ScriptProfiler.hpp"
+#include "SpatialIndex.hpp"
+#include "StateMachineEngine.hpp"
+#include "WatchManager.hpp"
+
 namespace icecap::agent::core {
 
 using IncomingMessage = icecap::agent::v1::Command;
@@ -23,12 +39,90 @@ public:
     // Create event for successful Lua variable read
     static OutgoingMessage createLuaVariableReadEvent(const IncomingMessage& originalCommand,
                                                       const std::string& result);
+    static OutgoingMessage createLuaVariableReadEvent(const std::string& operationId, const std::string& result);
+
+    // Create a batched event for watch values that changed during one frame
+    static OutgoingMessage createWatchValuesChangedEvent(const std::vector<WatchChange>& changes);
+
+    // Create a path progress, completion or abort event
+    static OutgoingMessage createPathProgressEvent(const PathProgress& progress);
+
+    // Create a state machine transition event
+    static OutgoingMessage createStateMachineTransitionEvent(const StateTransition& transition);
+
+    // Create the answer to a state machine configure command: the engine's budget and evaluation cost
+    static OutgoingMessage createStateMachineStatsEvent(const IncomingMessage& originalCommand,
+                                                        const StateMachineEngine& engine);
+
+    // Create an object snapshot delta event (spawned rows carry every field, updated rows only changed ones)
+    static OutgoingMessage createObjectSnapshotDeltaEvent(uint64_t frameNumber, const ObjectTable& table,
+                                                          const ObjectDelta& delta);
+
+    // Create a spatial query result event listing the matching objects nearest first
+    static OutgoingMessage createSpatialQueryResultEvent(const IncomingMessage& originalCommand,
+                                                         const ObjectTable& table,
+                                                         const std::vector<SpatialIndex::Neighbor>& neighbors);
+
+    // Create a game state event with the selected object rows of a published state, current as of `frameNumber`
+    static OutgoingMessage createGameStateEvent(const IncomingMessage& originalCommand, const GameState& state,
+                                                const std::vector<size_t>& rows, uint64_t frameNumber,
+                                                int64_t ageMicros);
+
+    // Create a position history event; frames and timestamps are delta-encoded against the first sample
+    static OutgoingMessage createPositionHistoryEvent(const IncomingMessage& originalCommand, uint64_t guid,
+                                                      const std::vector<PositionSample>& samples);
+
+    // Create a bulk memory read result event
+    static OutgoingMessage createMemoryReadResultEvent(const IncomingMessage& originalCommand, std::string data,
+                                                       std::string failedBitmap);
+
+    // Create an object query result event carrying the projected fields of the matching rows
+    static OutgoingMessage createObjectQueryResultEvent(const IncomingMessage& originalCommand,
+                                                        const ObjectTable& table, const std::vector<size_t>& rows,
+                                                        uint32_t fields);
+
+    // Create a game event notification with typed arguments, standing for `aggregate.count` raw events
+    static OutgoingMessage createGameEvent(uint64_t frameNumber, const GameEventAggregate& aggregate);
+
+    // Create a latency report with the per-stage summaries of every command type recorded so far
+    static OutgoingMessage createLatencyReportEvent(const IncomingMessage& originalCommand,
+                                                    const CommandLatencyRecorder& recorder);
+
+    // Create a periodic frame timing notification, or the answer to a frame timing query
+    static OutgoingMessage createFrameTimingEvent(const FrameTimingSummary& summary);
+    static OutgoingMessage createFrameTimingEvent(const IncomingMessage& originalCommand,
+                                                  const FrameTimingSummary& summary);
+
+    // Create a slow frame notification, or the answer to a history query with every retained slow frame
+    static OutgoingMessage createSlowFrameEvent(const SlowFrame& slowFrame);
+    static OutgoingMessage createSlowFrameHistoryEvent(const IncomingMessage& originalCommand,
+                                                       const std::deque<SlowFrame>& history);
+
+    // Create the answer to a script profile query: `profiles` ranked by total time, out of `scriptCount` profiled
+    static OutgoingMessage createScriptProfileEvent(const IncomingMessage& originalCommand,
+                                                    const std::vector<ScriptProfile>& profiles, uint64_t scriptCount);
+
+    // Create the answer to a hook stats query: every hook's counters and the cycle counter frequency
+    static OutgoingMessage createHookStatsEvent(const IncomingMessage& originalCommand,
+                                                const std::vector<interfaces::HookStats>& hooks,
+                                                double cyclesPerSecond);
+
+    // Create a notification that a Chrome trace file was written
+    static OutgoingMessage createTraceDumpedEvent(const IncomingMessage& originalCommand, const std::string& path,
+                                                  uint64_t spanCount);
+
+    // Create the answer to a ping: the client's send time echoed back with the agent's receive and send times, all
+    // in microseconds (the agent's on its steady clock, like every other agent timestamp)
+    static OutgoingMessage createPongEvent(const IncomingMessage& originalCommand, int64_t receivedMicros,
+                                           int64_t sentMicros);
 
     // Create a generic error event
     static OutgoingMessage createErrorEvent(const IncomingMessage& originalCommand, const std::string& errorMessage);
+    static OutgoingMessage createErrorEvent(const std::string& operationId, const std::string& errorMessage);
 
     // Create a generic success event
     static OutgoingMessage createSuccessEvent(const IncomingMessage& originalCommand);
+    static OutgoingMessage createSuccessEvent(const std::string& operationId);
 
     // Generate unique event ID
     static std::string generateEventId();
@@ -36,6 +130,13 @@ public:
 private:
     // UUID generation helper
     static std::string generateUUID();
+
+    // Copy one slow frame record into its contract message
+    static void fillSlowFrame(icecap::agent::v1::SlowFrame* message, const SlowFrame& slowFrame);
+
+    // Copy the selected columns (ObjectField flags) of one table row into an ObjectState message
+    static void fillObjectState(icecap::agent::v1::ObjectState* state, const ObjectTable& table, size_t row,
+                                uint32_t fields);
 };
 
 } // namespace icecap::agent::core
@@ -0,0 +1,110 @@
+#ifndef ICECAP_AGENT_CORE_FRAME_STALL_WATCHDOG_HPP
+#define ICECAP_AGENT_CORE_FRAME_STALL_WATCHDOG_HPP
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "../interfaces/IScriptObserver.hpp"
+
+namespace icecap::agent::core {
+
+// A command processed during a slow frame
+struct SlowFrameCommand {
+    std::string id;
+    uint32_t type{0};
+    int64_t elapsedMicros{0};
+};
+
+// Lua chunks of one name run during a slow frame
+struct SlowFrameScript {
+    std::string name;
+    uint32_t count{0};
+    int64_t elapsedMicros{0};
+};
+
+// A frame in which the agent held the render thread longer than the threshold
+struct SlowFrame {
+    uint64_t frameNumber{0};
+    int64_t agentMicros{0};
+    uint32_t thresholdMicros{0};
+    std::vector<SlowFrameCommand> commands;
+    std::vector<SlowFrameScript> scripts;
+};
+
+/**
+ * Measures the agent's time inside the EndScene hook every frame and, when
+ * it exceeds the threshold, keeps a record of the commands and Lua scripts
+ * that ran in that frame. The newest kMaxHistory records are retained.
+ * Attribution is collected for every frame but only copied out for slow
+ * ones, so fast frames cost a few vector appends.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class FrameStallWatchdog : public interfaces::IScriptObserver {
+public:
+    static constexpr uint32_t kDefaultThresholdMicros = 4000;
+    static constexpr size_t kMaxHistory = 64;
+
+    // Script entries kept per frame: kMaxScriptsPerFrame - 1 names, then one kOtherScripts entry for the rest
+    static constexpr size_t kMaxScriptsPerFrame = 32;
+    static constexpr const char* kOtherScripts = "(other)";
+
+    FrameStallWatchdog() = default;
+    ~FrameStallWatchdog() override = default;
+
+    // Non-copyable, non-movable
+    FrameStallWatchdog(const FrameStallWatchdog&) = delete;
+    FrameStallWatchdog& operator=(const FrameStallWatchdog&) = delete;
+    FrameStallWatchdog(FrameStallWatchdog&&) = delete;
+    FrameStallWatchdog& operator=(FrameStallWatchdog&&) = delete;
+
+    // Frames whose agent time exceeds `micros` are recorded; 0 restores the default
+    void setThreshold(uint32_t micros);
+    uint32_t getThreshold() const {
+        return m_thresholdMicros;
+    }
+
+    // Whether slow frames are streamed to the controller as they happen
+    void setPublishing(bool publishing) {
+        m_publishing = publishing;
+    }
+    bool isPublishing() const {
+        return m_publishing;
+    }
+
+    // Start attributing work to `frameNumber`; `nowMicros` is when the hook was entered
+    void beginFrame(uint64_t frameNumber, int64_t nowMicros);
+
+    // A command finished processing in the current frame
+    void noteCommand(const std::string& id, uint32_t type, int64_t elapsedMicros);
+
+    // IScriptObserver: a Lua chunk ran in the current frame
+    void onScriptExecuted(const std::string& scriptName, int64_t elapsedMicros) override;
+
+    // Close the current frame; returns true and fills `slowFrame` (also added to the history) if it was slow
+    bool endFrame(int64_t nowMicros, SlowFrame& slowFrame);
+
+    const std::deque<SlowFrame>& getHistory() const {
+        return m_history;
+    }
+
+private:
+    uint32_t m_thresholdMicros{kDefaultThresholdMicros};
+    bool m_publishing{false};
+
+    // Attribution of the frame in progress
+    bool m_inFrame{false};
+    uint64_t m_frameNumber{0};
+    int64_t m_frameStartMicros{0};
+    std::vector<SlowFrameCommand> m_commands;
+    std::vector<SlowFrameScript> m_scripts;
+    size_t m_scriptCount{0}; // Live entries in m_scripts; the rest keep their storage for reuse
+
+    std::deque<SlowFrame> m_history;
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_FRAME_STALL_WATCHDOG_HPP
@@ -0,0 +1,71 @@
+#ifndef ICECAP_AGENT_CORE_FRAME_TIMING_HPP
+#define ICECAP_AGENT_CORE_FRAME_TIMING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace icecap::agent::core {
+
+// Frame interval statistics over the most recent window
+struct FrameTimingSummary {
+    uint64_t frameNumber{0};
+    uint32_t sampleCount{0};
+    uint32_t minMicros{0};
+    uint32_t meanMicros{0};
+    uint32_t p99Micros{0};
+    uint32_t maxMicros{0};
+};
+
+/**
+ * Client frame clock fed by the EndScene hook: the current frame number,
+ * readable from any thread so events can be stamped with the frame they were
+ * produced in, and the intervals between the last kWindowFrames hook entries.
+ * A summary sorts a copy of the window, so it is only computed when
+ * requested or published.
+ *
+ * Not thread-safe apart from getCurrentFrame(): all other calls must come
+ * from the EndScene hook.
+ */
+class FrameTimingStats {
+public:
+    static constexpr size_t kWindowFrames = 256;
+
+    FrameTimingStats() = default;
+
+    // Non-copyable, non-movable
+    FrameTimingStats(const FrameTimingStats&) = delete;
+    FrameTimingStats& operator=(const FrameTimingStats&) = delete;
+    FrameTimingStats(FrameTimingStats&&) = delete;
+    FrameTimingStats& operator=(FrameTimingStats&&) = delete;
+
+    // Record the start of `frameNumber`, entered at `nowMicros`
+    void onFrame(uint64_t frameNumber, int64_t nowMicros);
+
+    // Any thread: the frame the render thread is in or last finished
+    uint64_t getCurrentFrame() const {
+        return m_currentFrame.load(std::memory_order_relaxed);
+    }
+
+    FrameTimingSummary summarize() const;
+
+    // Periodic publishing every `intervalFrames` frames; 0 stops it
+    void setPublishInterval(uint32_t intervalFrames);
+
+    // True once per publish interval, when a periodic summary is due at `frameNumber`
+    bool isPublishDue(uint64_t frameNumber);
+
+private:
+    std::atomic<uint64_t> m_currentFrame{0};
+
+    int64_t m_lastFrameMicros{0};
+    std::array<uint32_t, kWindowFrames> m_intervals{};
+    size_t m_intervalCount{0}; // Total recorded; the window holds the last kWindowFrames
+
+    uint32_t m_publishIntervalFrames{0};
+    uint64_t m_nextPublishFrame{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_FRAME_TIMING_HPP
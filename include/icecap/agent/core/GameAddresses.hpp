@@ -0,0 +1,77 @@
+#ifndef ICECAP_AGENT_CORE_GAME_ADDRESSES_HPP
+#define ICECAP_AGENT_CORE_GAME_ADDRESSES_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace icecap::agent::core {
+
+// Game functions and globals the agent calls or hooks
+enum class GameAddress : uint32_t {
+    LUA_DOSTRING,
+    LUA_GETTEXT,
+    CLICK_TO_MOVE,
+    SIGNAL_EVENT,
+    GX_DEVICE, // Global holding the CGxDevice pointer
+    COUNT
+};
+
+/**
+ * Process-wide address table. Starts out with the build 12340 addresses and
+ * is overwritten by GameAddressResolver before hooks are installed; read-only
+ * afterwards.
+ */
+class GameAddresses {
+public:
+    static constexpr size_t kCount = static_cast<size_t>(GameAddress::COUNT);
+
+    static uintptr_t get(GameAddress id);
+    static void set(GameAddress id, uintptr_t address);
+};
+
+/**
+ * Resolves GameAddresses by scanning the executable sections of the game
+ * module for byte signatures. Each signature is first checked at its build
+ * 12340 address, so the full scan only runs on other builds. Results are
+ * cached as module-relative offsets in a file keyed by a hash of the module's
+ * PE headers and of the signature table, so warm starts skip scanning.
+ * Targets whose signature is missing or ambiguous keep their build 12340
+ * address.
+ */
+class GameAddressResolver {
+public:
+    // How the address is derived from the start of a match
+    enum class Resolve {
+        DIRECT,   // match + offset
+        ABSOLUTE, // 32-bit absolute operand at match + offset
+        RELATIVE, // rel32 operand at match + offset (call/jmp target)
+    };
+
+    struct Target {
+        GameAddress id;
+        const char* name;
+        const char* pattern;
+        int32_t offset;
+        Resolve resolve;
+        uintptr_t build12340;
+    };
+
+    using Offsets = std::array<uint32_t, GameAddresses::kCount>;
+
+    static const std::array<Target, GameAddresses::kCount>& targets();
+
+    // Resolve every target in the module loaded at `moduleBase`, using and refreshing the cache at `cachePath`
+    static void resolve(uintptr_t moduleBase, const std::string& cachePath);
+
+    // Cache key for a module: its PE headers combined with the signature table
+    static uint64_t moduleHash(const uint8_t* headers, size_t size);
+
+    // Cache file format; an offset of 0 records a target that kept its build 12340 address
+    static std::string serializeCache(uint64_t hash, const Offsets& offsets);
+    static bool parseCache(const std::string& text, uint64_t hash, Offsets& offsets);
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_GAME_ADDRESSES_HPP
@@ -0,0 +1,117 @@
+#ifndef ICECAP_AGENT_CORE_GAME_EVENT_AGGREGATOR_HPP
+#define ICECAP_AGENT_CORE_GAME_EVENT_AGGREGATOR_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GameEventStream.hpp"
+
+namespace icecap::agent::core {
+
+// One outgoing game event, standing for `count` raw events fired since `windowStartFrame`
+struct GameEventAggregate {
+    GameEvent event;
+    uint32_t count{1};
+    double sum{0.0};
+    uint64_t windowStartFrame{0};
+};
+
+/**
+ * Per-event-id coalescing of drained game events before they are serialized.
+ * Events without a policy pass straight through. Events with a policy are
+ * folded into a window that opens on the first event and is flushed after a
+ * number of frames or milliseconds (every frame when neither is set):
+ *  - LATEST keeps the most recent event per key argument
+ *  - SUM keeps a count and a sum of one numeric argument per key argument
+ *  - SAMPLE keeps one event out of every N
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class GameEventAggregator {
+public:
+    static constexpr size_t kMaxPolicies = 256;
+
+    // Distinct keys held by one window; a window that would exceed it is flushed early
+    static constexpr size_t kMaxGroupsPerWindow = 1024;
+
+    // Group of events whose key argument could not be read; they count, but never merge with a real key
+    static constexpr const char* kUnreadableKey = "\x01unreadable";
+
+    enum class Mode { LATEST, SUM, SAMPLE };
+
+    struct Policy {
+        Mode mode{Mode::LATEST};
+
+        // 1-based argument positions, 0 = none (one group per event id / count only)
+        uint32_t keyArgument{0};
+        uint32_t valueArgument{0};
+
+        uint32_t sampleEvery{1};
+
+        // At most one may be set; neither flushes at the end of every frame
+        uint32_t windowFrames{0};
+        uint32_t windowMs{0};
+    };
+
+    GameEventAggregator() = default;
+    ~GameEventAggregator() = default;
+
+    // Non-copyable, non-movable
+    GameEventAggregator(const GameEventAggregator&) = delete;
+    GameEventAggregator& operator=(const GameEventAggregator&) = delete;
+    GameEventAggregator(GameEventAggregator&&) = delete;
+    GameEventAggregator& operator=(GameEventAggregator&&) = delete;
+
+    // Install (or replace) the policy for `eventId`; a replaced window is discarded
+    bool setPolicy(uint32_t eventId, const Policy& policy);
+
+    // Remove the policy for `eventId`, returns false if there was none. Groups of its open window are not lost:
+    // the next process() emits them ahead of that frame's events.
+    bool removePolicy(uint32_t eventId);
+
+    void clear();
+
+    // Drop partially filled windows (and windows of removed policies) but keep every policy
+    void discardPending();
+
+    size_t getPolicyCount() const {
+        return m_windows.size();
+    }
+
+    // Fold `events` into their windows and append pass-through events, then every window due, to `output`
+    void process(uint64_t frameNumber, uint64_t nowMs, std::vector<GameEvent>& events,
+                 std::vector<GameEventAggregate>& output);
+
+private:
+    struct Window {
+        Policy policy;
+        bool open{false};
+        uint64_t startFrame{0};
+        uint64_t startMs{0};
+        uint64_t sampleCounter{0};
+
+        // Groups in first-seen order, indexed by the key argument's value
+        std::vector<GameEventAggregate> groups;
+        std::unordered_map<std::string, size_t> groupIndex;
+    };
+
+    static std::string keyOf(const GameEvent& event, uint32_t keyArgument);
+    static double valueOf(const GameEvent& event, uint32_t valueArgument);
+
+    void fold(Window& window, uint64_t frameNumber, uint64_t nowMs, GameEvent& event,
+              std::vector<GameEventAggregate>& output);
+    static void openWindow(Window& window, uint64_t frameNumber, uint64_t nowMs);
+    static bool isDue(const Window& window, uint64_t frameNumber, uint64_t nowMs);
+    static void flush(Window& window, std::vector<GameEventAggregate>& output);
+
+    std::unordered_map<uint32_t, Window> m_windows;
+
+    // Flushed windows of removed policies, emitted by the next process()
+    std::vector<GameEventAggregate> m_removed;
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_GAME_EVENT_AGGREGATOR_HPP
@@ -0,0 +1,84 @@
+#ifndef ICECAP_AGENT_CORE_GAME_EVENT_STREAM_HPP
+#define ICECAP_AGENT_CORE_GAME_EVENT_STREAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace icecap::agent::core {
+
+// One decoded FrameScript argument, typed by its format character
+struct GameEventArgument {
+    // UNREADABLE marks an argument whose stack slot or string could not be read; its value fields are unset
+    enum class Kind : uint8_t { INTEGER, BOOLEAN, NUMBER, STRING, UNREADABLE };
+
+    Kind kind{Kind::INTEGER};
+    int64_t integer{0};
+    double number{0.0};
+    std::string text;
+};
+
+struct GameEvent {
+    uint32_t eventId{0};
+    std::vector<GameEventArgument> arguments;
+};
+
+/**
+ * Subscription-gated buffer between the FrameScript__SignalEvent hook and the
+ * EndScene hook. The subscription set is a bitset indexed by event id, so an
+ * unsubscribed event costs one relaxed load and a bit test before the hook
+ * forwards it untouched.
+ */
+class GameEventStream {
+public:
+    static constexpr uint32_t kMaxEventId = 1024;
+    static constexpr size_t kMaxPendingEvents = 4096;
+
+    GameEventStream() = default;
+    ~GameEventStream() = default;
+
+    // Non-copyable, non-movable
+    GameEventStream(const GameEventStream&) = delete;
+    GameEventStream& operator=(const GameEventStream&) = delete;
+    GameEventStream(GameEventStream&&) = delete;
+    GameEventStream& operator=(GameEventStream&&) = delete;
+
+    // Subscription management, returns false for ids outside the bitset
+    bool subscribe(uint32_t eventId);
+    bool unsubscribe(uint32_t eventId);
+    void unsubscribeAll();
+
+    bool isSubscribed(uint32_t eventId) const {
+        return eventId < kMaxEventId &&
+               (m_subscriptions[eventId / 64].load(std::memory_order_relaxed) & (1ull << (eventId % 64))) != 0;
+    }
+
+    bool hasSubscriptions() const {
+        return m_subscriptionCount.load(std::memory_order_relaxed) != 0;
+    }
+
+    // Hook side: queue a decoded event, dropping it if the buffer is full
+    void push(GameEvent event);
+
+    // EndScene side: move every pending event into `events`
+    void drain(std::vector<GameEvent>& events);
+
+    uint64_t getDroppedCount() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kMaxEventId / 64> m_subscriptions{};
+    std::atomic<uint32_t> m_subscriptionCount{0};
+
+    std::mutex m_pendingMutex;
+    std::vector<GameEvent> m_pending;
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_GAME_EVENT_STREAM_HPP
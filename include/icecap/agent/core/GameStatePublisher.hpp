@@ -0,0 +1,71 @@
+#ifndef ICECAP_AGENT_CORE_GAME_STATE_PUBLISHER_HPP
+#define ICECAP_AGENT_CORE_GAME_STATE_PUBLISHER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "ObjectSnapshot.hpp"
+
+namespace icecap::agent::core {
+
+// Immutable view of the game as observed at the end of the frame it was captured in
+struct GameState {
+    uint64_t frameNumber{0};
+    int64_t publishedAtMicros{0};
+
+    // Object snapshot table, including the local player GUID
+    std::shared_ptr<const ObjectTable> objects;
+    uint64_t objectsVersion{0};
+};
+
+// The frame up to which the latest GameState is known to still hold
+struct GameStateFreshness {
+    uint64_t frameNumber{0};
+    int64_t confirmedAtMicros{0};
+};
+
+/**
+ * Read-copy-update publication of GameState.
+ * The render thread publishes a new immutable state only when the object
+ * snapshot changed; when a capture finds nothing new it merely confirms
+ * that the current state still holds. Any thread may acquire the latest
+ * state without locking or waiting for a frame. Readers keep their state
+ * alive for as long as they hold the pointer.
+ */
+class GameStatePublisher {
+public:
+    GameStatePublisher() = default;
+    ~GameStatePublisher() = default;
+
+    // Non-copyable, non-movable
+    GameStatePublisher(const GameStatePublisher&) = delete;
+    GameStatePublisher& operator=(const GameStatePublisher&) = delete;
+    GameStatePublisher(GameStatePublisher&&) = delete;
+    GameStatePublisher& operator=(GameStatePublisher&&) = delete;
+
+    // Render thread only: publish the state for `frameNumber` if the snapshot changed, otherwise confirm it
+    void publish(uint64_t frameNumber, const ObjectSnapshotEngine& objects);
+
+    // Any thread: latest published state, null before the first frame
+    std::shared_ptr<const GameState> acquire() const;
+
+    // Any thread: the latest confirmation. Read it before acquire(); a state published in
+    // between is newer than the confirmation, never older.
+    GameStateFreshness getFreshness() const;
+
+    // Microseconds on the clock used for GameState::publishedAtMicros
+    static int64_t nowMicros();
+
+private:
+    std::atomic<std::shared_ptr<const GameState>> m_current;
+    std::atomic<uint64_t> m_confirmedFrame{0};
+    std::atomic<int64_t> m_confirmedAtMicros{0};
+
+    // Render thread only: snapshot version of the published state
+    uint64_t m_lastObjectsVersion{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_GAME_STATE_PUBLISHER_HPP
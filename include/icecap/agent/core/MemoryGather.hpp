@@ -0,0 +1,80 @@
+#ifndef ICECAP_AGENT_CORE_MEMORY_GATHER_HPP
+#define ICECAP_AGENT_CORE_MEMORY_GATHER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../interfaces/IMemoryReader.hpp"
+
+namespace icecap::agent::core {
+
+// One region to read. With a pointer chain, each offset is applied after dereferencing
+// the current address as a 32-bit pointer: [[address] + offsets[0]] + offsets[1] ...
+// The address keeps the contract's 64-bit width until validate() has checked it fits this process.
+struct GatherRequest {
+    uint64_t address{0};
+    std::vector<int32_t> offsets;
+    uint32_t length{0};
+};
+
+/**
+ * Scatter/gather reader that resolves many regions in one pass.
+ * Resolved regions are sorted and nearby ones merged, so a table of small
+ * fields costs a handful of reads instead of one per field. A merged read that
+ * fails falls back to reading its regions individually.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class MemoryGather {
+public:
+    static constexpr size_t kMaxRequests = 1024;
+    static constexpr size_t kMaxChainDepth = 8;
+    static constexpr uint32_t kMaxRequestLength = 64 * 1024;
+    static constexpr size_t kMaxTotalLength = 1024 * 1024;
+
+    // Regions closer than this are read together; merged reads never exceed kMaxMergedLength
+    static constexpr uintptr_t kMergeGap = 256;
+    static constexpr uintptr_t kMaxMergedLength = 64 * 1024;
+
+    MemoryGather() = default;
+    ~MemoryGather() = default;
+
+    // Non-copyable, non-movable
+    MemoryGather(const MemoryGather&) = delete;
+    MemoryGather& operator=(const MemoryGather&) = delete;
+    MemoryGather(MemoryGather&&) = delete;
+    MemoryGather& operator=(MemoryGather&&) = delete;
+
+    // Check request limits and that every address fits in uintptr_t, returns an empty string when valid
+    static std::string validate(const std::vector<GatherRequest>& requests);
+
+    // Read every request into `data` back to back (each exactly `length` bytes, zero-filled on failure).
+    // Bit i of `failedBitmap` (LSB first) is set when request i could not be read.
+    void gather(const interfaces::IMemoryReader& memory, const std::vector<GatherRequest>& requests,
+                std::string& data, std::string& failedBitmap);
+
+    // Number of reads issued by the last gather
+    size_t getLastReadCount() const {
+        return m_lastReadCount;
+    }
+
+private:
+    struct Region {
+        uintptr_t address;
+        uint32_t length;
+        size_t outputOffset;
+        size_t requestIndex;
+    };
+
+    bool resolve(const interfaces::IMemoryReader& memory, const GatherRequest& request, uintptr_t& address);
+    bool readRange(const interfaces::IMemoryReader& memory, uintptr_t address, void* out, size_t size);
+
+    std::vector<Region> m_regions;
+    std::vector<char> m_buffer;
+    size_t m_lastReadCount{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_MEMORY_GATHER_HPP
@@ -1,13 +1,18 @@
 #ifndef ICECAP_AGENT_CORE_MESSAGE_PROCESSOR_HPP
 #define ICECAP_AGENT_CORE_MESSAGE_PROCESSOR_HPP
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "icecap/agent/v1/commands.pb.h"
 #include "icecap/agent/v1/events.pb.h"
 
 #include "../interfaces/IApplicationContext.hpp"
 #include "../interfaces/IMessageHandler.hpp"
+#include "GameStatePublisher.hpp"
+#include "PathFollower.hpp"
+#include "TaskScheduler.hpp"
 
 namespace icecap::agent::core {
 
@@ -15,6 +20,8 @@ namespace icecap::agent::core {
 using IncomingMessage = icecap::agent::v1::Command;
 using OutgoingMessage = icecap::agent::v1::Event;
 
+class CommandExecutor;
+
 /**
  * Central message processor that routes incoming commands to appropriate handlers.
  * Acts as the main orchestrator for command processing logic.
@@ -35,16 +42,97 @@ public:
     bool hasOutgoingEvents() const override;
     OutgoingMessage getNextOutgoingEvent() override;
 
+    // Process an inbox entry, completing its latency timeline at the first event the command produces
+    void processCommand(interfaces::QueuedCommand& entry);
+
+    // Run per-frame work (watches, paths, tasks, state machines) from the EndScene hook
+    void processFrame(uint64_t frameNumber);
+
+    // Answer a command that does not touch game state (game state, latency and hook stats queries, trace control,
+    // ping) without the render thread; safe to call from any thread. `timeline` is the command's, if it has one,
+    // for the ping's receive time. Returns false when the command needs the render thread.
+    static bool answerReadOnlyQuery(interfaces::IApplicationContext& context, const IncomingMessage& command,
+                                    const CommandTimeline& timeline, OutgoingMessage& response);
+
 private:
     // Command handlers
     void handleLuaExecuteCommand(const IncomingMessage& command);
     void handleLuaReadVariableCommand(const IncomingMessage& command);
     void handleClickToMoveCommand(const IncomingMessage& command);
+    void handleWatchSubscribeCommand(const IncomingMessage& command);
+    void handleWatchUnsubscribeCommand(const IncomingMessage& command);
+    void handlePathFollowCommand(const IncomingMessage& command);
+    void handlePathStopCommand(const IncomingMessage& command);
+    void handleLuaSequenceCommand(const IncomingMessage& command);
+    void handleTaskCancelCommand(const IncomingMessage& command);
+    void handleRecurringTaskRegisterCommand(const IncomingMessage& command);
+    void handleRecurringTaskUnregisterCommand(const IncomingMessage& command);
+    void handleStateMachineLoadCommand(const IncomingMessage& command);
+    void handleStateMachineUnloadCommand(const IncomingMessage& command);
+    void handleStateMachineConfigureCommand(const IncomingMessage& command);
+    void handleObjectSnapshotSubscribeCommand(const IncomingMessage& command);
+    void handleObjectSnapshotUnsubscribeCommand(const IncomingMessage& command);
+    void handleSpatialQueryCommand(const IncomingMessage& command);
+    void handleGameStateQueryCommand(const IncomingMessage& command);
+    void handlePositionHistoryTrackCommand(const IncomingMessage& command);
+    void handlePositionHistoryUntrackCommand(const IncomingMessage& command);
+    void handlePositionHistoryQueryCommand(const IncomingMessage& command);
+    void handleMemoryReadCommand(const IncomingMessage& command);
+    void handleObjectQueryCommand(const IncomingMessage& command);
+    void handleGameEventSubscribeCommand(const IncomingMessage& command);
+    void handleGameEventUnsubscribeCommand(const IncomingMessage& command);
+    void handleGameEventAggregateCommand(const IncomingMessage& command);
+    void handleLatencyQueryCommand(const IncomingMessage& command);
+    void handleTraceControlCommand(const IncomingMessage& command);
+    void handleSlowFrameConfigureCommand(const IncomingMessage& command);
+    void handleSlowFrameHistoryQueryCommand(const IncomingMessage& command);
+    void handleFrameTimingQueryCommand(const IncomingMessage& command);
+    void handleFrameTimingSubscribeCommand(const IncomingMessage& command);
+    void handlePingCommand(const IncomingMessage& command);
+    void handleScriptProfileQueryCommand(const IncomingMessage& command);
+    void handleHookStatsQueryCommand(const IncomingMessage& command);
+
+    // Read-only query bodies
+    static OutgoingMessage answerGameStateQuery(const GameStatePublisher& publisher, const IncomingMessage& command);
+    static OutgoingMessage answerTraceControl(const IncomingMessage& command);
+
+    // Answer read-only queries that reached the inbox, with the timeline of the command being processed
+    void answerReadOnlyQueryOnFrame(const IncomingMessage& command);
+
+    // Multi-frame command bodies, resumed by TaskScheduler
+    static Task runLuaSequence(interfaces::IApplicationContext* context, IncomingMessage command);
+
+    // Per-frame work
+    void updateWatches(uint64_t frameNumber, CommandExecutor& executor);
+    void updatePath(uint64_t frameNumber, CommandExecutor& executor);
+    void updateTasks(uint64_t frameNumber);
+    void updateRecurringTasks(uint64_t frameNumber, CommandExecutor& executor);
+    void updateStateMachines(uint64_t frameNumber, CommandExecutor& executor);
+    void updateObjectSnapshot(uint64_t frameNumber);
+    void updatePositionHistory(uint64_t frameNumber);
+    void updateGameEvents(uint64_t frameNumber);
+    void updateFrameTiming(uint64_t frameNumber);
+    void updateStallWatchdog();
+
+    // Object table captured by processFrame on the previous frame; never walks the object manager itself
+    const ObjectTable& acquireObjectTable();
+
+    // Helper to publish path progress notifications
+    void enqueuePathProgress(const std::vector<PathProgress>& progress);
 
     // Helper to add event to outbox
     void enqueueEvent(const OutgoingMessage& event);
+    static void enqueueEvent(interfaces::IApplicationContext* context, const OutgoingMessage& event,
+                             CommandTimeline* timeline = nullptr);
 
     interfaces::IApplicationContext* m_context;
+
+    // Timeline of the command being processed, until its first event is enqueued
+    CommandTimeline* m_timeline{nullptr};
+
+    // Set while a command handler runs, so its error responses count as failures
+    bool m_handlingCommand{false};
+    bool m_commandFailed{false};
 };
 
 } // namespace icecap::agent::core
@@ -0,0 +1,86 @@
+#ifndef ICECAP_AGENT_CORE_OBJECT_QUERY_HPP
+#define ICECAP_AGENT_CORE_OBJECT_QUERY_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ObjectSnapshot.hpp"
+
+namespace icecap::agent::core {
+
+/**
+ * Compiled filter/projection over an ObjectTable, e.g.
+ *
+ *     type == UNIT && hp_pct < 35 && dist < 40 -> guid, hp, pos
+ *
+ * The filter compiles to a postfix program. Each comparison runs as one
+ * tight loop over a column, producing a selection mask; boolean operators
+ * combine masks. Derived columns (hp_pct, dist) are computed once per
+ * evaluation and only when referenced. `dist` is measured from the local
+ * player; `hp_pct` is undefined for objects without health and matches no
+ * comparison. `guid` and `target` take exact 64-bit integer literals
+ * (decimal or 0x hex). An empty filter matches every row and an omitted
+ * projection selects every field.
+ */
+class ObjectQuery {
+public:
+    static constexpr size_t kMaxQueryLength = 1024;
+    static constexpr size_t kMaxInstructions = 64;
+
+    // Compile `text`; on failure returns nullopt and describes the problem in `error`
+    static std::optional<ObjectQuery> compile(std::string_view text, std::string& error);
+
+    // Rows matching the filter, in table order
+    void select(const ObjectTable& table, std::vector<size_t>& rows) const;
+
+    // ObjectField flags named by the projection
+    uint32_t getProjection() const {
+        return m_projection;
+    }
+
+private:
+    enum class Column : uint8_t {
+        GUID,
+        TYPE,
+        BASE_ADDRESS,
+        X,
+        Y,
+        Z,
+        FACING,
+        HEALTH,
+        MAX_HEALTH,
+        HEALTH_PCT,
+        LEVEL,
+        TARGET,
+        DISTANCE,
+    };
+
+    enum class Op : uint8_t { EQ, NE, LT, LE, GT, GE };
+
+    struct Instruction {
+        enum class Kind : uint8_t { COMPARE, AND, OR, NOT };
+
+        Kind kind{Kind::COMPARE};
+        Column column{Column::GUID};
+        Op op{Op::EQ};
+        double number{0.0};
+        uint64_t integer{0};
+    };
+
+    class Parser;
+
+    ObjectQuery() = default;
+
+    std::vector<Instruction> m_program;
+    size_t m_stackDepth{0}; // Masks alive at once while evaluating m_program
+    uint32_t m_projection{~0u};
+    bool m_usesHealthPct{false};
+    bool m_usesDistance{false};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_OBJECT_QUERY_HPP
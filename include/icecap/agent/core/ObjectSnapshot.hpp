@@ -0,0 +1,209 @@
+#ifndef ICECAP_AGENT_CORE_OBJECT_SNAPSHOT_HPP
+#define ICECAP_AGENT_CORE_OBJECT_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "../interfaces/IMemoryReader.hpp"
+
+namespace icecap::agent::core {
+
+// Client object types (CGObject_C::m_objectType)
+enum class ObjectType : uint8_t {
+    NONE = 0,
+    ITEM = 1,
+    CONTAINER = 2,
+    UNIT = 3,
+    PLAYER = 4,
+    GAMEOBJECT = 5,
+    DYNAMICOBJECT = 6,
+    CORPSE = 7,
+};
+
+// Bit flags naming the columns that changed between two snapshots
+enum ObjectField : uint32_t {
+    OBJECT_FIELD_BASE_ADDRESS = 1u << 0,
+    OBJECT_FIELD_POSITION = 1u << 1,
+    OBJECT_FIELD_FACING = 1u << 2,
+    OBJECT_FIELD_HEALTH = 1u << 3,
+    OBJECT_FIELD_MAX_HEALTH = 1u << 4,
+    OBJECT_FIELD_LEVEL = 1u << 5,
+    OBJECT_FIELD_TARGET = 1u << 6,
+};
+
+/**
+ * Structure-of-arrays view of the client's objects, one row per object,
+ * rows sorted by GUID. Positions use the contract axis order (see
+ * CommandExecutor::readUnitPosition).
+ */
+struct ObjectTable {
+    std::vector<uint64_t> guid;
+    std::vector<ObjectType> type;
+    std::vector<uint32_t> baseAddress;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> facing;
+    std::vector<uint32_t> health;
+    std::vector<uint32_t> maxHealth;
+    std::vector<uint32_t> level;
+    std::vector<uint64_t> targetGuid;
+
+    uint64_t localPlayerGuid{0};
+
+    size_t size() const {
+        return guid.size();
+    }
+
+    void clear();
+    void reserve(size_t capacity);
+    void resize(size_t count);
+
+    // Row holding `objectGuid` (binary search over the sorted GUID column)
+    std::optional<size_t> find(uint64_t objectGuid) const;
+};
+
+// Per-frame difference between two snapshots
+struct ObjectDelta {
+    struct Update {
+        size_t row;
+        uint32_t changedFields;
+    };
+
+    std::vector<size_t> spawned;
+    std::vector<uint64_t> despawned;
+    std::vector<Update> updated;
+
+    bool empty() const {
+        return spawned.empty() && despawned.empty() && updated.empty();
+    }
+
+    void clear() {
+        spawned.clear();
+        despawned.clear();
+        updated.clear();
+    }
+};
+
+/**
+ * Walks the client's object manager into an ObjectTable and diffs it
+ * against the previous walk. Memory is only accessed through IMemoryReader,
+ * so the walker can run against a synthetic memory image.
+ *
+ * The table is captured exactly on every frame so it can be published to
+ * other threads and queried. The delta subscription's interval, type mask and
+ * position epsilon only shape the deltas: each one is diffed against the
+ * rows last reported to the controller, not against the previous capture.
+ * A type mask beyond the default adds those types to the table; it never
+ * removes rows from it.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class ObjectSnapshotEngine {
+public:
+    static constexpr size_t kMaxObjects = 4096;
+
+    // Objects of these types are captured when no explicit type mask is configured
+    static constexpr uint32_t kDefaultTypeMask = (1u << static_cast<uint32_t>(ObjectType::UNIT)) |
+                                                 (1u << static_cast<uint32_t>(ObjectType::PLAYER)) |
+                                                 (1u << static_cast<uint32_t>(ObjectType::GAMEOBJECT));
+
+    // Object manager layout for build 12340
+    struct Offsets {
+        static constexpr uintptr_t kClientConnection = 0x00C79CE0;
+        static constexpr uintptr_t kObjectManager = 0x2ED0;
+        static constexpr uintptr_t kFirstObject = 0xAC;
+        static constexpr uintptr_t kLocalGuid = 0xC0;
+
+        static constexpr uintptr_t kObjectDescriptors = 0x08;
+        static constexpr uintptr_t kObjectType = 0x14;
+        static constexpr uintptr_t kObjectGuid = 0x30;
+        static constexpr uintptr_t kNextObject = 0x3C;
+
+        static constexpr uintptr_t kUnitPosition = 0x798; // float[3]
+        static constexpr uintptr_t kUnitFacing = 0x7A8;
+        static constexpr uintptr_t kGameObjectPosition = 0xE8;
+
+        // Unit descriptor fields (UNIT_FIELD_* * 4)
+        static constexpr uintptr_t kUnitTarget = 0x48;
+        static constexpr uintptr_t kUnitHealth = 0x60;
+        static constexpr uintptr_t kUnitMaxHealth = 0x80;
+        static constexpr uintptr_t kUnitLevel = 0xD8;
+    };
+
+    ObjectSnapshotEngine() = default;
+    ~ObjectSnapshotEngine() = default;
+
+    // Non-copyable, non-movable
+    ObjectSnapshotEngine(const ObjectSnapshotEngine&) = delete;
+    ObjectSnapshotEngine& operator=(const ObjectSnapshotEngine&) = delete;
+    ObjectSnapshotEngine(ObjectSnapshotEngine&&) = delete;
+    ObjectSnapshotEngine& operator=(ObjectSnapshotEngine&&) = delete;
+
+    // Delta streaming configuration; enabling resets the baseline so the next delta spawns everything.
+    // A position is reported once it moves more than `positionEpsilon` away from its last reported value.
+    // Disabling stops producing deltas; the table keeps being captured every frame.
+    void enable(uint32_t intervalFrames, uint32_t typeMask, float positionEpsilon);
+    void disable();
+
+    bool isEnabled() const {
+        return m_enabled;
+    }
+
+    // Walk the object manager; returns true when a delta was due on this frame and produced into `delta`
+    bool update(uint64_t frameNumber, const interfaces::IMemoryReader& memory, ObjectDelta& delta);
+
+    // Walk and diff against the last reported rows, regardless of the interval
+    void capture(const interfaces::IMemoryReader& memory, ObjectDelta& delta);
+
+    // Most recent snapshot
+    const ObjectTable& getTable() const {
+        return m_current;
+    }
+
+    // Object manager lookups for callers that need one object without a full snapshot.
+    // Both return 0 outside the world or when the object is not present.
+    static uint64_t readLocalPlayerGuid(const interfaces::IMemoryReader& memory);
+    static uint32_t findObjectAddress(const interfaces::IMemoryReader& memory, uint64_t objectGuid);
+
+    // Incremented whenever a capture changes the table, lets derived indexes and copies skip redundant rebuilds
+    uint64_t getVersion() const {
+        return m_version;
+    }
+
+    // Frame of the last walk made by update(); the table is known to be current as of this frame
+    uint64_t getCaptureFrame() const {
+        return m_captureFrame;
+    }
+
+private:
+    static uint32_t readObjectManager(const interfaces::IMemoryReader& memory);
+
+    void walk(const interfaces::IMemoryReader& memory);
+    void refresh(const interfaces::IMemoryReader& memory);
+    void readObject(const interfaces::IMemoryReader& memory, uint32_t object, ObjectType type, uint64_t objectGuid);
+    void sortScratch();
+    void diff(ObjectDelta& delta);
+
+    ObjectTable m_current;
+    ObjectTable m_previous;
+    ObjectTable m_scratch;
+
+    // Rows of the subscribed types as last sent in a delta, positions as reported
+    ObjectTable m_reported;
+    ObjectTable m_nextReported;
+    std::vector<uint32_t> m_order;
+
+    bool m_enabled{false};
+    uint32_t m_intervalFrames{1};
+    uint32_t m_typeMask{kDefaultTypeMask};
+    float m_positionEpsilon{0.0f};
+    uint64_t m_nextDueFrame{0};
+    uint64_t m_version{0};
+    uint64_t m_captureFrame{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_OBJECT_SNAPSHOT_HPP
@@ -0,0 +1,77 @@
+#ifndef ICECAP_AGENT_CORE_PAGE_CACHED_MEMORY_READER_HPP
+#define ICECAP_AGENT_CORE_PAGE_CACHED_MEMORY_READER_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "../interfaces/IMemoryReader.hpp"
+#include "../interfaces/IMemoryRegionSource.hpp"
+
+namespace icecap::agent::core {
+
+/**
+ * IMemoryReader that remembers which address ranges are readable.
+ * The first read in a region asks the source for its bounds; later reads in
+ * the same region copy directly without a system call. Strings are copied in
+ * chunks and scanned for the terminator 16 bytes at a time.
+ *
+ * The cache is invalidated conservatively: explicitly once per frame, and
+ * whenever a copy from a cached range fails.
+ *
+ * Not thread-safe: use from the game's main thread only (EndScene and the game hooks).
+ */
+class PageCachedMemoryReader : public interfaces::IMemoryReader {
+public:
+    static constexpr size_t kCachedRanges = 32;
+    static constexpr size_t kStringChunk = 256;
+
+    explicit PageCachedMemoryReader(const interfaces::IMemoryRegionSource& source);
+    ~PageCachedMemoryReader() override = default;
+
+    // Non-copyable, non-movable
+    PageCachedMemoryReader(const PageCachedMemoryReader&) = delete;
+    PageCachedMemoryReader& operator=(const PageCachedMemoryReader&) = delete;
+    PageCachedMemoryReader(PageCachedMemoryReader&&) = delete;
+    PageCachedMemoryReader& operator=(PageCachedMemoryReader&&) = delete;
+
+    // IMemoryReader implementation
+    bool read(uintptr_t address, void* out, size_t size) const override;
+    bool readString(uintptr_t address, std::string& out, size_t maxLength) const override;
+
+    // Forget every cached range
+    void invalidate() const;
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t invalidations{0};
+    };
+
+    const Stats& getStats() const {
+        return m_stats;
+    }
+
+private:
+    struct Range {
+        uintptr_t begin{0};
+        uintptr_t end{0};
+    };
+
+    // End of the readable range containing `address`, or 0 if it is not readable
+    uintptr_t readableEnd(uintptr_t address) const;
+
+    bool copy(uintptr_t address, void* out, size_t size) const;
+
+    const interfaces::IMemoryRegionSource& m_source;
+
+    // Lookups and misses refill the cache, so it is mutable behind the const IMemoryReader interface
+    mutable std::array<Range, kCachedRanges> m_ranges{};
+    mutable size_t m_rangeCount{0};
+    mutable size_t m_nextVictim{0};
+    mutable size_t m_lastHit{0};
+    mutable Stats m_stats;
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_PAGE_CACHED_MEMORY_READER_HPP
@@ -0,0 +1,87 @@
+#ifndef ICECAP_AGENT_CORE_PATH_FOLLOWER_HPP
+#define ICECAP_AGENT_CORE_PATH_FOLLOWER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "icecap/agent/v1/commands.pb.h"
+
+#include "../interfaces/IMemoryReader.hpp"
+
+namespace icecap::agent::core {
+
+class CommandExecutor;
+
+// Progress notification produced while following a path
+struct PathProgress {
+    enum class Kind { WAYPOINT_REACHED, COMPLETED, ABORTED };
+
+    Kind kind{Kind::WAYPOINT_REACHED};
+    std::string operationId;
+    uint32_t waypointIndex{0};
+    uint32_t waypointCount{0};
+    icecap::agent::v1::Position position;
+    std::string reason;
+};
+
+/**
+ * Agent-side waypoint follower built on ClickToMove.
+ * Advances to the next waypoint as soon as the player enters the arrival radius
+ * of the current one, so movement does not stall on network round trips.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class PathFollower {
+public:
+    static constexpr size_t kMaxWaypoints = 1024;
+
+    // Re-issue ClickToMove periodically in case the game dropped the previous order
+    static constexpr uint64_t kReissueIntervalFrames = 30;
+
+    struct Path {
+        std::string operationId;
+        uintptr_t playerBaseAddress{0};
+        std::vector<icecap::agent::v1::Position> waypoints;
+        float arrivalRadius{0.0f};
+        float precision{0.0f};
+        icecap::agent::v1::ClickToMoveAction action{};
+    };
+
+    PathFollower() = default;
+    ~PathFollower() = default;
+
+    // Non-copyable, non-movable
+    PathFollower(const PathFollower&) = delete;
+    PathFollower& operator=(const PathFollower&) = delete;
+    PathFollower(PathFollower&&) = delete;
+    PathFollower& operator=(PathFollower&&) = delete;
+
+    // Start following a new path, aborting the current one (reported through `progress`)
+    bool start(Path path, std::vector<PathProgress>& progress);
+
+    // Abort the current path, returns false if no path was active
+    bool stop(const std::string& reason, std::vector<PathProgress>& progress);
+
+    bool isActive() const {
+        return m_active;
+    }
+
+    // Advance along the active path for this frame, reading the player's position through `memory`
+    void update(uint64_t frameNumber, CommandExecutor& executor, const interfaces::IMemoryReader& memory,
+                std::vector<PathProgress>& progress);
+
+private:
+    PathProgress makeProgress(PathProgress::Kind kind, const icecap::agent::v1::Position& position) const;
+
+    Path m_path;
+    size_t m_currentIndex{0};
+    icecap::agent::v1::Position m_lastPlayerPosition;
+    uint64_t m_lastIssuedFrame{0};
+    bool m_issued{false};
+    bool m_active{false};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_PATH_FOLLOWER_HPP
@@ -0,0 +1,94 @@
+#ifndef ICECAP_AGENT_CORE_POSITION_HISTORY_HPP
+#define ICECAP_AGENT_CORE_POSITION_HISTORY_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "../interfaces/IMemoryReader.hpp"
+
+namespace icecap::agent::core {
+
+// One recorded position, in contract axis order
+struct PositionSample {
+    uint64_t frameNumber{0};
+    int64_t timestampMicros{0};
+    float x{0.0f};
+    float y{0.0f};
+    float z{0.0f};
+};
+
+/**
+ * Per-frame position recorder for the local player and tracked units.
+ * The local player is tracked from construction, so its recent path is
+ * available after the fact without a prior POSITION_HISTORY_TRACK; other
+ * units are recorded once tracked. Each track owns a fixed-size ring buffer sized when tracking starts, so the
+ * record path never allocates. Object addresses are cached and re-validated
+ * against the GUID every frame.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class PositionHistory {
+public:
+    static constexpr size_t kMaxTracks = 16;
+    static constexpr uint32_t kDefaultCapacity = 600;
+    static constexpr uint32_t kMaxCapacity = 1u << 16;
+
+    // GUID alias that follows whichever character is logged in
+    static constexpr uint64_t kLocalPlayer = 0;
+
+    // Frames to wait before walking the object manager again for an absent object
+    static constexpr uint64_t kResolveRetryFrames = 30;
+
+    PositionHistory();
+    ~PositionHistory() = default;
+
+    // Non-copyable, non-movable
+    PositionHistory(const PositionHistory&) = delete;
+    PositionHistory& operator=(const PositionHistory&) = delete;
+    PositionHistory(PositionHistory&&) = delete;
+    PositionHistory& operator=(PositionHistory&&) = delete;
+
+    // Start recording `guid` into a ring of `capacity` samples (0 = default); re-tracking resets the ring
+    bool track(uint64_t guid, uint32_t capacity);
+
+    // Stop recording `guid`, returns false if it was not tracked
+    bool untrack(uint64_t guid);
+
+    // Stop recording everything, the local player included
+    void clear();
+
+    size_t getTrackCount() const {
+        return m_tracks.size();
+    }
+
+    // Append one sample per tracked object that is currently in the world
+    void record(uint64_t frameNumber, int64_t nowMicros, const interfaces::IMemoryReader& memory);
+
+    // Samples of `guid` from the last `windowFrames` recorded frames and recorded within `windowMicros` of the
+    // last recorded frame (0 = no limit for either), oldest first. Returns false if `guid` is not tracked.
+    bool query(uint64_t guid, uint64_t windowFrames, uint64_t windowMicros, std::vector<PositionSample>& samples) const;
+
+private:
+    struct Track {
+        uint64_t guid{0};
+        uint64_t resolvedGuid{0};
+        uint32_t address{0};
+        uint64_t nextResolveFrame{0};
+        std::vector<PositionSample> ring;
+        size_t head{0};
+        size_t count{0};
+    };
+
+    Track* findTrack(uint64_t guid);
+    const Track* findTrack(uint64_t guid) const;
+
+    bool resolve(Track& track, uint64_t frameNumber, uint64_t localGuid, const interfaces::IMemoryReader& memory);
+
+    std::vector<Track> m_tracks;
+    uint64_t m_lastFrame{0};
+    int64_t m_lastMicros{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_POSITION_HISTORY_HPP
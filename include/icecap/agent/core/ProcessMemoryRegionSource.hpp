@@ -0,0 +1,36 @@
+#ifndef ICECAP_AGENT_CORE_PROCESS_MEMORY_REGION_SOURCE_HPP
+#define ICECAP_AGENT_CORE_PROCESS_MEMORY_REGION_SOURCE_HPP
+
+#include "../interfaces/IMemoryRegionSource.hpp"
+
+namespace icecap::agent::core {
+
+/**
+ * IMemoryRegionSource over the current process.
+ * Regions come from VirtualQuery. Copies are plain memcpy under a fault
+ * guard: structured exception handling on MSVC, a vectored exception handler
+ * (installed for the lifetime of the source) elsewhere. ReadProcessMemory is
+ * only used if that handler cannot be installed.
+ */
+class ProcessMemoryRegionSource : public interfaces::IMemoryRegionSource {
+public:
+    ProcessMemoryRegionSource();
+    ~ProcessMemoryRegionSource() override;
+
+    // Non-copyable, non-movable
+    ProcessMemoryRegionSource(const ProcessMemoryRegionSource&) = delete;
+    ProcessMemoryRegionSource& operator=(const ProcessMemoryRegionSource&) = delete;
+    ProcessMemoryRegionSource(ProcessMemoryRegionSource&&) = delete;
+    ProcessMemoryRegionSource& operator=(ProcessMemoryRegionSource&&) = delete;
+
+    bool queryReadableRegion(uintptr_t address, uintptr_t& begin, uintptr_t& end) const override;
+    bool copy(uintptr_t address, void* out, size_t size) const override;
+
+private:
+    // Vectored exception handler registration (non-MSVC builds only)
+    void* m_faultHandler{nullptr};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_PROCESS_MEMORY_REGION_SOURCE_HPP
@@ -0,0 +1,103 @@
+#ifndef ICECAP_AGENT_CORE_RECURRING_TASK_MANAGER_HPP
+#define ICECAP_AGENT_CORE_RECURRING_TASK_MANAGER_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TimerWheel.hpp"
+
+namespace icecap::agent::core {
+
+class CommandExecutor;
+
+// Outcome of one recurring task run that must be reported to the controller
+struct RecurringTaskResult {
+    std::string taskId;
+    bool isRead{false};
+    bool success{false};
+    std::string value;
+};
+
+/**
+ * Recurring Lua tasks driven from the EndScene hook.
+ * Frame-interval tasks live on a wheel ticked once per frame, time-interval
+ * tasks on a wheel ticked once per millisecond, so the per-frame cost does
+ * not depend on how many tasks are registered.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class RecurringTaskManager {
+public:
+    static constexpr size_t kMaxTasks = 256;
+
+    // Wheel ticks advanced per update at most; a longer stall is skipped rather than replayed
+    static constexpr uint64_t kMaxCatchUpTicks = 1024;
+
+    enum class Action { EXECUTE, READ };
+
+    struct Definition {
+        std::string id;
+        Action action{Action::EXECUTE};
+        std::string code;
+        uint32_t intervalFrames{0};
+        uint32_t intervalMs{0};
+    };
+
+    RecurringTaskManager() = default;
+    ~RecurringTaskManager() = default;
+
+    // Non-copyable, non-movable
+    RecurringTaskManager(const RecurringTaskManager&) = delete;
+    RecurringTaskManager& operator=(const RecurringTaskManager&) = delete;
+    RecurringTaskManager(RecurringTaskManager&&) = delete;
+    RecurringTaskManager& operator=(RecurringTaskManager&&) = delete;
+
+    // Register (or replace) a task; exactly one of intervalFrames / intervalMs must be set
+    bool registerTask(const Definition& definition);
+
+    // Remove a task, returns false if it was not registered
+    bool unregisterTask(const std::string& taskId);
+
+    // Remove all tasks
+    void clear();
+
+    size_t getTaskCount() const {
+        return m_tasks.size();
+    }
+
+    // Advance both wheels and run every task that came due
+    void update(uint64_t frameNumber, uint64_t nowMs, CommandExecutor& executor,
+                std::vector<RecurringTaskResult>& results);
+
+private:
+    struct Entry {
+        Definition definition;
+        TimerWheel::TimerId timer{TimerWheel::kInvalidTimer};
+        bool timeBased{false};
+    };
+
+    // Advance `wheel` from `last` towards `now`, collecting expired timers into m_expired
+    void catchUp(TimerWheel& wheel, uint64_t& last, uint64_t now);
+    void run(Entry& entry, CommandExecutor& executor, std::vector<RecurringTaskResult>& results);
+    void fire(TimerWheel& wheel, std::vector<std::string>& owners, CommandExecutor& executor,
+              std::vector<RecurringTaskResult>& results);
+
+    std::unordered_map<std::string, Entry> m_tasks;
+
+    // Each wheel maps its timer IDs back to the owning task ID
+    TimerWheel m_frameWheel;
+    TimerWheel m_timeWheel;
+    std::vector<std::string> m_frameOwners;
+    std::vector<std::string> m_timeOwners;
+    std::vector<TimerWheel::TimerId> m_expired;
+
+    uint64_t m_lastFrame{0};
+    uint64_t m_lastTimeMs{0};
+    bool m_started{false};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_RECURRING_TASK_MANAGER_HPP
@@ -0,0 +1,71 @@
+#ifndef ICECAP_AGENT_CORE_SCRIPT_PROFILER_HPP
+#define ICECAP_AGENT_CORE_SCRIPT_PROFILER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../interfaces/IScriptObserver.hpp"
+#include "CommandLatency.hpp"
+
+namespace icecap::agent::core {
+
+// Accumulated cost of every Lua chunk run under one name
+struct ScriptProfile {
+    std::string name;
+    uint64_t count{0};
+    uint64_t totalMicros{0};
+    uint64_t maxMicros{0};
+    uint64_t p99Micros{0};
+};
+
+/**
+ * Per-script Lua execution profile: each chunk name gets a latency histogram
+ * of its FrameScript_Execute calls, so the scripts eating the frame budget
+ * can be ranked by total time. Names are the caller's (task and state machine
+ * ids) or a content hash (see CommandExecutor). Past kMaxScripts names, new
+ * ones are folded into kOtherScripts. Every call is forwarded to `next`, so
+ * the profiler sits in front of the frame stall watchdog.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class ScriptProfiler : public interfaces::IScriptObserver {
+public:
+    static constexpr size_t kMaxScripts = 1024;
+    static constexpr const char* kOtherScripts = "(other)";
+
+    // Scripts reported when a query does not ask for a count
+    static constexpr size_t kDefaultTopCount = 20;
+
+    explicit ScriptProfiler(interfaces::IScriptObserver& next) : m_next(next) {}
+    ~ScriptProfiler() override = default;
+
+    // Non-copyable, non-movable
+    ScriptProfiler(const ScriptProfiler&) = delete;
+    ScriptProfiler& operator=(const ScriptProfiler&) = delete;
+    ScriptProfiler(ScriptProfiler&&) = delete;
+    ScriptProfiler& operator=(ScriptProfiler&&) = delete;
+
+    // IScriptObserver: record the chunk, then forward it
+    void onScriptExecuted(const std::string& scriptName, int64_t elapsedMicros) override;
+
+    // The `count` scripts with the largest total time, most expensive first
+    std::vector<ScriptProfile> top(size_t count) const;
+
+    // Distinct script names profiled so far (kOtherScripts included)
+    size_t getScriptCount() const {
+        return m_scripts.size();
+    }
+
+    void reset();
+
+private:
+    interfaces::IScriptObserver& m_next;
+    std::unordered_map<std::string, std::unique_ptr<LatencyHistogram>> m_scripts;
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_SCRIPT_PROFILER_HPP
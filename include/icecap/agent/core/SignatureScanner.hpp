@@ -0,0 +1,50 @@
+#ifndef ICECAP_AGENT_CORE_SIGNATURE_SCANNER_HPP
+#define ICECAP_AGENT_CORE_SIGNATURE_SCANNER_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace icecap::agent::core {
+
+// Byte pattern with wildcards, parsed from "55 8B EC ?? ?? 8B" notation
+struct Signature {
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask; // 0xFF for a concrete byte, 0x00 for a wildcard
+
+    // Concrete bytes used to filter candidates before the full comparison
+    size_t firstAnchor{0};
+    size_t lastAnchor{0};
+
+    size_t size() const {
+        return bytes.size();
+    }
+
+    // Nullopt for malformed patterns and patterns without a concrete byte
+    static std::optional<Signature> parse(std::string_view pattern);
+};
+
+/**
+ * Wildcard byte-pattern search over an in-memory image.
+ * Candidates are filtered 16 positions at a time by comparing two concrete
+ * anchor bytes of the pattern with SSE2; only positions where both match are
+ * compared in full.
+ */
+class SignatureScanner {
+public:
+    static constexpr size_t kNotFound = SIZE_MAX;
+
+    // Offset of the first match at or after `start`, or kNotFound
+    static size_t find(const uint8_t* data, size_t size, const Signature& signature, size_t start = 0);
+
+    // Number of matches, counting stops at `limit`
+    static size_t count(const uint8_t* data, size_t size, const Signature& signature, size_t limit);
+
+    // True if `signature` matches at `offset`
+    static bool matchesAt(const uint8_t* data, size_t size, const Signature& signature, size_t offset);
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_SIGNATURE_SCANNER_HPP
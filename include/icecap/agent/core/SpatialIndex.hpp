@@ -0,0 +1,78 @@
+#ifndef ICECAP_AGENT_CORE_SPATIAL_INDEX_HPP
+#define ICECAP_AGENT_CORE_SPATIAL_INDEX_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "ObjectSnapshot.hpp"
+
+namespace icecap::agent::core {
+
+/**
+ * Hashed uniform grid over the X/Y columns of an ObjectTable.
+ * Rows are bucketed with a counting sort, so a rebuild is two linear passes
+ * and allocation-free once warm. Distances are measured in 3D; the grid only
+ * prunes on the horizontal plane.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class SpatialIndex {
+public:
+    static constexpr float kCellSize = 16.0f;
+    static constexpr uint32_t kBucketBits = 12;
+    static constexpr uint32_t kBucketCount = 1u << kBucketBits;
+
+    // Queries spanning more cells than this scan the table linearly instead
+    static constexpr uint64_t kMaxScannedCells = kBucketCount;
+
+    struct Neighbor {
+        size_t row;
+        float distanceSquared;
+    };
+
+    SpatialIndex();
+    ~SpatialIndex() = default;
+
+    // Non-copyable, non-movable
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+    SpatialIndex(SpatialIndex&&) = delete;
+    SpatialIndex& operator=(SpatialIndex&&) = delete;
+
+    // Index `table`; skipped when `version` matches the last build
+    void build(const ObjectTable& table, uint64_t version);
+
+    // Rows of the indexed types (bit per ObjectType, 0 = all) within `radius`, nearest first
+    void queryRadius(float x, float y, float z, float radius, uint32_t typeMask, std::vector<Neighbor>& results);
+
+    // Up to `count` nearest rows of the indexed types within `maxRadius` (0 = unbounded), nearest first
+    void queryNearest(float x, float y, float z, size_t count, float maxRadius, uint32_t typeMask,
+                      std::vector<Neighbor>& results);
+
+private:
+    static int32_t cellCoordinate(float value);
+    static uint32_t bucketOf(int32_t cellX, int32_t cellY);
+    static bool scansLinearly(float radius);
+
+    bool accepts(size_t row, uint32_t typeMask) const;
+    float distanceSquared(size_t row, float x, float y, float z) const;
+
+    // Append candidates within `radius` without sorting
+    void collect(float x, float y, float z, float radius, uint32_t typeMask, std::vector<Neighbor>& results);
+
+    const ObjectTable* m_table{nullptr};
+    uint64_t m_version{UINT64_MAX};
+
+    std::array<uint32_t, kBucketCount + 1> m_bucketStart{};
+    std::vector<uint32_t> m_rows;
+    std::vector<uint32_t> m_rowBucket;
+
+    // Generation stamps de-duplicate buckets that several cells hash to within one query
+    std::array<uint32_t, kBucketCount> m_bucketVisited{};
+    uint32_t m_queryGeneration{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_SPATIAL_INDEX_HPP
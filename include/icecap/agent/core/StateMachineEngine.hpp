@@ -0,0 +1,154 @@
+#ifndef ICECAP_AGENT_CORE_STATE_MACHINE_ENGINE_HPP
+#define ICECAP_AGENT_CORE_STATE_MACHINE_ENGINE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace icecap::agent::core {
+
+class CommandExecutor;
+
+// Data-driven state machine uploaded by the controller
+struct StateMachineDefinition {
+    // Transitions whose source is kAnyState apply in every state
+    static constexpr const char* kAnyState = "*";
+
+    struct State {
+        std::string name;
+        std::string onEnter;
+    };
+
+    struct Transition {
+        std::string from;
+        std::string to;
+        std::string condition;
+    };
+
+    std::string id;
+    std::vector<State> states;
+    std::vector<Transition> transitions;
+    std::string initialState;
+    uint32_t intervalFrames{1};
+};
+
+// A state change observed on the render thread
+struct StateTransition {
+    std::string machineId;
+    std::string fromState;
+    std::string toState;
+    uint64_t frameNumber{0};
+    uint32_t evaluationTimeUs{0};
+};
+
+/**
+ * Evaluates controller-defined state machines locally every frame so reactive
+ * logic runs without a network round trip. Transition conditions are Lua
+ * expressions evaluated through CommandExecutor, in declaration order; the
+ * first one that holds moves the machine and runs the target's on-enter code.
+ *
+ * Evaluation time is measured per frame and checked before every Lua call,
+ * on-enter code included. Once the frame budget is spent, the machine being
+ * evaluated resumes at the same transition (or runs its deferred on-enter
+ * code first) on the next frame and the remaining machines are deferred
+ * (round-robin), so the cost charged to a single frame is capped at the
+ * budget plus one Lua call.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class StateMachineEngine {
+public:
+    static constexpr size_t kMaxMachines = 32;
+    static constexpr size_t kMaxStates = 128;
+    static constexpr std::chrono::microseconds kDefaultFrameBudget{1000};
+
+    struct Stats {
+        uint32_t lastFrameCostUs{0};
+        uint32_t maxFrameCostUs{0};
+        uint64_t deferredEvaluations{0};
+    };
+
+    StateMachineEngine() = default;
+    ~StateMachineEngine() = default;
+
+    // Non-copyable, non-movable
+    StateMachineEngine(const StateMachineEngine&) = delete;
+    StateMachineEngine& operator=(const StateMachineEngine&) = delete;
+    StateMachineEngine(StateMachineEngine&&) = delete;
+    StateMachineEngine& operator=(StateMachineEngine&&) = delete;
+
+    // Validate and load (or replace) a machine; it enters its initial state on the next evaluation
+    bool load(const StateMachineDefinition& definition);
+
+    // Remove a machine, returns false if it was not loaded
+    bool unload(const std::string& machineId);
+
+    // Remove all machines
+    void clear();
+
+    size_t getMachineCount() const {
+        return m_machines.size();
+    }
+
+    void setFrameBudget(std::chrono::microseconds budget) {
+        m_frameBudget = budget;
+    }
+    std::chrono::microseconds getFrameBudget() const {
+        return m_frameBudget;
+    }
+
+    const Stats& getStats() const {
+        return m_stats;
+    }
+    void resetStats() {
+        m_stats = Stats{};
+    }
+
+    // Evaluate due machines within the frame budget and append state changes to `transitions`
+    void evaluate(uint64_t frameNumber, CommandExecutor& executor, std::vector<StateTransition>& transitions);
+
+private:
+    static constexpr size_t kNoState = SIZE_MAX;
+
+    struct CompiledTransition {
+        size_t target;
+        std::string condition;
+    };
+
+    struct Machine {
+        std::string id;
+        std::vector<StateMachineDefinition::State> states;
+
+        // Transitions applicable in each state, any-state transitions merged in declaration order
+        std::vector<std::vector<CompiledTransition>> transitions;
+
+        size_t initialState{0};
+        size_t currentState{kNoState};
+        uint32_t intervalFrames{1};
+        uint64_t nextDueFrame{0};
+        size_t nextTransition{0}; // Where evaluation of the current state resumes after running out of budget
+        bool onEnterPending{false}; // The current state's on-enter code was deferred for lack of budget
+    };
+
+    void enterState(Machine& machine, size_t state, uint64_t frameNumber, CommandExecutor& executor,
+                    std::vector<StateTransition>& transitions);
+    void runOnEnter(Machine& machine, CommandExecutor& executor);
+    // Returns false if the frame budget ran out before the machine was fully evaluated
+    bool step(Machine& machine, uint64_t frameNumber, CommandExecutor& executor,
+              std::vector<StateTransition>& transitions);
+
+    // Whether another Lua call fits into this frame's budget; counts the call if so
+    bool hasBudget();
+
+    std::vector<Machine> m_machines;
+    size_t m_cursor{0};
+    std::chrono::microseconds m_frameBudget{kDefaultFrameBudget};
+    std::chrono::steady_clock::time_point m_frameStart;
+    uint32_t m_frameLuaCalls{0};
+    Stats m_stats;
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_STATE_MACHINE_ENGINE_HPP
@@ -0,0 +1,193 @@
+#ifndef ICECAP_AGENT_CORE_TASK_SCHEDULER_HPP
+#define ICECAP_AGENT_CORE_TASK_SCHEDULER_HPP
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace icecap::agent::core {
+
+/**
+ * Coroutine task resumed by TaskScheduler on the render thread.
+ * Tasks start suspended and only run once handed to the scheduler.
+ */
+class Task {
+public:
+    struct promise_type {
+        // Frame the scheduler is currently running, set before every resume
+        uint64_t currentFrame{0};
+
+        // Wait state recorded by the awaitables below
+        uint64_t wakeFrame{0};
+        std::function<bool()> predicate;
+        uint32_t pollIntervalFrames{1};
+        uint64_t deadlineFrame{0};
+        bool waitSatisfied{true};
+
+        std::exception_ptr exception;
+
+        Task get_return_object() {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) : m_handle(handle) {}
+
+    ~Task() {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+
+    // Non-copyable, movable
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] Handle handle() const {
+        return m_handle;
+    }
+    explicit operator bool() const {
+        return static_cast<bool>(m_handle);
+    }
+
+private:
+    Handle m_handle;
+};
+
+// Suspend for `frames` frames (at least one)
+struct WaitFrames {
+    uint32_t frames{1};
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+    void await_suspend(Task::Handle handle) const noexcept {
+        auto& promise = handle.promise();
+        promise.wakeFrame = promise.currentFrame + (frames == 0 ? 1 : frames);
+    }
+    void await_resume() const noexcept {}
+};
+
+// Suspend until `predicate` holds, polled every `pollIntervalFrames` frames.
+// Resumes with false if `timeoutFrames` (0 = none) elapse first.
+struct WaitUntil {
+    std::function<bool()> predicate;
+    uint32_t pollIntervalFrames{1};
+    uint32_t timeoutFrames{0};
+    Task::Handle suspended{};
+
+    bool await_ready() const {
+        return predicate();
+    }
+    void await_suspend(Task::Handle handle) {
+        suspended = handle;
+        auto& promise = handle.promise();
+        promise.pollIntervalFrames = pollIntervalFrames == 0 ? 1 : pollIntervalFrames;
+        promise.wakeFrame = promise.currentFrame + promise.pollIntervalFrames;
+        promise.deadlineFrame = timeoutFrames == 0 ? 0 : promise.currentFrame + timeoutFrames;
+        promise.predicate = std::move(predicate);
+    }
+    bool await_resume() const noexcept {
+        return !suspended || suspended.promise().waitSatisfied;
+    }
+};
+
+/**
+ * Frame-driven scheduler for multi-frame commands.
+ * Suspended tasks sit in a min-heap keyed by wake frame, so a frame with
+ * nothing due costs a single heap peek regardless of how many tasks wait.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class TaskScheduler {
+public:
+    static constexpr size_t kMaxTasks = 64;
+
+    // A task whose coroutine exited with an exception; it is gone from the scheduler
+    struct Failure {
+        std::string id;
+        std::string error;
+    };
+
+    TaskScheduler() = default;
+    ~TaskScheduler() = default;
+
+    // Non-copyable, non-movable
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    TaskScheduler(TaskScheduler&&) = delete;
+    TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+    // Take ownership of a task and run it from the next tick
+    bool spawn(const std::string& id, Task task);
+
+    // Destroy a suspended task, returns false if it does not exist
+    bool cancel(const std::string& id);
+
+    // Destroy all tasks
+    void clear();
+
+    size_t getTaskCount() const {
+        return m_tasks.size();
+    }
+
+    // Resume every task due on this frame, appending the ones that threw to `failures`
+    void tick(uint64_t frameNumber, std::vector<Failure>& failures);
+
+private:
+    struct TaskEntry {
+        Task task;
+        uint64_t generation{0};
+    };
+
+    struct WakeEntry {
+        uint64_t wakeFrame;
+        uint64_t generation;
+        std::string id;
+
+        bool operator>(const WakeEntry& other) const {
+            return wakeFrame > other.wakeFrame;
+        }
+    };
+
+    void schedule(const std::string& id, TaskEntry& entry, uint64_t wakeFrame);
+
+    std::unordered_map<std::string, TaskEntry> m_tasks;
+    std::priority_queue<WakeEntry, std::vector<WakeEntry>, std::greater<>> m_wakeQueue;
+    uint64_t m_nextGeneration{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_TASK_SCHEDULER_HPP
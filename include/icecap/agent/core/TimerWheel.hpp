@@ -0,0 +1,79 @@
+#ifndef ICECAP_AGENT_CORE_TIMER_WHEEL_HPP
+#define ICECAP_AGENT_CORE_TIMER_WHEEL_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace icecap::agent::core {
+
+/**
+ * Hierarchical hashed timer wheel (4 levels x 64 slots).
+ * Timers live in an index-linked node pool, so scheduling, cancelling and
+ * advancing one tick are O(1) and allocation-free once the pool is warm.
+ * Delays longer than the wheel span (64^4 ticks) are clamped.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint32_t;
+    static constexpr TimerId kInvalidTimer = UINT32_MAX;
+
+    static constexpr uint32_t kLevelBits = 6;
+    static constexpr uint32_t kSlotsPerLevel = 1u << kLevelBits;
+    static constexpr uint32_t kLevels = 4;
+    static constexpr uint64_t kMaxDelay = (1ull << (kLevelBits * kLevels)) - 1;
+
+    TimerWheel();
+    ~TimerWheel() = default;
+
+    // Non-copyable, non-movable
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+    // Allocate / release a timer node
+    TimerId create();
+    void destroy(TimerId timer);
+
+    // Arm a timer to expire `delayTicks` ticks from now (re-arms if already pending)
+    void schedule(TimerId timer, uint64_t delayTicks);
+
+    // Disarm a pending timer
+    void cancel(TimerId timer);
+
+    // Advance by one tick, appending expired timers to `expired`
+    void advance(std::vector<TimerId>& expired);
+
+    uint64_t getCurrentTick() const {
+        return m_currentTick;
+    }
+
+    void clear();
+
+private:
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+
+    struct Node {
+        uint64_t expiry{0};
+        uint32_t prev{kNoNode};
+        uint32_t next{kNoNode};
+        uint16_t slot{0};
+        bool linked{false};
+        bool allocated{false};
+    };
+
+    void link(TimerId timer);
+    void unlink(TimerId timer);
+    void cascade(uint32_t level);
+
+    std::vector<Node> m_nodes;
+    std::vector<TimerId> m_freeNodes;
+    std::array<uint32_t, kSlotsPerLevel * kLevels> m_slots{};
+    std::vector<TimerId> m_cascadeScratch;
+    uint64_t m_currentTick{0};
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_TIMER_WHEEL_HPP
@@ -0,0 +1,103 @@
+#ifndef ICECAP_AGENT_CORE_TRACER_HPP
+#define ICECAP_AGENT_CORE_TRACER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace icecap::agent::core {
+
+// One finished span; names and argument names must be string literals
+struct TraceRecord {
+    const char* name{nullptr};
+    const char* argName{nullptr};
+    uint64_t argValue{0};
+    int64_t startMicros{0};
+    int64_t durationMicros{0};
+};
+
+/**
+ * Process-wide span recorder. Each thread writes finished spans into its own
+ * ring buffer of kRingCapacity records, allocated the first time it records
+ * while tracing is on; the oldest records are overwritten once it is full.
+ * Writers never lock. A dump copies every ring and keeps only the records
+ * that were not overwritten during the copy, then writes them as Chrome
+ * trace JSON (loadable in chrome://tracing and Perfetto).
+ */
+class Tracer {
+public:
+    static constexpr size_t kRingCapacity = 16384;
+
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    // Start or stop recording; stopping keeps the recorded spans for a later dump
+    static void setEnabled(bool enabled);
+
+    // Drop every recorded span
+    static void clear();
+
+    // Label the calling thread in dumps; `name` must be a string literal
+    static void nameThread(const char* name);
+
+    // Append a finished span to the calling thread's ring
+    static void record(const TraceRecord& record);
+
+    // Write every recorded span as Chrome trace JSON; returns the number of spans written
+    static size_t writeChromeTrace(std::ostream& out);
+
+    // Write a trace file, creating its directory; empty `path` picks a file next to the agent log
+    static bool dump(std::string path, std::string& writtenPath, size_t& spanCount);
+
+    static int64_t nowMicros();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * Scoped span. When tracing is off construction is a single relaxed load and
+ * destruction a branch, so spans can stay in hot paths.
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) {
+        if (Tracer::isEnabled()) {
+            m_record.name = name;
+            m_record.startMicros = Tracer::nowMicros();
+        }
+    }
+
+    TraceSpan(const char* name, const char* argName, uint64_t argValue) : TraceSpan(name) {
+        m_record.argName = argName;
+        m_record.argValue = argValue;
+    }
+
+    ~TraceSpan() {
+        if (m_record.name) {
+            m_record.durationMicros = Tracer::nowMicros() - m_record.startMicros;
+            Tracer::record(m_record);
+        }
+    }
+
+    // Non-copyable, non-movable
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    TraceSpan(TraceSpan&&) = delete;
+    TraceSpan& operator=(TraceSpan&&) = delete;
+
+private:
+    TraceRecord m_record;
+};
+
+} // namespace icecap::agent::core
+
+#define ICECAP_TRACE_CONCAT_INNER(a, b) a##b
+#define ICECAP_TRACE_CONCAT(a, b) ICECAP_TRACE_CONCAT_INNER(a, b)
+
+// Trace the enclosing scope: TRACE_SCOPE("name") or TRACE_SCOPE("name", "arg", value)
+#define TRACE_SCOPE(...) icecap::agent::core::TraceSpan ICECAP_TRACE_CONCAT(traceSpan_, __LINE__)(__VA_ARGS__)
+
+#endif // ICECAP_AGENT_CORE_TRACER_HPP
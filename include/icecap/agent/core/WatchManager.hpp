@@ -0,0 +1,76 @@
+#ifndef ICECAP_AGENT_CORE_WATCH_MANAGER_HPP
+#define ICECAP_AGENT_CORE_WATCH_MANAGER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace icecap::agent::core {
+
+class CommandExecutor;
+
+// A single watched expression whose value differs from the last published one
+struct WatchChange {
+    std::string subscriptionId;
+    std::string expression;
+    std::string value;
+};
+
+/**
+ * Registry of Lua watch subscriptions evaluated from the render thread.
+ * Each subscription re-evaluates its expressions every N frames and only
+ * reports values that changed since the previous evaluation.
+ *
+ * Not thread-safe: all calls must come from the EndScene hook.
+ */
+class WatchManager {
+public:
+    static constexpr size_t kMaxSubscriptions = 256;
+    static constexpr size_t kMaxExpressionsPerSubscription = 64;
+
+    WatchManager() = default;
+    ~WatchManager() = default;
+
+    // Non-copyable, non-movable
+    WatchManager(const WatchManager&) = delete;
+    WatchManager& operator=(const WatchManager&) = delete;
+    WatchManager(WatchManager&&) = delete;
+    WatchManager& operator=(WatchManager&&) = delete;
+
+    // Register (or replace) a subscription; the first evaluation happens on the next frame
+    bool subscribe(const std::string& subscriptionId, const std::vector<std::string>& expressions,
+                   uint32_t intervalFrames);
+
+    // Remove a subscription, returns false if it was not registered
+    bool unsubscribe(const std::string& subscriptionId);
+
+    // Remove all subscriptions
+    void clear();
+
+    size_t getSubscriptionCount() const {
+        return m_subscriptions.size();
+    }
+
+    // Evaluate all subscriptions due on this frame and append changed values to `changes`
+    void evaluate(uint64_t frameNumber, CommandExecutor& executor, std::vector<WatchChange>& changes);
+
+private:
+    struct WatchedExpression {
+        std::string expression;
+        std::string lastValue;
+        bool hasValue{false};
+    };
+
+    struct Subscription {
+        std::string id;
+        std::vector<WatchedExpression> expressions;
+        uint32_t intervalFrames{1};
+        uint64_t nextDueFrame{0};
+    };
+
+    std::vector<Subscription> m_subscriptions;
+};
+
+} // namespace icecap::agent::core
+
+#endif // ICECAP_AGENT_CORE_WATCH_MANAGER_HPP
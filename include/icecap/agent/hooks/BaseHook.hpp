@@ -1,19 +1,76 @@
 #ifndef ICECAP_AGENT_HOOKS_BASE_HOOK_HPP
 #define ICECAP_AGENT_HOOKS_BASE_HOOK_HPP
 
+#include <intrin.h>
+
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 #include "../interfaces/IHookRegistry.hpp"
 
 namespace icecap::agent::hooks {
 
+// CPU timestamp counter: a few dozen cycles to read, invariant on any CPU the client runs on
+inline uint64_t readCycleCounter() {
+    return __rdtsc();
+}
+
+/**
+ * Invocation counters of one detour. Each hook owns one, aligned to its own
+ * cache line so hooks firing on different threads never contend, and updated
+ * with relaxed atomics so any thread can read them.
+ */
+struct alignas(64) HookCounters {
+    std::atomic<uint64_t> invocations{0};
+    std::atomic<uint64_t> inclusiveCycles{0};
+    std::atomic<uint64_t> exclusiveCycles{0};
+};
+
+/**
+ * Times one detour invocation into its HookCounters when it goes out of
+ * scope. The call to the original function is bracketed with
+ * beginOriginal()/endOriginal() so it counts towards the inclusive time only.
+ */
+class HookTimer {
+public:
+    explicit HookTimer(HookCounters& counters) : m_counters(counters), m_start(readCycleCounter()) {}
+
+    ~HookTimer() {
+        const uint64_t inclusive = readCycleCounter() - m_start;
+        m_counters.invocations.fetch_add(1, std::memory_order_relaxed);
+        m_counters.inclusiveCycles.fetch_add(inclusive, std::memory_order_relaxed);
+        m_counters.exclusiveCycles.fetch_add(inclusive - m_originalCycles, std::memory_order_relaxed);
+    }
+
+    // Non-copyable, non-movable
+    HookTimer(const HookTimer&) = delete;
+    HookTimer& operator=(const HookTimer&) = delete;
+    HookTimer(HookTimer&&) = delete;
+    HookTimer& operator=(HookTimer&&) = delete;
+
+    void beginOriginal() {
+        m_originalStart = readCycleCounter();
+    }
+    void endOriginal() {
+        m_originalCycles += readCycleCounter() - m_originalStart;
+    }
+
+private:
+    HookCounters& m_counters;
+    uint64_t m_start;
+    uint64_t m_originalStart{0};
+    uint64_t m_originalCycles{0};
+};
+
 /**
  * Base class for all hook implementations.
  * Provides common functionality and standardized interface.
  */
 class BaseHook : public interfaces::IHook {
 public:
-    explicit BaseHook(std::string name);
+    // `counters` are the ones the detour records into with HookTimer; they usually outlive the hook
+    BaseHook(std::string name, const HookCounters& counters);
     ~BaseHook() override = default;
 
     // Non-copyable, non-movable
@@ -26,11 +83,12 @@ public:
     bool install() override;
     bool uninstall() override;
     bool isInstalled() const override {
-        return m_installed;
+        return m_installed.load(std::memory_order_acquire);
     }
     std::string getName() const override {
         return m_name;
     }
+    interfaces::HookStats getStats() const override;
 
 protected:
     // Template method pattern - subclasses implement these
@@ -39,12 +97,14 @@ protected:
 
     // Helper methods for subclasses
     void setInstalled(bool installed) {
-        m_installed = installed;
+        m_installed.store(installed, std::memory_order_release);
     }
 
 private:
     std::string m_name;
-    bool m_installed{false};
+    // Written by install/uninstall, read by HOOK_STATS_QUERY on the network thread
+    std::atomic<bool> m_installed{false};
+    const HookCounters& m_counters;
 };
 
 } // namespace icecap::agent::hooks
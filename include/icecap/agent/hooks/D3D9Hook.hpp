@@ -3,6 +3,9 @@
 
 #include <d3d9.h>
 
+#include <atomic>
+#include <cstdint>
+
 #include "BaseHook.hpp"
 
 namespace icecap::agent::hooks {
@@ -19,23 +22,39 @@ public:
     // Get the original EndScene function pointer
     static long(__stdcall* GetOriginalEndScene())(IDirect3DDevice9*);
 
+    // Number of EndScene calls observed since the hook was installed
+    static uint64_t GetFrameCount();
+
 protected:
     // BaseHook implementation
     bool doInstall() override;
     bool doUninstall() override;
 
 private:
+    // IDirect3DDevice9 vtable slot of EndScene
+    static constexpr size_t kEndSceneIndex = 42;
+
+    // IDirect3DDevice9 pointer inside CGxDevice (build 12340)
+    static constexpr uintptr_t kGxDeviceD3DOffset = 0x397C;
+
     // Hook function signature
     using EndSceneFunc = long(__stdcall*)(IDirect3DDevice9*);
 
     // Original function pointer storage
     static EndSceneFunc s_originalEndScene;
 
+    // Frame counter (only written from the render thread)
+    static std::atomic<uint64_t> s_frameCount;
+
+    // HookedEndScene invocation counters
+    static HookCounters s_counters;
+
     // Hook implementation
     static long __stdcall HookedEndScene(IDirect3DDevice9* pDevice);
 
     // Helper methods
     bool findEndSceneAddress();
+    bool findGameDeviceEndScene();
     bool installMinHook();
     bool uninstallMinHook();
 
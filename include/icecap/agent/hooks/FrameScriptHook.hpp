@@ -0,0 +1,31 @@
+#ifndef ICECAP_AGENT_HOOKS_FRAMESCRIPT_HOOK_HPP
+#define ICECAP_AGENT_HOOKS_FRAMESCRIPT_HOOK_HPP
+
+#include <cstdint>
+
+#include "BaseHook.hpp"
+
+namespace icecap::agent::hooks {
+
+/**
+ * FrameScript__SignalEvent hook implementation.
+ * Streams subscribed game events (see core::GameEventStream) to the controller.
+ */
+class FrameScriptHook : public BaseHook {
+public:
+    FrameScriptHook();
+    ~FrameScriptHook() override = default;
+
+protected:
+    // BaseHook implementation
+    bool doInstall() override;
+    bool doUninstall() override;
+
+private:
+    // FrameScript__SignalEvent, taken from core::GameAddresses at install time
+    uintptr_t m_targetAddress{0};
+};
+
+} // namespace icecap::agent::hooks
+
+#endif // ICECAP_AGENT_HOOKS_FRAMESCRIPT_HOOK_HPP
@@ -1,6 +1,7 @@
 #ifndef ICECAP_AGENT_HOOKS_HOOK_REGISTRY_HPP
 #define ICECAP_AGENT_HOOKS_HOOK_REGISTRY_HPP
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -12,10 +13,12 @@ namespace icecap::agent::hooks {
 /**
  * Concrete implementation of IHookRegistry.
  * Manages a collection of hooks and provides batch operations.
+ * The timestamp counter is calibrated against the performance counter over
+ * the registry's lifetime, so the estimate sharpens the longer it runs.
  */
 class HookRegistry : public interfaces::IHookRegistry {
 public:
-    HookRegistry() = default;
+    HookRegistry();
     ~HookRegistry() override;
 
     // Non-copyable, non-movable
@@ -30,8 +33,14 @@ public:
     bool uninstallAllHooks() override;
     size_t getInstalledHookCount() const override;
     std::shared_ptr<interfaces::IHook> getHook(const std::string& name) const override;
+    std::vector<interfaces::HookStats> getHookStats() const override;
+    double getCyclesPerSecond() const override;
 
 private:
+    // Timestamp and performance counters read together at construction
+    uint64_t m_calibrationCycles;
+    int64_t m_calibrationTicks;
+
     std::vector<std::shared_ptr<interfaces::IHook>> m_hooks;
     std::unordered_map<std::string, std::shared_ptr<interfaces::IHook>> m_hooksByName;
 };
@@ -1,12 +1,17 @@
 #ifndef ICECAP_AGENT_HOOKS_FRAMESCRIPT_HOOKS_HPP
 #define ICECAP_AGENT_HOOKS_FRAMESCRIPT_HOOKS_HPP
 
+#include "BaseHook.hpp"
+
 namespace icecap::agent::hooks {
 
 // Function pointer for the original FrameScript__SignalEvent
 using p_FrameScriptSignalEvent = void(__cdecl*)(int eventId, const char* fmt, int argsBase);
 extern p_FrameScriptSignalEvent g_OriginalFrameScriptSignalEvent;
 
+// HookedFrameScriptSignalEvent invocation counters
+extern HookCounters g_FrameScriptSignalEventCounters;
+
 // Hooked function declaration
 void __cdecl HookedFrameScriptSignalEvent(int eventid, const char* fmt, int argsBase);
 
@@ -1,11 +1,16 @@
 #ifndef ICECAP_AGENT_HOOKS_HOOK_MANAGER_HPP
 #define ICECAP_AGENT_HOOKS_HOOK_MANAGER_HPP
 
+#include "../interfaces/IHookRegistry.hpp"
+
 namespace icecap::agent::hooks {
 
 // Installs all available hooks
 void InstallHooks(bool enableEvents = true);
 
+// Registry of the installed hooks, null before InstallHooks(); read-only use is safe from any thread
+const interfaces::IHookRegistry* GetHookRegistry();
+
 } // namespace icecap::agent::hooks
 
 #endif // ICECAP_AGENT_HOOKS_HOOK_MANAGER_HPP
@@ -10,12 +10,46 @@
 #include "icecap/agent/v1/commands.pb.h"
 #include "icecap/agent/v1/events.pb.h"
 
+#include "../core/CommandLatency.hpp"
+
+namespace icecap::agent::core {
+class AgentMetrics;
+class FrameStallWatchdog;
+class FrameTimingStats;
+class GameEventAggregator;
+class GameEventStream;
+class GameStatePublisher;
+class ObjectSnapshotEngine;
+class PageCachedMemoryReader;
+class PathFollower;
+class PositionHistory;
+class SpatialIndex;
+class RecurringTaskManager;
+class ScriptProfiler;
+class StateMachineEngine;
+class TaskScheduler;
+class WatchManager;
+} // namespace icecap::agent::core
+
 namespace icecap::agent::interfaces {
 
 // Message type aliases
 using IncomingMessage = icecap::agent::v1::Command;
 using OutgoingMessage = icecap::agent::v1::Event;
 
+// Queue entries carry the command's stage timestamps between threads
+struct QueuedCommand {
+    IncomingMessage command;
+    core::CommandTimeline timeline;
+    size_t bytes{0}; // Encoded size, for the queue metrics
+};
+
+struct QueuedEvent {
+    OutgoingMessage event;
+    core::CommandTimeline timeline; // Inactive unless this is the first event of a command
+    size_t bytes{0};
+};
+
 class IApplicationContext {
 public:
     virtual ~IApplicationContext() = default;
@@ -27,13 +61,46 @@ public:
     virtual void stop() = 0;
 
     // Message queue access
-    virtual std::queue<IncomingMessage>& getInboxQueue() = 0;
-    virtual std::queue<OutgoingMessage>& getOutboxQueue() = 0;
+    virtual std::queue<QueuedCommand>& getInboxQueue() = 0;
+    virtual std::queue<QueuedEvent>& getOutboxQueue() = 0;
 
     // Synchronization primitives
     virtual std::mutex& getInboxMutex() = 0;
     virtual std::mutex& getOutboxMutex() = 0;
 
+    // Render-thread state shared across frames
+    virtual core::WatchManager& getWatchManager() = 0;
+    virtual core::PathFollower& getPathFollower() = 0;
+    virtual core::TaskScheduler& getTaskScheduler() = 0;
+    virtual core::RecurringTaskManager& getRecurringTaskManager() = 0;
+    virtual core::StateMachineEngine& getStateMachineEngine() = 0;
+    virtual core::ObjectSnapshotEngine& getObjectSnapshotEngine() = 0;
+    virtual core::SpatialIndex& getSpatialIndex() = 0;
+    virtual core::PositionHistory& getPositionHistory() = 0;
+    virtual core::FrameStallWatchdog& getFrameStallWatchdog() = 0;
+
+    // Per-script Lua timing; executors report to it and it forwards to the frame stall watchdog
+    virtual core::ScriptProfiler& getScriptProfiler() = 0;
+
+    // Client frame clock; the current frame number is readable from any thread
+    virtual core::FrameTimingStats& getFrameTiming() = 0;
+
+    // Game state published by the render thread, readable from any thread
+    virtual core::GameStatePublisher& getGameStatePublisher() = 0;
+
+    // Game events captured by the FrameScript hook, drained by the EndScene hook
+    virtual core::GameEventStream& getGameEventStream() = 0;
+    virtual core::GameEventAggregator& getGameEventAggregator() = 0;
+
+    // Command lifecycle latency, recorded lock-free from any thread
+    virtual core::CommandLatencyRecorder& getCommandLatency() = 0;
+
+    // Operational counters and gauges, recorded lock-free from any thread
+    virtual core::AgentMetrics& getMetrics() = 0;
+
+    // Game-thread memory reader; its page cache is invalidated at the start of every frame
+    virtual core::PageCachedMemoryReader& getMemoryReader() = 0;
+
     // Module information
     virtual HMODULE getModuleHandle() const = 0;
 };
@@ -1,12 +1,23 @@
 #ifndef ICECAP_AGENT_INTERFACES_IHOOK_REGISTRY_HPP
 #define ICECAP_AGENT_INTERFACES_IHOOK_REGISTRY_HPP
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace icecap::agent::interfaces {
 
+// Invocation counters of one hook's detour, in CPU timestamp counter cycles
+struct HookStats {
+    std::string name;
+    bool installed{false};
+    uint64_t invocations{0};
+    uint64_t inclusiveCycles{0}; // Whole detour, including the original function
+    uint64_t exclusiveCycles{0}; // Detour only: the agent's own cost
+};
+
 class IHook {
 public:
     virtual ~IHook() = default;
@@ -22,6 +33,9 @@ public:
 
     // Get hook name for logging/debugging
     virtual std::string getName() const = 0;
+
+    // Snapshot of the detour's invocation counters; safe to call from any thread
+    virtual HookStats getStats() const = 0;
 };
 
 class IHookRegistry {
@@ -42,6 +56,12 @@ public:
 
     // Get hook by name
     virtual std::shared_ptr<IHook> getHook(const std::string& name) const = 0;
+
+    // Counters of every registered hook, in registration order
+    virtual std::vector<HookStats> getHookStats() const = 0;
+
+    // Timestamp counter frequency, for converting HookStats cycles to time
+    virtual double getCyclesPerSecond() const = 0;
 };
 
 } // namespace icecap::agent::interfaces
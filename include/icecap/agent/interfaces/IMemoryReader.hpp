@@ -0,0 +1,55 @@
+#ifndef ICECAP_AGENT_INTERFACES_IMEMORY_READER_HPP
+#define ICECAP_AGENT_INTERFACES_IMEMORY_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace icecap::agent::interfaces {
+
+class IMemoryReader {
+public:
+    virtual ~IMemoryReader() = default;
+
+    // Copy `size` bytes at `address` into `out`; returns false (without faulting) if any byte is unreadable
+    virtual bool read(uintptr_t address, void* out, size_t size) const = 0;
+
+    // Read a NUL-terminated string of at most `maxLength` characters into `out`.
+    // Returns false if the start is unreadable; a string cut short by unreadable memory is kept.
+    virtual bool readString(uintptr_t address, std::string& out, size_t maxLength) const {
+        constexpr uintptr_t kPageSize = 4096;
+
+        out.clear();
+        char chunk[256];
+        while (out.size() < maxLength) {
+            // Never let a chunk cross into the next page, which may be unmapped
+            const size_t toPageEnd = kPageSize - (address & (kPageSize - 1));
+            size_t length = toPageEnd < sizeof(chunk) ? toPageEnd : sizeof(chunk);
+            length = length < maxLength - out.size() ? length : maxLength - out.size();
+            if (!read(address, chunk, length)) {
+                return !out.empty();
+            }
+            for (size_t i = 0; i < length; ++i) {
+                if (chunk[i] == '\0') {
+                    out.append(chunk, i);
+                    return true;
+                }
+            }
+            out.append(chunk, length);
+            address += length;
+        }
+        return true;
+    }
+
+    // Convenience wrapper for trivially copyable values
+    template <typename T>
+    bool readValue(uintptr_t address, T& out) const {
+        static_assert(std::is_trivially_copyable_v<T>, "readValue requires a trivially copyable type");
+        return read(address, &out, sizeof(T));
+    }
+};
+
+} // namespace icecap::agent::interfaces
+
+#endif // ICECAP_AGENT_INTERFACES_IMEMORY_READER_HPP
@@ -0,0 +1,24 @@
+#ifndef ICECAP_AGENT_INTERFACES_IMEMORY_REGION_SOURCE_HPP
+#define ICECAP_AGENT_INTERFACES_IMEMORY_REGION_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace icecap::agent::interfaces {
+
+// Platform memory primitives behind core::PageCachedMemoryReader
+class IMemoryRegionSource {
+public:
+    virtual ~IMemoryRegionSource() = default;
+
+    // Bounds [begin, end) of the readable region containing `address`; false if it is not readable
+    virtual bool queryReadableRegion(uintptr_t address, uintptr_t& begin, uintptr_t& end) const = 0;
+
+    // Copy `size` bytes from a validated address; returns false instead of faulting if the memory
+    // became unreadable since it was validated
+    virtual bool copy(uintptr_t address, void* out, size_t size) const = 0;
+};
+
+} // namespace icecap::agent::interfaces
+
+#endif // ICECAP_AGENT_INTERFACES_IMEMORY_REGION_SOURCE_HPP
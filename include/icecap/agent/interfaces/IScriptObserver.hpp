@@ -0,0 +1,20 @@
+#ifndef ICECAP_AGENT_INTERFACES_ISCRIPT_OBSERVER_HPP
+#define ICECAP_AGENT_INTERFACES_ISCRIPT_OBSERVER_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace icecap::agent::interfaces {
+
+// Told about every Lua chunk core::CommandExecutor runs, on the thread that ran it
+class IScriptObserver {
+public:
+    virtual ~IScriptObserver() = default;
+
+    // `scriptName` is the chunk name passed to the game; `elapsedMicros` covers the game call only
+    virtual void onScriptExecuted(const std::string& scriptName, int64_t elapsedMicros) = 0;
+};
+
+} // namespace icecap::agent::interfaces
+
+#endif // ICECAP_AGENT_INTERFACES_ISCRIPT_OBSERVER_HPP
@@ -1,46 +1,196 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <thread>
+
+#include <spdlog/fmt/fmt.h>
 
 namespace spdlog {
 class logger;
 }
 
+// Build-time minimum level: LOG_* calls below it compile to nothing (see ICECAP_LOG_ACTIVE_LEVEL in Options.cmake)
+#define ICECAP_LOG_LEVEL_TRACE 0
+#define ICECAP_LOG_LEVEL_DEBUG 1
+#define ICECAP_LOG_LEVEL_INFO 2
+#define ICECAP_LOG_LEVEL_WARN 3
+#define ICECAP_LOG_LEVEL_ERROR 4
+#define ICECAP_LOG_LEVEL_CRITICAL 5
+
+#ifndef ICECAP_LOG_ACTIVE_LEVEL
+    #if defined(_DEBUG) || !defined(NDEBUG)
+        #define ICECAP_LOG_ACTIVE_LEVEL ICECAP_LOG_LEVEL_TRACE
+    #else
+        #define ICECAP_LOG_ACTIVE_LEVEL ICECAP_LOG_LEVEL_INFO
+    #endif
+#endif
+
 namespace icecap::agent {
 
+// Severity of a log record; values match spdlog::level::level_enum
+enum class LogLevel : int {
+    TRACE = ICECAP_LOG_LEVEL_TRACE,
+    DEBUG = ICECAP_LOG_LEVEL_DEBUG,
+    INFO = ICECAP_LOG_LEVEL_INFO,
+    WARN = ICECAP_LOG_LEVEL_WARN,
+    ERR = ICECAP_LOG_LEVEL_ERROR,
+    CRITICAL = ICECAP_LOG_LEVEL_CRITICAL,
+    OFF
+};
+
+// What a logging thread does when the record ring is full
+enum class LogOverflowPolicy {
+    DROP_NEWEST, // Discard the record being logged (default)
+    DROP_OLDEST, // Discard the oldest queued record to make room
+    BLOCK        // Spin until the writer frees a slot; stalls the render thread, for sessions that must keep every line
+};
+
+class LogRing;
+
+/**
+ * Asynchronous logger. Logging threads format a record into a slot of a
+ * bounded lock-free ring and return; a background writer drains the ring
+ * into the rotating file and flushes once per batch. Logging itself never
+ * takes a lock or makes a system call (unless the overflow policy is
+ * BLOCK), so the EndScene hook can log without touching the disk.
+ * Records longer than kMaxMessageLength are truncated.
+ *
+ * The LOG_* macros check the level before evaluating their arguments, and
+ * format-string calls (LOG_INFO("{} of {}", a, b)) format into a
+ * thread-local buffer, so a record costs no heap allocation.
+ */
 class Logger {
 public:
+    // Setting this environment variable to drop_newest, drop_oldest or block selects the overflow policy
+    static constexpr const char* kOverflowPolicyVariable = "ICECAP_LOG_OVERFLOW";
+
+    // Longest record kept; the rest is cut off
+    static constexpr size_t kMaxMessageLength = 448;
+
     static Logger& getInstance();
 
     void initialize(const std::string& logFilePath = "");
     void shutdown();
 
-    void trace(const std::string& message);
-    void debug(const std::string& message);
-    void info(const std::string& message);
-    void warn(const std::string& message);
-    void error(const std::string& message);
-    void critical(const std::string& message);
+    void setOverflowPolicy(LogOverflowPolicy policy) {
+        m_overflowPolicy.store(policy, std::memory_order_relaxed);
+    }
+
+    // Records lost to a full ring since initialization
+    uint64_t getDroppedCount() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    // Runtime level; records below it are discarded before their message is built
+    void setLevel(LogLevel level) {
+        m_level.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+    bool isEnabled(LogLevel level) const {
+        return static_cast<int>(level) >= m_level.load(std::memory_order_relaxed);
+    }
+
+    // Queue `message` as is
+    void log(LogLevel level, std::string_view message);
+
+    // Queue `format` with `args` substituted, formatted without allocating
+    template <typename... Args>
+    void log(LogLevel level, fmt::format_string<Args...> format, Args&&... args) {
+        const auto result =
+            fmt::format_to_n(s_formatBuffer, sizeof(s_formatBuffer), format, std::forward<Args>(args)...);
+        log(level, std::string_view(s_formatBuffer, std::min(result.size, sizeof(s_formatBuffer))));
+    }
 
 private:
-    Logger() = default;
-    ~Logger() = default;
+    // Idle wait of the writer between polls of an empty ring
+    static constexpr unsigned long kWriterIdleMillis = 5;
+
+    // Formatting scratch space of the logging thread; the record is copied out of it into the ring
+    static inline thread_local char s_formatBuffer[kMaxMessageLength];
+
+    Logger();
+    ~Logger();
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
     [[nodiscard]] std::string getDefaultLogPath() const;
 
+    // Read kOverflowPolicyVariable, if set
+    void readOverflowPolicy();
+
+    // Writer thread: drain the ring into the sinks until shutdown
+    void writerThreadMain();
+
+    // Write every queued record to the sinks; returns the number written
+    size_t drain();
+
     std::shared_ptr<spdlog::logger> m_logger;
     bool m_initialized = false;
+    std::atomic<int> m_level{static_cast<int>(LogLevel::OFF)}; // OFF until initialized and after shutdown
+
+    std::unique_ptr<LogRing> m_ring;
+    std::atomic<LogOverflowPolicy> m_overflowPolicy{LogOverflowPolicy::DROP_NEWEST};
+    std::atomic<uint64_t> m_dropped{0};
+    uint64_t m_reportedDropped{0}; // Writer thread only
+
+    std::atomic<bool> m_writerRunning{false};
+    std::thread m_writerThread;
 };
 
-// Convenience macros for easier logging - simplified for compilation
-#define LOG_TRACE(msg) icecap::agent::Logger::getInstance().trace(msg)
-#define LOG_DEBUG(msg) icecap::agent::Logger::getInstance().debug(msg)
-#define LOG_INFO(msg) icecap::agent::Logger::getInstance().info(msg)
-#define LOG_WARN(msg) icecap::agent::Logger::getInstance().warn(msg)
-#define LOG_ERROR(msg) icecap::agent::Logger::getInstance().error(msg)
-#define LOG_CRITICAL(msg) icecap::agent::Logger::getInstance().critical(msg)
+} // namespace icecap::agent
+
+// Logging macros: LOG_INFO("text"), LOG_INFO(message) or LOG_INFO("format {}", args...). Arguments are only
+// evaluated when the level is enabled; below ICECAP_LOG_ACTIVE_LEVEL they are type-checked but never run.
+#define ICECAP_LOG(level, ...)                                                                                         \
+    do {                                                                                                               \
+        auto& icecapLogger_ = icecap::agent::Logger::getInstance();                                                    \
+        if (icecapLogger_.isEnabled(level)) {                                                                          \
+            icecapLogger_.log(level, __VA_ARGS__);                                                                     \
+        }                                                                                                              \
+    } while (false)
+
+#define ICECAP_LOG_DISABLED(level, ...)                                                                                \
+    do {                                                                                                               \
+        if (false) {                                                                                                   \
+            icecap::agent::Logger::getInstance().log(level, __VA_ARGS__);                                              \
+        }                                                                                                              \
+    } while (false)
+
+#if ICECAP_LOG_ACTIVE_LEVEL <= ICECAP_LOG_LEVEL_TRACE
+    #define LOG_TRACE(...) ICECAP_LOG(icecap::agent::LogLevel::TRACE, __VA_ARGS__)
+#else
+    #define LOG_TRACE(...) ICECAP_LOG_DISABLED(icecap::agent::LogLevel::TRACE, __VA_ARGS__)
+#endif
+
+#if ICECAP_LOG_ACTIVE_LEVEL <= ICECAP_LOG_LEVEL_DEBUG
+    #define LOG_DEBUG(...) ICECAP_LOG(icecap::agent::LogLevel::DEBUG, __VA_ARGS__)
+#else
+    #define LOG_DEBUG(...) ICECAP_LOG_DISABLED(icecap::agent::LogLevel::DEBUG, __VA_ARGS__)
+#endif
+
+#if ICECAP_LOG_ACTIVE_LEVEL <= ICECAP_LOG_LEVEL_INFO
+    #define LOG_INFO(...) ICECAP_LOG(icecap::agent::LogLevel::INFO, __VA_ARGS__)
+#else
+    #define LOG_INFO(...) ICECAP_LOG_DISABLED(icecap::agent::LogLevel::INFO, __VA_ARGS__)
+#endif
+
+#if ICECAP_LOG_ACTIVE_LEVEL <= ICECAP_LOG_LEVEL_WARN
+    #define LOG_WARN(...) ICECAP_LOG(icecap::agent::LogLevel::WARN, __VA_ARGS__)
+#else
+    #define LOG_WARN(...) ICECAP_LOG_DISABLED(icecap::agent::LogLevel::WARN, __VA_ARGS__)
+#endif
+
+#if ICECAP_LOG_ACTIVE_LEVEL <= ICECAP_LOG_LEVEL_ERROR
+    #define LOG_ERROR(...) ICECAP_LOG(icecap::agent::LogLevel::ERR, __VA_ARGS__)
+#else
+    #define LOG_ERROR(...) ICECAP_LOG_DISABLED(icecap::agent::LogLevel::ERR, __VA_ARGS__)
+#endif
 
-} // namespace icecap::agent
\ No newline at end of file
+#if ICECAP_LOG_ACTIVE_LEVEL <= ICECAP_LOG_LEVEL_CRITICAL
+    #define LOG_CRITICAL(...) ICECAP_LOG(icecap::agent::LogLevel::CRITICAL, __VA_ARGS__)
+#else
+    #define LOG_CRITICAL(...) ICECAP_LOG_DISABLED(icecap::agent::LogLevel::CRITICAL, __VA_ARGS__)
+#endif
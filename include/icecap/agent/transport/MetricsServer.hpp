@@ -0,0 +1,55 @@
+#ifndef ICECAP_AGENT_TRANSPORT_METRICS_SERVER_HPP
+#define ICECAP_AGENT_TRANSPORT_METRICS_SERVER_HPP
+
+#include <windows.h>
+#include <winsock2.h>
+
+#include <atomic>
+#include <functional>
+#include <string>
+
+namespace icecap::agent::transport {
+
+/**
+ * Minimal HTTP listener for metrics scrapes. Every connection gets one
+ * response carrying the renderer's output as text/plain and is then closed,
+ * which is all Prometheus and curl need. Runs on its own thread so a slow
+ * scraper never delays the command connection.
+ */
+class MetricsServer {
+public:
+    using Renderer = std::function<std::string()>;
+
+    explicit MetricsServer(Renderer renderer);
+    ~MetricsServer();
+
+    // Non-copyable, non-movable
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+    MetricsServer(MetricsServer&&) = delete;
+    MetricsServer& operator=(MetricsServer&&) = delete;
+
+    bool start(unsigned short port);
+    void stop();
+    bool isRunning() const {
+        return m_running.load();
+    }
+
+private:
+    // Scrapers that do not send their request within this time still get a response
+    static constexpr DWORD kRequestTimeoutMs = 1000;
+
+    static DWORD WINAPI ServerThreadProc(LPVOID param);
+    void serverThreadMain();
+    void serveClient(SOCKET clientSocket);
+
+    Renderer m_renderer;
+    std::atomic<bool> m_running{false};
+    SOCKET m_listenerSocket{INVALID_SOCKET};
+    HANDLE m_serverThread{nullptr};
+    unsigned short m_port{0};
+};
+
+} // namespace icecap::agent::transport
+
+#endif // ICECAP_AGENT_TRANSPORT_METRICS_SERVER_HPP
@@ -2,6 +2,7 @@
 #define ICECAP_AGENT_TRANSPORT_NETWORK_MANAGER_HPP
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -11,6 +12,9 @@
 #include "icecap/agent/v1/commands.pb.h"
 #include "icecap/agent/v1/events.pb.h"
 
+#include "../core/AgentMetrics.hpp"
+#include "../core/CommandLatency.hpp"
+#include "../interfaces/IApplicationContext.hpp"
 #include "../interfaces/IMessageHandler.hpp"
 #include "ProtocolHandler.hpp"
 #include "TcpServer.hpp"
@@ -19,6 +23,8 @@ namespace icecap::agent::transport {
 
 using IncomingMessage = icecap::agent::v1::Command;
 using OutgoingMessage = icecap::agent::v1::Event;
+using interfaces::QueuedCommand;
+using interfaces::QueuedEvent;
 
 /**
  * High-level network coordinator that orchestrates TCP server and protocol handling.
@@ -26,6 +32,10 @@ using OutgoingMessage = icecap::agent::v1::Event;
  */
 class NetworkManager {
 public:
+    // Answers a command directly on the network thread; returns false to defer it to the inbox
+    using QueryHandler = std::function<bool(const IncomingMessage& command, const core::CommandTimeline& timeline,
+                                            OutgoingMessage& response)>;
+
     NetworkManager();
     ~NetworkManager();
 
@@ -36,12 +46,21 @@ public:
     NetworkManager& operator=(NetworkManager&&) = delete;
 
     // Initialize and start the network services
-    bool startServer(std::queue<IncomingMessage>& inbox, std::queue<OutgoingMessage>& outbox, unsigned short port,
+    bool startServer(std::queue<QueuedCommand>& inbox, std::queue<QueuedEvent>& outbox, unsigned short port,
                      std::mutex& inboxMutex, std::mutex& outboxMutex);
 
     // Stop the network services
     void stopServer();
 
+    // Install the read-only query handler (must be called before startServer)
+    void setQueryHandler(QueryHandler handler);
+
+    // Record finished command timelines into `recorder` (must be called before startServer)
+    void setLatencyRecorder(core::CommandLatencyRecorder* recorder);
+
+    // Count traffic, connections and queue movements into `metrics` (must be called before startServer)
+    void setMetrics(core::AgentMetrics* metrics);
+
     // Check if server is running
     bool isRunning() const;
 
@@ -56,12 +75,15 @@ private:
     void onNetworkError(const std::string& error);
 
     // Handle protocol-level messages
-    void onMessageReceived(const std::string& message);
+    void onMessageReceived(const std::string& message, core::CommandTimeline& timeline);
     void onProtocolError(const std::string& error);
 
     // Background thread for processing outgoing messages
     void outgoingMessageThreadMain();
 
+    // Serialize, frame and send one event to the current client, completing `timeline` if it is active
+    bool sendEvent(const OutgoingMessage& event, core::CommandTimeline& timeline);
+
     std::unique_ptr<TcpServer> m_tcpServer;
     std::unique_ptr<ProtocolHandler> m_protocolHandler;
 
@@ -69,11 +91,20 @@ private:
     SOCKET m_currentClient{INVALID_SOCKET};
 
     // Message queues (references to external queues)
-    std::queue<IncomingMessage>* m_inboxQueue{nullptr};
-    std::queue<OutgoingMessage>* m_outboxQueue{nullptr};
+    std::queue<QueuedCommand>* m_inboxQueue{nullptr};
+    std::queue<QueuedEvent>* m_outboxQueue{nullptr};
     std::mutex* m_inboxMutex{nullptr};
     std::mutex* m_outboxMutex{nullptr};
 
+    // Read-only queries answered without waiting for a frame
+    QueryHandler m_queryHandler;
+
+    core::CommandLatencyRecorder* m_latencyRecorder{nullptr};
+    core::AgentMetrics* m_metrics{nullptr};
+
+    // Serializes sends from the outgoing thread and direct query responses
+    std::mutex m_sendMutex;
+
     // Protocol state
     std::string m_receiveBuffer;
     std::atomic<bool> m_running{false};
@@ -1,6 +1,11 @@
+#include <cstdlib>
+
 #include "MinHook.h"
 
 #include <icecap/agent/application_context.hpp>
+#include <icecap/agent/core/CommandExecutor.hpp>
+#include <icecap/agent/core/GameAddresses.hpp>
+#include <icecap/agent/core/MessageProcessor.hpp>
 #include <icecap/agent/hooks/hook_manager.hpp>
 #include <icecap/agent/logging.hpp>
 
@@ -23,10 +28,13 @@ bool ApplicationContext::initialize(HMODULE hModule) {
     m_running.store(true);
 
     try {
+        // Resolve game addresses before anything calls or hooks them
+        resolveGameAddresses();
+
         // Initialize hooks with error checking
         try {
             LOG_DEBUG("Installing hooks");
-            hooks::InstallHooks(false);
+            hooks::InstallHooks(true);
             LOG_INFO("Hooks installed successfully");
         } catch (const std::exception& e) {
             LOG_ERROR("Hook installation failed");
@@ -38,6 +46,14 @@ bool ApplicationContext::initialize(HMODULE hModule) {
         // Start network manager with error checking
         constexpr unsigned short kPORT = 5050;
 
+        // Read-only queries are answered on the network thread from the published game state
+        m_networkManager->setQueryHandler(
+            [this](const IncomingMessage& command, const core::CommandTimeline& timeline, OutgoingMessage& response) {
+                return core::MessageProcessor::answerReadOnlyQuery(*this, command, timeline, response);
+            });
+        m_networkManager->setLatencyRecorder(&m_commandLatency);
+        m_networkManager->setMetrics(&m_metrics);
+
         LOG_DEBUG("Starting network server on port 5050");
         if (!m_networkManager ||
             !m_networkManager->startServer(m_inboxQueue, m_outboxQueue, kPORT, m_inboxMutex, m_outboxMutex)) {
@@ -47,6 +63,9 @@ bool ApplicationContext::initialize(HMODULE hModule) {
             return false;
         }
 
+        // Metrics are optional; the agent runs without them if the listener cannot start
+        startMetricsServer();
+
         LOG_INFO("ApplicationContext initialization completed successfully");
         return true;
     } catch (const std::exception& e) {
@@ -72,7 +91,11 @@ void ApplicationContext::shutdown() {
     m_running.store(false);
 
     try {
-        // Stop network manager first
+        // Stop network listeners first
+        if (m_metricsServer) {
+            LOG_DEBUG("Stopping metrics server");
+            m_metricsServer->stop();
+        }
         if (m_networkManager) {
             LOG_DEBUG("Stopping network manager");
             m_networkManager->stopServer();
@@ -108,11 +131,11 @@ transport::NetworkManager& ApplicationContext::getNetworkManager() {
     return *m_networkManager;
 }
 
-std::queue<IncomingMessage>& ApplicationContext::getInboxQueue() {
+std::queue<QueuedCommand>& ApplicationContext::getInboxQueue() {
     return m_inboxQueue;
 }
 
-std::queue<OutgoingMessage>& ApplicationContext::getOutboxQueue() {
+std::queue<QueuedEvent>& ApplicationContext::getOutboxQueue() {
     return m_outboxQueue;
 }
 
@@ -124,6 +147,108 @@ std::mutex& ApplicationContext::getOutboxMutex() {
     return m_outboxMutex;
 }
 
+core::WatchManager& ApplicationContext::getWatchManager() {
+    return m_watchManager;
+}
+
+core::PathFollower& ApplicationContext::getPathFollower() {
+    return m_pathFollower;
+}
+
+core::TaskScheduler& ApplicationContext::getTaskScheduler() {
+    return m_taskScheduler;
+}
+
+core::RecurringTaskManager& ApplicationContext::getRecurringTaskManager() {
+    return m_recurringTaskManager;
+}
+
+core::StateMachineEngine& ApplicationContext::getStateMachineEngine() {
+    return m_stateMachineEngine;
+}
+
+core::ObjectSnapshotEngine& ApplicationContext::getObjectSnapshotEngine() {
+    return m_objectSnapshotEngine;
+}
+
+core::SpatialIndex& ApplicationContext::getSpatialIndex() {
+    return m_spatialIndex;
+}
+
+core::PositionHistory& ApplicationContext::getPositionHistory() {
+    return m_positionHistory;
+}
+
+core::FrameStallWatchdog& ApplicationContext::getFrameStallWatchdog() {
+    return m_frameStallWatchdog;
+}
+
+core::ScriptProfiler& ApplicationContext::getScriptProfiler() {
+    return m_scriptProfiler;
+}
+
+core::FrameTimingStats& ApplicationContext::getFrameTiming() {
+    return m_frameTiming;
+}
+
+core::GameStatePublisher& ApplicationContext::getGameStatePublisher() {
+    return m_gameStatePublisher;
+}
+
+core::GameEventStream& ApplicationContext::getGameEventStream() {
+    return m_gameEventStream;
+}
+
+core::CommandLatencyRecorder& ApplicationContext::getCommandLatency() {
+    return m_commandLatency;
+}
+
+core::AgentMetrics& ApplicationContext::getMetrics() {
+    return m_metrics;
+}
+
+core::GameEventAggregator& ApplicationContext::getGameEventAggregator() {
+    return m_gameEventAggregator;
+}
+
+core::PageCachedMemoryReader& ApplicationContext::getMemoryReader() {
+    return m_memoryReader;
+}
+
+void ApplicationContext::resolveGameAddresses() {
+    // The address cache lives next to the agent DLL
+    char modulePath[MAX_PATH] = {};
+    const DWORD length = GetModuleFileNameA(m_hModule, modulePath, MAX_PATH);
+    std::string cachePath(modulePath, length);
+    const size_t separator = cachePath.find_last_of("\\/");
+    cachePath.erase(separator == std::string::npos ? 0 : separator + 1);
+    cachePath += kAddressCacheFile;
+
+    core::GameAddressResolver::resolve(reinterpret_cast<uintptr_t>(GetModuleHandleA(nullptr)), cachePath);
+    core::CommandExecutor::bindGameFunctions();
+}
+
+void ApplicationContext::startMetricsServer() {
+    char value[16] = {};
+    const DWORD length = GetEnvironmentVariableA(kMetricsPortVariable, value, sizeof(value));
+    if (length == 0 || length >= sizeof(value)) {
+        return;
+    }
+
+    char* end = nullptr;
+    const unsigned long port = std::strtoul(value, &end, 10);
+    if (*end != '\0' || port == 0 || port > 65535) {
+        LOG_WARN("Ignoring invalid {} '{}'", kMetricsPortVariable, value);
+        return;
+    }
+
+    m_metricsServer = std::make_unique<transport::MetricsServer>([this] { return m_metrics.render(); });
+    if (!m_metricsServer->start(static_cast<unsigned short>(port))) {
+        LOG_WARN("Metrics server failed to start, continuing without it");
+        m_metricsServer.reset();
+    }
+}
+
 HMODULE ApplicationContext::getModuleHandle() const {
     return m_hModule;
 }
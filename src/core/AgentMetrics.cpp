@@ -0,0 +1,140 @@
+#include "icecap/agent/v1/commands.pb.h"
+
+#include <icecap/agent/core/AgentMetrics.hpp>
+
+namespace icecap::agent::core {
+
+namespace {
+
+void appendHeader(std::string& out, const char* name, const char* type, const char* help) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+template <typename T>
+void appendMetric(std::string& out, const char* name, const char* type, const char* help, T value) {
+    appendHeader(out, name, type, help);
+    out += name;
+    out += ' ';
+    out += std::to_string(value);
+    out += '\n';
+}
+
+// One sample per command type that has been seen, labelled with the contract's enum name
+void appendPerType(std::string& out, const char* name, const char* help,
+                   const std::array<std::atomic<uint64_t>, AgentMetrics::kMaxCommandTypes>& counters) {
+    appendHeader(out, name, "counter", help);
+    for (uint32_t type = 0; type < AgentMetrics::kMaxCommandTypes; ++type) {
+        const uint64_t value = counters[type].load(std::memory_order_relaxed);
+        if (value == 0) {
+            continue;
+        }
+
+        std::string label = icecap::agent::v1::CommandType_IsValid(static_cast<int>(type))
+                                ? icecap::agent::v1::CommandType_Name(static_cast<icecap::agent::v1::CommandType>(type))
+                                : std::to_string(type);
+        out += name;
+        out += "{type=\"";
+        out += label;
+        out += "\"} ";
+        out += std::to_string(value);
+        out += '\n';
+    }
+}
+
+} // namespace
+
+void AgentMetrics::recordBytesIn(size_t bytes) {
+    m_network.bytesIn.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AgentMetrics::recordBytesOut(size_t bytes) {
+    m_network.bytesOut.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AgentMetrics::recordConnection() {
+    m_network.connections.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AgentMetrics::recordInboxPush(size_t bytes) {
+    m_queues.inboxDepth.fetch_add(1, std::memory_order_relaxed);
+    m_queues.inboxBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void AgentMetrics::recordInboxPop(size_t bytes) {
+    m_queues.inboxDepth.fetch_sub(1, std::memory_order_relaxed);
+    m_queues.inboxBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void AgentMetrics::recordOutboxPush(size_t bytes) {
+    m_queues.outboxDepth.fetch_add(1, std::memory_order_relaxed);
+    m_queues.outboxBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void AgentMetrics::recordOutboxPop(size_t bytes) {
+    m_queues.outboxDepth.fetch_sub(1, std::memory_order_relaxed);
+    m_queues.outboxBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void AgentMetrics::recordFrame(int64_t hookMicros) {
+    m_render.frames.fetch_add(1, std::memory_order_relaxed);
+    m_render.hookMicros.fetch_add(static_cast<uint64_t>(hookMicros > 0 ? hookMicros : 0), std::memory_order_relaxed);
+}
+
+void AgentMetrics::recordCommand(uint32_t commandType, bool failed) {
+    if (commandType >= kMaxCommandTypes) {
+        return;
+    }
+    m_commands[commandType].fetch_add(1, std::memory_order_relaxed);
+    if (failed) {
+        m_failures[commandType].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::string AgentMetrics::render() const {
+    std::string out;
+    out.reserve(4096);
+
+    appendPerType(out, "icecap_commands_total", "Commands handled, by command type.", m_commands);
+    appendPerType(out, "icecap_command_failures_total", "Commands answered with an error, by command type.",
+                  m_failures);
+
+    // Gauges can be observed mid-update as one side lags the other; never report a negative depth
+    const auto gauge = [](const std::atomic<int64_t>& value) {
+        const int64_t current = value.load(std::memory_order_relaxed);
+        return current > 0 ? current : 0;
+    };
+    appendMetric(out, "icecap_inbox_depth", "gauge", "Commands waiting for the render thread.",
+                 gauge(m_queues.inboxDepth));
+    appendMetric(out, "icecap_inbox_bytes", "gauge", "Encoded size of the commands waiting for the render thread.",
+                 gauge(m_queues.inboxBytes));
+    appendMetric(out, "icecap_outbox_depth", "gauge", "Events waiting for the network thread.",
+                 gauge(m_queues.outboxDepth));
+    appendMetric(out, "icecap_outbox_bytes", "gauge", "Encoded size of the events waiting for the network thread.",
+                 gauge(m_queues.outboxBytes));
+
+    const uint64_t connections = m_network.connections.load(std::memory_order_relaxed);
+    appendMetric(out, "icecap_network_received_bytes_total", "counter", "Bytes received from controllers.",
+                 m_network.bytesIn.load(std::memory_order_relaxed));
+    appendMetric(out, "icecap_network_sent_bytes_total", "counter", "Bytes sent to controllers.",
+                 m_network.bytesOut.load(std::memory_order_relaxed));
+    appendMetric(out, "icecap_client_connections_total", "counter", "Controller connections accepted.", connections);
+    appendMetric(out, "icecap_client_reconnects_total", "counter", "Controller connections after the first.",
+                 connections > 0 ? connections - 1 : 0);
+
+    appendMetric(out, "icecap_frames_total", "counter", "Frames observed by the EndScene hook.",
+                 m_render.frames.load(std::memory_order_relaxed));
+    appendMetric(out, "icecap_render_thread_seconds_total", "counter",
+                 "Time the EndScene hook spent on agent work before handing the frame back to the game.",
+                 static_cast<double>(m_render.hookMicros.load(std::memory_order_relaxed)) / 1e6);
+    return out;
+}
+
+} // namespace icecap::agent::core
@@ -1,17 +1,32 @@
+#include <windows.h>
+
+#include <chrono>
+#include <cstdio>
+
 #include <icecap/agent/core/CommandExecutor.hpp>
+#include <icecap/agent/core/GameAddresses.hpp>
+#include <icecap/agent/core/Tracer.hpp>
 #include <icecap/agent/logging.hpp>
 
 namespace icecap::agent::core {
 
-// Initialize static function pointers with hardcoded addresses
+// Initialize static function pointers with the build 12340 addresses until bindGameFunctions() runs
 CommandExecutor::GameFunctions::p_Dostring CommandExecutor::GameFunctions::Dostring =
-    reinterpret_cast<p_Dostring>(0x819210);
+    reinterpret_cast<p_Dostring>(GameAddresses::get(GameAddress::LUA_DOSTRING));
 
 CommandExecutor::GameFunctions::p_GetText CommandExecutor::GameFunctions::GetText =
-    reinterpret_cast<p_GetText>(0x819D40);
+    reinterpret_cast<p_GetText>(GameAddresses::get(GameAddress::LUA_GETTEXT));
 
 CommandExecutor::GameFunctions::p_ClickToMove CommandExecutor::GameFunctions::CGPlayer_C__ClickToMove =
-    reinterpret_cast<p_ClickToMove>(0x00727400);
+    reinterpret_cast<p_ClickToMove>(GameAddresses::get(GameAddress::CLICK_TO_MOVE));
+
+void CommandExecutor::bindGameFunctions() {
+    using Functions = GameFunctions;
+    Functions::Dostring = reinterpret_cast<Functions::p_Dostring>(GameAddresses::get(GameAddress::LUA_DOSTRING));
+    Functions::GetText = reinterpret_cast<Functions::p_GetText>(GameAddresses::get(GameAddress::LUA_GETTEXT));
+    Functions::CGPlayer_C__ClickToMove =
+        reinterpret_cast<Functions::p_ClickToMove>(GameAddresses::get(GameAddress::CLICK_TO_MOVE));
+}
 
 bool CommandExecutor::executeLuaCode(const std::string& code, const std::string& scriptName) {
     if (code.empty()) {
@@ -20,15 +35,17 @@ bool CommandExecutor::executeLuaCode(const std::string& code, const std::string&
     }
 
     try {
-        LOG_DEBUG("CommandExecutor: Executing Lua code: " + code.substr(0, 100) + (code.length() > 100 ? "..." : ""));
+        LOG_DEBUG("CommandExecutor: Executing Lua code: {}{}", std::string_view(code).substr(0, 100),
+                  code.length() > 100 ? "..." : "");
+        TRACE_SCOPE("CommandExecutor::executeLuaCode", "bytes", code.size());
 
-        int result = GameFunctions::Dostring(code.c_str(), scriptName.c_str(), 0);
+        int result = runDostring(code, scriptName.empty() ? hashScriptName(kCodeScriptPrefix, code) : scriptName);
 
         if (result == 0) {
             LOG_DEBUG("CommandExecutor: Lua execution successful");
             return true;
         } else {
-            LOG_ERROR("CommandExecutor: Lua execution failed with code " + std::to_string(result));
+            LOG_ERROR("CommandExecutor: Lua execution failed with code {}", result);
             return false;
         }
     } catch (...) {
@@ -44,19 +61,77 @@ std::string CommandExecutor::readLuaVariable(const std::string& variableName) {
     }
 
     try {
-        LOG_DEBUG("CommandExecutor: Reading Lua variable '" + variableName + "'");
+        LOG_DEBUG("CommandExecutor: Reading Lua variable '{}'", variableName);
+        TRACE_SCOPE("CommandExecutor::readLuaVariable");
 
         char* result_ptr = GameFunctions::GetText(variableName.c_str(), nullptr, nullptr);
         std::string result = result_ptr ? result_ptr : "";
 
-        LOG_DEBUG("CommandExecutor: Variable '" + variableName + "' = '" + result + "'");
+        LOG_DEBUG("CommandExecutor: Variable '{}' = '{}'", variableName, result);
         return result;
     } catch (...) {
-        LOG_ERROR("CommandExecutor: Exception while reading variable '" + variableName + "'");
+        LOG_ERROR("CommandExecutor: Exception while reading variable '{}'", variableName);
         return "";
     }
 }
 
+bool CommandExecutor::evaluateLuaExpression(const std::string& expression, std::string& result,
+                                            const std::string& scriptName) {
+    if (expression.empty()) {
+        LOG_WARN("CommandExecutor: Empty Lua expression provided");
+        return false;
+    }
+
+    try {
+        TRACE_SCOPE("CommandExecutor::evaluateLuaExpression");
+        const std::string code = std::string(kEvalResultVariable) + " = tostring(" + expression + ")";
+        const std::string name = scriptName.empty() ? hashScriptName(kEvalScriptPrefix, expression) : scriptName;
+        if (runDostring(code, name) != 0) {
+            LOG_DEBUG("CommandExecutor: Lua expression evaluation failed: {}", expression);
+            return false;
+        }
+
+        char* result_ptr = GameFunctions::GetText(kEvalResultVariable, nullptr, nullptr);
+        result = result_ptr ? result_ptr : "";
+        return true;
+    } catch (...) {
+        LOG_ERROR("CommandExecutor: Exception while evaluating Lua expression");
+        return false;
+    }
+}
+
+bool CommandExecutor::evaluateLuaCondition(const std::string& condition, bool& result, const std::string& scriptName) {
+    std::string value;
+    if (!evaluateLuaExpression("not not (" + condition + ")", value,
+                               scriptName.empty() ? hashScriptName(kEvalScriptPrefix, condition) : scriptName)) {
+        return false;
+    }
+
+    result = value == "true";
+    return true;
+}
+
+bool CommandExecutor::readUnitPosition(const interfaces::IMemoryReader& memory, uintptr_t unitBaseAddress,
+                                       icecap::agent::v1::Position& position) {
+    if (unitBaseAddress == 0) {
+        LOG_ERROR("CommandExecutor: Invalid unit base address (0)");
+        return false;
+    }
+
+    // X, Y, Z are contiguous in the unit; one validated read, normally served from the reader's range cache
+    float pos[3] = {0.0f, 0.0f, 0.0f};
+    if (!memory.read(unitBaseAddress + UnitOffsets::kPosition, pos, sizeof(pos))) {
+        LOG_WARN("CommandExecutor: Failed to read unit position");
+        return false;
+    }
+
+    // The game stores (Y, X, Z) relative to the contract, mirroring executeClickToMove
+    position.set_x(pos[1]);
+    position.set_y(pos[0]);
+    position.set_z(pos[2]);
+    return true;
+}
+
 bool CommandExecutor::executeClickToMove(uintptr_t playerBaseAddress, const icecap::agent::v1::Position& position,
                                          icecap::agent::v1::ClickToMoveAction action, float precision) {
     if (playerBaseAddress == 0) {
@@ -65,17 +140,17 @@ bool CommandExecutor::executeClickToMove(uintptr_t playerBaseAddress, const icec
     }
 
     try {
+        TRACE_SCOPE("CommandExecutor::executeClickToMove");
         float pos[3] = {position.y(), position.x(), position.z()};
 
-        LOG_DEBUG("CommandExecutor: ClickToMove position: (" + std::to_string(pos[0]) + ", " + std::to_string(pos[1]) +
-                  ", " + std::to_string(pos[2]) + ")");
+        LOG_DEBUG("CommandExecutor: ClickToMove position: ({}, {}, {})", pos[0], pos[1], pos[2]);
 
         // Provide a non-null GUID buffer (32 bytes = 2x UInt128), zero-initialized
         unsigned char guidBuf[32] = {0};
         void* interactGuid = guidBuf;
 
         const int actionValue = static_cast<int>(action);
-        LOG_DEBUG("CommandExecutor: ClickToMove action: " + std::to_string(actionValue));
+        LOG_DEBUG("CommandExecutor: ClickToMove action: {}", actionValue);
 
         // Perform the call (ECX=this via __fastcall)
         bool result = GameFunctions::CGPlayer_C__ClickToMove(
@@ -94,4 +169,27 @@ bool CommandExecutor::executeClickToMove(uintptr_t playerBaseAddress, const icec
     }
 }
 
+std::string CommandExecutor::hashScriptName(const char* prefix, const std::string& content) {
+    uint32_t hash = 2166136261u;
+    for (const char c : content) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+
+    char hex[9];
+    std::snprintf(hex, sizeof(hex), "%08x", hash);
+    return prefix + std::string(hex);
+}
+
+int CommandExecutor::runDostring(const std::string& code, const std::string& scriptName) {
+    if (!m_observer) {
+        return GameFunctions::Dostring(code.c_str(), scriptName.c_str(), 0);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const int result = GameFunctions::Dostring(code.c_str(), scriptName.c_str(), 0);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    m_observer->onScriptExecuted(scriptName, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    return result;
+}
+
 } // namespace icecap::agent::core
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+#include <icecap/agent/core/CommandLatency.hpp>
+
+namespace icecap::agent::core {
+
+int64_t CommandTimeline::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    micros = std::min<uint64_t>(micros, UINT32_MAX);
+
+    m_buckets[bucketOf(micros)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (micros > max && !m_max.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Summary LatencyHistogram::summarize() const {
+    std::array<uint32_t, kBucketCount> counts;
+    uint64_t total = 0;
+    for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+        counts[bucket] = m_buckets[bucket].load(std::memory_order_relaxed);
+        total += counts[bucket];
+    }
+
+    Summary summary;
+    summary.count = total;
+    summary.sumMicros = m_sum.load(std::memory_order_relaxed);
+    summary.maxMicros = m_max.load(std::memory_order_relaxed);
+    if (total == 0) {
+        return summary;
+    }
+
+    // Smallest bucket bound covering the requested share of samples, never above the observed maximum
+    const auto percentile = [&](uint64_t perMille) {
+        const uint64_t rank = std::max<uint64_t>(1, (total * perMille + 999) / 1000);
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+            seen += counts[bucket];
+            if (seen >= rank) {
+                return std::min(upperBoundOf(bucket), summary.maxMicros);
+            }
+        }
+        return summary.maxMicros;
+    };
+
+    summary.p50Micros = percentile(500);
+    summary.p90Micros = percentile(900);
+    summary.p99Micros = percentile(990);
+    return summary;
+}
+
+size_t LatencyHistogram::bucketOf(uint64_t micros) {
+    if (micros < kSubBuckets) {
+        return static_cast<size_t>(micros);
+    }
+
+    // Keep the top kSubBucketBits + 1 significant bits: one group of kSubBuckets per power of two
+    const uint32_t width = static_cast<uint32_t>(std::bit_width(micros));
+    const uint64_t top = micros >> (width - kSubBucketBits - 1);
+    return static_cast<size_t>((width - kSubBucketBits) * kSubBuckets + top - kSubBuckets);
+}
+
+uint64_t LatencyHistogram::upperBoundOf(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+
+    const uint64_t group = bucket / kSubBuckets;
+    const uint64_t top = bucket % kSubBuckets + kSubBuckets;
+    return ((top + 1) << (group - 1)) - 1;
+}
+
+CommandLatencyRecorder::~CommandLatencyRecorder() {
+    for (auto& type : m_types) {
+        delete type.load(std::memory_order_relaxed);
+    }
+}
+
+void CommandLatencyRecorder::record(const CommandTimeline& timeline) {
+    if (!timeline.isActive() || timeline.commandType >= kMaxCommandTypes) {
+        return;
+    }
+
+    auto& slot = m_types[timeline.commandType];
+    Histograms* histograms = slot.load(std::memory_order_acquire);
+    if (histograms == nullptr) {
+        // First sample of this type; the loser of a racing allocation frees its copy
+        auto fresh = std::make_unique<Histograms>();
+        if (slot.compare_exchange_strong(histograms, fresh.get(), std::memory_order_acq_rel)) {
+            histograms = fresh.release();
+        }
+    }
+
+    size_t previous = 0;
+    for (size_t stage = 1; stage < kCommandStageCount; ++stage) {
+        if (timeline.micros[stage] == 0) {
+            continue;
+        }
+        const int64_t elapsed = timeline.micros[stage] - timeline.micros[previous];
+        (*histograms)[stage - 1].record(static_cast<uint64_t>(std::max<int64_t>(elapsed, 0)));
+        previous = stage;
+    }
+
+    const int64_t total = timeline.micros[previous] - timeline.micros[0];
+    (*histograms)[kTotalInterval].record(static_cast<uint64_t>(std::max<int64_t>(total, 0)));
+}
+
+void CommandLatencyRecorder::reset() {
+    for (auto& type : m_types) {
+        if (Histograms* histograms = type.load(std::memory_order_acquire)) {
+            for (auto& histogram : *histograms) {
+                histogram.reset();
+            }
+        }
+    }
+}
+
+const CommandLatencyRecorder::Histograms* CommandLatencyRecorder::find(uint32_t commandType) const {
+    if (commandType >= kMaxCommandTypes) {
+        return nullptr;
+    }
+    return m_types[commandType].load(std::memory_order_acquire);
+}
+
+const char* CommandLatencyRecorder::intervalName(size_t interval) {
+    static constexpr std::array<const char*, kIntervalCount> kNames = {
+        "framed", "parsed", "enqueued", "dequeued", "executed", "event_enqueued", "sent", "total",
+    };
+    return interval < kNames.size() ? kNames[interval] : "unknown";
+}
+
+} // namespace icecap::agent::core
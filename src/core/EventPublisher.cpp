@@ -1,3 +1,4 @@
+#include <cmath>
 #include <iomanip>
 #include <random>
 #include <sstream>
@@ -8,9 +9,13 @@ namespace icecap::agent::core {
 
 OutgoingMessage EventPublisher::createLuaVariableReadEvent(const IncomingMessage& originalCommand,
                                                            const std::string& result) {
+    return createLuaVariableReadEvent(originalCommand.operation_id(), result);
+}
+
+OutgoingMessage EventPublisher::createLuaVariableReadEvent(const std::string& operationId, const std::string& result) {
     OutgoingMessage event;
     event.set_id(generateEventId());
-    event.set_operation_id(originalCommand.operation_id());
+    event.set_operation_id(operationId);
     event.set_type(icecap::agent::v1::EVENT_TYPE_LUA_VARIABLE_READ);
 
     auto* payload = event.mutable_lua_variable_read_event_payload();
@@ -19,20 +24,461 @@ OutgoingMessage EventPublisher::createLuaVariableReadEvent(const IncomingMessage
     return event;
 }
 
+OutgoingMessage EventPublisher::createWatchValuesChangedEvent(const std::vector<WatchChange>& changes) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_WATCH_VALUES_CHANGED);
+
+    auto* payload = event.mutable_watch_values_changed_event_payload();
+    for (const auto& change : changes) {
+        auto* entry = payload->add_changes();
+        entry->set_subscription_id(change.subscriptionId);
+        entry->set_expression(change.expression);
+        entry->set_value(change.value);
+    }
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createPathProgressEvent(const PathProgress& progress) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(progress.operationId);
+
+    switch (progress.kind) {
+        case PathProgress::Kind::WAYPOINT_REACHED:
+            event.set_type(icecap::agent::v1::EVENT_TYPE_PATH_PROGRESS);
+            break;
+        case PathProgress::Kind::COMPLETED:
+            event.set_type(icecap::agent::v1::EVENT_TYPE_PATH_COMPLETED);
+            break;
+        case PathProgress::Kind::ABORTED:
+            event.set_type(icecap::agent::v1::EVENT_TYPE_PATH_ABORTED);
+            break;
+    }
+
+    auto* payload = event.mutable_path_progress_event_payload();
+    payload->set_waypoint_index(progress.waypointIndex);
+    payload->set_waypoint_count(progress.waypointCount);
+    *payload->mutable_position() = progress.position;
+    payload->set_reason(progress.reason);
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createStateMachineTransitionEvent(const StateTransition& transition) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(transition.machineId);
+    event.set_type(icecap::agent::v1::EVENT_TYPE_STATE_MACHINE_TRANSITION);
+
+    auto* payload = event.mutable_state_machine_transition_event_payload();
+    payload->set_from_state(transition.fromState);
+    payload->set_to_state(transition.toState);
+    payload->set_frame_number(transition.frameNumber);
+    payload->set_evaluation_time_us(transition.evaluationTimeUs);
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createStateMachineStatsEvent(const IncomingMessage& originalCommand,
+                                                             const StateMachineEngine& engine) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_STATE_MACHINE_STATS);
+
+    const auto& stats = engine.getStats();
+    auto* payload = event.mutable_state_machine_stats_event_payload();
+    payload->set_machine_count(static_cast<uint32_t>(engine.getMachineCount()));
+    payload->set_frame_budget_us(static_cast<uint32_t>(engine.getFrameBudget().count()));
+    payload->set_last_frame_cost_us(stats.lastFrameCostUs);
+    payload->set_max_frame_cost_us(stats.maxFrameCostUs);
+    payload->set_deferred_evaluations(stats.deferredEvaluations);
+    return event;
+}
+
+OutgoingMessage EventPublisher::createObjectSnapshotDeltaEvent(uint64_t frameNumber, const ObjectTable& table,
+                                                               const ObjectDelta& delta) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_OBJECT_SNAPSHOT_DELTA);
+
+    auto* payload = event.mutable_object_snapshot_delta_event_payload();
+    payload->set_frame_number(frameNumber);
+    payload->set_local_player_guid(table.localPlayerGuid);
+
+    for (const size_t row : delta.spawned) {
+        fillObjectState(payload->add_spawned(), table, row, ~0u);
+    }
+    for (const uint64_t guid : delta.despawned) {
+        payload->add_despawned(guid);
+    }
+    for (const auto& update : delta.updated) {
+        fillObjectState(payload->add_updated(), table, update.row, update.changedFields);
+    }
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createSpatialQueryResultEvent(const IncomingMessage& originalCommand,
+                                                              const ObjectTable& table,
+                                                              const std::vector<SpatialIndex::Neighbor>& neighbors) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_SPATIAL_QUERY_RESULT);
+
+    auto* payload = event.mutable_spatial_query_result_event_payload();
+    for (const auto& neighbor : neighbors) {
+        fillObjectState(payload->add_objects(), table, neighbor.row, ~0u);
+        payload->add_distances(std::sqrt(neighbor.distanceSquared));
+    }
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createGameStateEvent(const IncomingMessage& originalCommand, const GameState& state,
+                                                     const std::vector<size_t>& rows, uint64_t frameNumber,
+                                                     int64_t ageMicros) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_GAME_STATE);
+
+    auto* payload = event.mutable_game_state_event_payload();
+    payload->set_frame_number(frameNumber);
+    payload->set_age_micros(ageMicros);
+    if (state.objects) {
+        payload->set_local_player_guid(state.objects->localPlayerGuid);
+        for (const size_t row : rows) {
+            fillObjectState(payload->add_objects(), *state.objects, row, ~0u);
+        }
+    }
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createPositionHistoryEvent(const IncomingMessage& originalCommand, uint64_t guid,
+                                                           const std::vector<PositionSample>& samples) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_POSITION_HISTORY);
+
+    auto* payload = event.mutable_position_history_event_payload();
+    payload->set_guid(guid);
+    if (samples.empty()) {
+        return event;
+    }
+
+    const auto& first = samples.front();
+    payload->set_first_frame_number(first.frameNumber);
+    payload->set_first_timestamp_micros(first.timestampMicros);
+    payload->mutable_frame_deltas()->Reserve(static_cast<int>(samples.size()));
+    payload->mutable_time_deltas_micros()->Reserve(static_cast<int>(samples.size()));
+    payload->mutable_coordinates()->Reserve(static_cast<int>(samples.size() * 3));
+
+    // Packed repeated fields: one delta per sample, coordinates as flat (x, y, z) triples
+    for (const auto& sample : samples) {
+        payload->add_frame_deltas(static_cast<uint32_t>(sample.frameNumber - first.frameNumber));
+        payload->add_time_deltas_micros(static_cast<uint32_t>(sample.timestampMicros - first.timestampMicros));
+        payload->add_coordinates(sample.x);
+        payload->add_coordinates(sample.y);
+        payload->add_coordinates(sample.z);
+    }
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createMemoryReadResultEvent(const IncomingMessage& originalCommand, std::string data,
+                                                            std::string failedBitmap) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_MEMORY_READ_RESULT);
+
+    auto* payload = event.mutable_memory_read_result_event_payload();
+    payload->set_data(std::move(data));
+    payload->set_failed_bitmap(std::move(failedBitmap));
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createObjectQueryResultEvent(const IncomingMessage& originalCommand,
+                                                             const ObjectTable& table, const std::vector<size_t>& rows,
+                                                             uint32_t fields) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_OBJECT_QUERY_RESULT);
+
+    auto* payload = event.mutable_object_query_result_event_payload();
+    payload->set_scanned_count(static_cast<uint32_t>(table.size()));
+    for (const size_t row : rows) {
+        fillObjectState(payload->add_objects(), table, row, fields);
+    }
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createGameEvent(uint64_t frameNumber, const GameEventAggregate& aggregate) {
+    const GameEvent& gameEvent = aggregate.event;
+
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_GAME_EVENT);
+
+    auto* payload = event.mutable_game_event_payload();
+    payload->set_event_id(gameEvent.eventId);
+    payload->set_frame_number(frameNumber);
+    payload->set_count(aggregate.count);
+    payload->set_sum(aggregate.sum);
+    payload->set_window_start_frame(aggregate.windowStartFrame);
+    for (const auto& argument : gameEvent.arguments) {
+        auto* entry = payload->add_arguments();
+        switch (argument.kind) {
+            case GameEventArgument::Kind::INTEGER:
+                entry->set_int_value(argument.integer);
+                break;
+            case GameEventArgument::Kind::BOOLEAN:
+                entry->set_bool_value(argument.integer != 0);
+                break;
+            case GameEventArgument::Kind::NUMBER:
+                entry->set_number_value(argument.number);
+                break;
+            case GameEventArgument::Kind::STRING:
+                entry->set_string_value(argument.text);
+                break;
+            case GameEventArgument::Kind::UNREADABLE:
+                entry->set_unreadable(true);
+                break;
+        }
+    }
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createLatencyReportEvent(const IncomingMessage& originalCommand,
+                                                         const CommandLatencyRecorder& recorder) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_LATENCY_REPORT);
+
+    auto* payload = event.mutable_latency_report_event_payload();
+    for (uint32_t type = 0; type < CommandLatencyRecorder::kMaxCommandTypes; ++type) {
+        const auto* histograms = recorder.find(type);
+        if (!histograms) {
+            continue;
+        }
+
+        auto* command = payload->add_commands();
+        command->set_command_type(type);
+        for (size_t interval = 0; interval < CommandLatencyRecorder::kIntervalCount; ++interval) {
+            const auto summary = (*histograms)[interval].summarize();
+            if (summary.count == 0) {
+                continue;
+            }
+
+            auto* stage = command->add_stages();
+            stage->set_stage(CommandLatencyRecorder::intervalName(interval));
+            stage->set_count(summary.count);
+            stage->set_mean_us(static_cast<double>(summary.sumMicros) / static_cast<double>(summary.count));
+            stage->set_p50_us(summary.p50Micros);
+            stage->set_p90_us(summary.p90Micros);
+            stage->set_p99_us(summary.p99Micros);
+            stage->set_max_us(summary.maxMicros);
+        }
+    }
+
+    return event;
+}
+
+OutgoingMessage EventPublisher::createFrameTimingEvent(const FrameTimingSummary& summary) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_FRAME_TIMING);
+
+    auto* payload = event.mutable_frame_timing_event_payload();
+    payload->set_frame_number(summary.frameNumber);
+    payload->set_sample_count(summary.sampleCount);
+    payload->set_min_us(summary.minMicros);
+    payload->set_mean_us(summary.meanMicros);
+    payload->set_p99_us(summary.p99Micros);
+    payload->set_max_us(summary.maxMicros);
+    return event;
+}
+
+OutgoingMessage EventPublisher::createFrameTimingEvent(const IncomingMessage& originalCommand,
+                                                       const FrameTimingSummary& summary) {
+    OutgoingMessage event = createFrameTimingEvent(summary);
+    event.set_operation_id(originalCommand.operation_id());
+    return event;
+}
+
+OutgoingMessage EventPublisher::createSlowFrameEvent(const SlowFrame& slowFrame) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_SLOW_FRAMES);
+    fillSlowFrame(event.mutable_slow_frames_event_payload()->add_frames(), slowFrame);
+    return event;
+}
+
+OutgoingMessage EventPublisher::createSlowFrameHistoryEvent(const IncomingMessage& originalCommand,
+                                                            const std::deque<SlowFrame>& history) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_SLOW_FRAMES);
+
+    auto* payload = event.mutable_slow_frames_event_payload();
+    for (const auto& slowFrame : history) {
+        fillSlowFrame(payload->add_frames(), slowFrame);
+    }
+    return event;
+}
+
+OutgoingMessage EventPublisher::createScriptProfileEvent(const IncomingMessage& originalCommand,
+                                                         const std::vector<ScriptProfile>& profiles,
+                                                         uint64_t scriptCount) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_SCRIPT_PROFILE);
+
+    auto* payload = event.mutable_script_profile_event_payload();
+    payload->set_script_count(scriptCount);
+    for (const auto& profile : profiles) {
+        auto* entry = payload->add_scripts();
+        entry->set_name(profile.name);
+        entry->set_count(profile.count);
+        entry->set_total_us(profile.totalMicros);
+        entry->set_max_us(profile.maxMicros);
+        entry->set_p99_us(profile.p99Micros);
+    }
+    return event;
+}
+
+OutgoingMessage EventPublisher::createHookStatsEvent(const IncomingMessage& originalCommand,
+                                                     const std::vector<interfaces::HookStats>& hooks,
+                                                     double cyclesPerSecond) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_HOOK_STATS);
+
+    auto* payload = event.mutable_hook_stats_event_payload();
+    payload->set_cycles_per_second(cyclesPerSecond);
+    for (const auto& hook : hooks) {
+        auto* entry = payload->add_hooks();
+        entry->set_name(hook.name);
+        entry->set_installed(hook.installed);
+        entry->set_invocations(hook.invocations);
+        entry->set_inclusive_cycles(hook.inclusiveCycles);
+        entry->set_exclusive_cycles(hook.exclusiveCycles);
+    }
+    return event;
+}
+
+OutgoingMessage EventPublisher::createTraceDumpedEvent(const IncomingMessage& originalCommand, const std::string& path,
+                                                       uint64_t spanCount) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_TRACE_DUMPED);
+
+    auto* payload = event.mutable_trace_dumped_event_payload();
+    payload->set_path(path);
+    payload->set_span_count(spanCount);
+    return event;
+}
+
+OutgoingMessage EventPublisher::createPongEvent(const IncomingMessage& originalCommand, int64_t receivedMicros,
+                                                int64_t sentMicros) {
+    OutgoingMessage event;
+    event.set_id(generateEventId());
+    event.set_operation_id(originalCommand.operation_id());
+    event.set_type(icecap::agent::v1::EVENT_TYPE_PONG);
+
+    auto* payload = event.mutable_pong_event_payload();
+    payload->set_client_send_us(originalCommand.ping_payload().client_send_us());
+    payload->set_agent_receive_us(receivedMicros);
+    payload->set_agent_send_us(sentMicros);
+    return event;
+}
+
+void EventPublisher::fillSlowFrame(icecap::agent::v1::SlowFrame* message, const SlowFrame& slowFrame) {
+    message->set_frame_number(slowFrame.frameNumber);
+    message->set_agent_us(static_cast<uint64_t>(slowFrame.agentMicros));
+    message->set_threshold_us(slowFrame.thresholdMicros);
+    for (const auto& command : slowFrame.commands) {
+        auto* entry = message->add_commands();
+        entry->set_id(command.id);
+        entry->set_type(command.type);
+        entry->set_elapsed_us(static_cast<uint64_t>(command.elapsedMicros));
+    }
+    for (const auto& script : slowFrame.scripts) {
+        auto* entry = message->add_scripts();
+        entry->set_name(script.name);
+        entry->set_count(script.count);
+        entry->set_elapsed_us(static_cast<uint64_t>(script.elapsedMicros));
+    }
+}
+
+void EventPublisher::fillObjectState(icecap::agent::v1::ObjectState* state, const ObjectTable& table, size_t row,
+                                     uint32_t fields) {
+    state->set_guid(table.guid[row]);
+    state->set_type(static_cast<uint32_t>(table.type[row]));
+    state->set_changed_fields(fields);
+    if (fields & OBJECT_FIELD_BASE_ADDRESS) {
+        state->set_base_address(table.baseAddress[row]);
+    }
+    if (fields & OBJECT_FIELD_POSITION) {
+        auto* position = state->mutable_position();
+        position->set_x(table.x[row]);
+        position->set_y(table.y[row]);
+        position->set_z(table.z[row]);
+    }
+    if (fields & OBJECT_FIELD_FACING) {
+        state->set_facing(table.facing[row]);
+    }
+    if (fields & OBJECT_FIELD_HEALTH) {
+        state->set_health(table.health[row]);
+    }
+    if (fields & OBJECT_FIELD_MAX_HEALTH) {
+        state->set_max_health(table.maxHealth[row]);
+    }
+    if (fields & OBJECT_FIELD_LEVEL) {
+        state->set_level(table.level[row]);
+    }
+    if (fields & OBJECT_FIELD_TARGET) {
+        state->set_target_guid(table.targetGuid[row]);
+    }
+}
+
 OutgoingMessage EventPublisher::createErrorEvent(const IncomingMessage& originalCommand,
                                                  const std::string& errorMessage) {
+    return createErrorEvent(originalCommand.operation_id(), errorMessage);
+}
+
+OutgoingMessage EventPublisher::createErrorEvent(const std::string& operationId, const std::string& errorMessage) {
     OutgoingMessage event;
     event.set_id(generateEventId());
-    event.set_operation_id(originalCommand.operation_id());
+    event.set_operation_id(operationId);
     event.set_type(icecap::agent::v1::EVENT_TYPE_OPERATION_FAILED);
 
     return event;
 }
 
 OutgoingMessage EventPublisher::createSuccessEvent(const IncomingMessage& originalCommand) {
+    return createSuccessEvent(originalCommand.operation_id());
+}
+
+OutgoingMessage EventPublisher::createSuccessEvent(const std::string& operationId) {
     OutgoingMessage event;
     event.set_id(generateEventId());
-    event.set_operation_id(originalCommand.operation_id());
+    event.set_operation_id(operationId);
     event.set_type(icecap::agent::v1::EVENT_TYPE_OPERATION_SUCCEEDED);
 
     return event;
@@ -0,0 +1,78 @@
+#include <icecap/agent/core/FrameStallWatchdog.hpp>
+
+namespace icecap::agent::core {
+
+void FrameStallWatchdog::setThreshold(uint32_t micros) {
+    m_thresholdMicros = micros != 0 ? micros : kDefaultThresholdMicros;
+}
+
+void FrameStallWatchdog::beginFrame(uint64_t frameNumber, int64_t nowMicros) {
+    m_inFrame = true;
+    m_frameNumber = frameNumber;
+    m_frameStartMicros = nowMicros;
+    m_commands.clear();
+    m_scriptCount = 0;
+}
+
+void FrameStallWatchdog::noteCommand(const std::string& id, uint32_t type, int64_t elapsedMicros) {
+    if (m_inFrame) {
+        m_commands.push_back({id, type, elapsedMicros});
+    }
+}
+
+void FrameStallWatchdog::onScriptExecuted(const std::string& scriptName, int64_t elapsedMicros) {
+    if (!m_inFrame) {
+        return;
+    }
+
+    for (size_t i = 0; i < m_scriptCount; ++i) {
+        if (m_scripts[i].name == scriptName) {
+            ++m_scripts[i].count;
+            m_scripts[i].elapsedMicros += elapsedMicros;
+            return;
+        }
+    }
+
+    // Real names fill all but the last slot, which is reserved for kOtherScripts and collects every name past them
+    const bool full = m_scriptCount >= kMaxScriptsPerFrame - 1;
+    if (full && m_scriptCount == kMaxScriptsPerFrame) {
+        auto& other = m_scripts[kMaxScriptsPerFrame - 1];
+        ++other.count;
+        other.elapsedMicros += elapsedMicros;
+        return;
+    }
+
+    if (m_scriptCount == m_scripts.size()) {
+        m_scripts.emplace_back();
+    }
+    auto& script = m_scripts[m_scriptCount++];
+    script.name = full ? kOtherScripts : scriptName;
+    script.count = 1;
+    script.elapsedMicros = elapsedMicros;
+}
+
+bool FrameStallWatchdog::endFrame(int64_t nowMicros, SlowFrame& slowFrame) {
+    if (!m_inFrame) {
+        return false;
+    }
+    m_inFrame = false;
+
+    const int64_t agentMicros = nowMicros - m_frameStartMicros;
+    if (agentMicros <= static_cast<int64_t>(m_thresholdMicros)) {
+        return false;
+    }
+
+    slowFrame.frameNumber = m_frameNumber;
+    slowFrame.agentMicros = agentMicros;
+    slowFrame.thresholdMicros = m_thresholdMicros;
+    slowFrame.commands = m_commands;
+    slowFrame.scripts.assign(m_scripts.begin(), m_scripts.begin() + static_cast<std::ptrdiff_t>(m_scriptCount));
+
+    if (m_history.size() == kMaxHistory) {
+        m_history.pop_front();
+    }
+    m_history.push_back(slowFrame);
+    return true;
+}
+
+} // namespace icecap::agent::core
@@ -0,0 +1,61 @@
+#include <algorithm>
+
+#include <icecap/agent/core/FrameTiming.hpp>
+
+namespace icecap::agent::core {
+
+void FrameTimingStats::onFrame(uint64_t frameNumber, int64_t nowMicros) {
+    if (m_lastFrameMicros != 0) {
+        const int64_t interval = std::clamp<int64_t>(nowMicros - m_lastFrameMicros, 0, UINT32_MAX);
+        m_intervals[m_intervalCount % kWindowFrames] = static_cast<uint32_t>(interval);
+        ++m_intervalCount;
+    }
+    m_lastFrameMicros = nowMicros;
+    m_currentFrame.store(frameNumber, std::memory_order_relaxed);
+}
+
+FrameTimingSummary FrameTimingStats::summarize() const {
+    FrameTimingSummary summary;
+    summary.frameNumber = getCurrentFrame();
+
+    const size_t count = std::min(m_intervalCount, kWindowFrames);
+    if (count == 0) {
+        return summary;
+    }
+
+    std::array<uint32_t, kWindowFrames> window;
+    std::copy_n(m_intervals.begin(), count, window.begin());
+    const auto begin = window.begin();
+    const auto end = window.begin() + static_cast<std::ptrdiff_t>(count);
+
+    uint64_t total = 0;
+    for (auto it = begin; it != end; ++it) {
+        total += *it;
+    }
+
+    // Nearest-rank 99th percentile
+    const size_t rank = (count * 99 + 99) / 100;
+    std::nth_element(begin, begin + static_cast<std::ptrdiff_t>(rank - 1), end);
+
+    summary.sampleCount = static_cast<uint32_t>(count);
+    summary.meanMicros = static_cast<uint32_t>(total / count);
+    summary.p99Micros = window[rank - 1];
+    summary.minMicros = *std::min_element(begin, end);
+    summary.maxMicros = *std::max_element(begin, end);
+    return summary;
+}
+
+void FrameTimingStats::setPublishInterval(uint32_t intervalFrames) {
+    m_publishIntervalFrames = intervalFrames;
+    m_nextPublishFrame = getCurrentFrame() + intervalFrames;
+}
+
+bool FrameTimingStats::isPublishDue(uint64_t frameNumber) {
+    if (m_publishIntervalFrames == 0 || frameNumber < m_nextPublishFrame) {
+        return false;
+    }
+    m_nextPublishFrame = frameNumber + m_publishIntervalFrames;
+    return true;
+}
+
+} // namespace icecap::agent::core
@@ -0,0 +1,239 @@
+#include <windows.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <icecap/agent/core/GameAddresses.hpp>
+#include <icecap/agent/core/SignatureScanner.hpp>
+#include <icecap/agent/logging.hpp>
+
+namespace icecap::agent::core {
+
+namespace {
+
+using Resolve = GameAddressResolver::Resolve;
+
+// Signatures and addresses for build 12340, in GameAddress order
+constexpr std::array<GameAddressResolver::Target, GameAddresses::kCount> kTargets = {{
+    {GameAddress::LUA_DOSTRING, "FrameScript_Execute",
+     "55 8B EC 51 83 05 ?? ?? ?? ?? 01 A1 ?? ?? ?? ?? 89 45 FC 74 ?? 83 3D ?? ?? ?? ?? 00", 0, Resolve::DIRECT,
+     0x00819210},
+    {GameAddress::LUA_GETTEXT, "FrameScript_GetText", "55 8B EC 81 EC ?? ?? ?? ?? 8B 0D ?? ?? ?? ?? 53 56 57 6A 00",
+     0, Resolve::DIRECT, 0x00819D40},
+    {GameAddress::CLICK_TO_MOVE, "CGPlayer_C__ClickToMove", "55 8B EC 83 EC ?? 53 56 8B F1 8B 46 ?? 57 8B 7D 08", 0,
+     Resolve::DIRECT, 0x00727400},
+    {GameAddress::SIGNAL_EVENT, "FrameScript__SignalEvent", "55 8B EC 81 EC ?? ?? ?? ?? 53 56 57 8B 7D 08 81 FF", 0,
+     Resolve::DIRECT, 0x0081B530},
+    {GameAddress::GX_DEVICE, "g_theGxDevicePtr", "8B 0D ?? ?? ?? ?? 8B 81 7C 39 00 00", 2, Resolve::ABSOLUTE,
+     0x00C5DF88},
+}};
+
+static_assert(GameAddresses::kCount == 5, "g_addresses lists one entry per target");
+std::atomic<uintptr_t> g_addresses[GameAddresses::kCount] = {
+    kTargets[0].build12340, kTargets[1].build12340, kTargets[2].build12340,
+    kTargets[3].build12340, kTargets[4].build12340,
+};
+
+constexpr const char* kCacheMagic = "icecap-addresses";
+constexpr int kCacheVersion = 2; // 2: operand targets accept repeated matches that agree
+
+// Matches examined per operand target; every site loading the same global is one match
+constexpr size_t kMaxOperandMatches = 64;
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 0xCBF29CE484222325ull) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+struct Section {
+    uintptr_t begin;
+    size_t size;
+};
+
+// Apply a target's resolution rule to a match
+uintptr_t decode(const GameAddressResolver::Target& target, uintptr_t match) {
+    const uintptr_t operand = match + static_cast<intptr_t>(target.offset);
+    switch (target.resolve) {
+        case Resolve::ABSOLUTE:
+            return *reinterpret_cast<const uint32_t*>(operand);
+        case Resolve::RELATIVE:
+            return operand + 4 + static_cast<intptr_t>(*reinterpret_cast<const int32_t*>(operand));
+        case Resolve::DIRECT:
+            break;
+    }
+    return operand;
+}
+
+// Address of `target` across `sections`, or 0. A function (DIRECT) must match exactly once. An operand target
+// matches at every site that loads the global, so it resolves when all of its matches decode to the same address.
+uintptr_t scan(const GameAddressResolver::Target& target, const std::vector<Section>& sections) {
+    const auto signature = Signature::parse(target.pattern);
+    if (!signature) {
+        LOG_ERROR("GameAddressResolver: Malformed signature for {}", target.name);
+        return 0;
+    }
+
+    // The build 12340 location is checked first, so the supported build never scans for functions
+    const uintptr_t expected = target.resolve == Resolve::DIRECT ? target.build12340 : 0;
+    for (const auto& section : sections) {
+        const auto* data = reinterpret_cast<const uint8_t*>(section.begin);
+        if (expected >= section.begin && expected < section.begin + section.size &&
+            SignatureScanner::matchesAt(data, section.size, *signature, expected - section.begin)) {
+            return expected;
+        }
+    }
+
+    const size_t limit = target.resolve == Resolve::DIRECT ? 2 : kMaxOperandMatches + 1;
+    uintptr_t address = 0;
+    size_t matches = 0;
+    bool agree = true;
+    for (const auto& section : sections) {
+        const auto* data = reinterpret_cast<const uint8_t*>(section.begin);
+        size_t position = SignatureScanner::find(data, section.size, *signature);
+        while (position != SignatureScanner::kNotFound && matches < limit) {
+            const uintptr_t decoded = decode(target, section.begin + position);
+            agree &= matches == 0 || decoded == address;
+            address = decoded;
+            ++matches;
+            position = SignatureScanner::find(data, section.size, *signature, position + 1);
+        }
+    }
+
+    const bool resolved = target.resolve == Resolve::DIRECT ? matches == 1 : matches != 0 && matches < limit && agree;
+    if (!resolved) {
+        LOG_WARN("GameAddressResolver: Signature for {}{}, keeping the build 12340 address", target.name,
+                 (matches == 0 ? " not found" : " is ambiguous"));
+        return 0;
+    }
+    if (matches > 1) {
+        LOG_DEBUG("GameAddressResolver: {} matched at {} sites that agree", target.name, matches);
+    }
+    return address;
+}
+
+} // namespace
+
+uintptr_t GameAddresses::get(GameAddress id) {
+    return g_addresses[static_cast<size_t>(id)].load(std::memory_order_relaxed);
+}
+
+void GameAddresses::set(GameAddress id, uintptr_t address) {
+    g_addresses[static_cast<size_t>(id)].store(address, std::memory_order_relaxed);
+}
+
+const std::array<GameAddressResolver::Target, GameAddresses::kCount>& GameAddressResolver::targets() {
+    return kTargets;
+}
+
+void GameAddressResolver::resolve(uintptr_t moduleBase, const std::string& cachePath) {
+    const auto* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(moduleBase);
+    if (moduleBase == 0 || dos->e_magic != IMAGE_DOS_SIGNATURE) {
+        LOG_ERROR("GameAddressResolver: Game module has no DOS header, keeping build 12340 addresses");
+        return;
+    }
+    const auto* nt = reinterpret_cast<const IMAGE_NT_HEADERS32*>(moduleBase + dos->e_lfanew);
+    if (nt->Signature != IMAGE_NT_SIGNATURE) {
+        LOG_ERROR("GameAddressResolver: Game module has no PE header, keeping build 12340 addresses");
+        return;
+    }
+
+    const uint64_t hash = moduleHash(reinterpret_cast<const uint8_t*>(moduleBase), nt->OptionalHeader.SizeOfHeaders);
+
+    Offsets offsets{};
+    std::ifstream cacheIn(cachePath);
+    std::stringstream cached;
+    cached << cacheIn.rdbuf();
+
+    if (cacheIn && parseCache(cached.str(), hash, offsets)) {
+        LOG_INFO("GameAddressResolver: Loaded game addresses from {}", cachePath);
+    } else {
+        std::vector<Section> sections;
+        const auto* section = IMAGE_FIRST_SECTION(nt);
+        for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+            if (section->Characteristics & IMAGE_SCN_MEM_EXECUTE) {
+                sections.push_back({moduleBase + section->VirtualAddress, section->Misc.VirtualSize});
+            }
+        }
+
+        for (const auto& target : kTargets) {
+            const uintptr_t address = scan(target, sections);
+            offsets[static_cast<size_t>(target.id)] =
+                address > moduleBase ? static_cast<uint32_t>(address - moduleBase) : 0;
+        }
+
+        std::ofstream cacheOut(cachePath, std::ios::trunc);
+        cacheOut << serializeCache(hash, offsets);
+        if (!cacheOut) {
+            LOG_WARN("GameAddressResolver: Failed to write address cache {}", cachePath);
+        }
+        LOG_INFO("GameAddressResolver: Scanned {} code sections for game addresses", sections.size());
+    }
+
+    for (const auto& target : kTargets) {
+        const uint32_t offset = offsets[static_cast<size_t>(target.id)];
+        const uintptr_t address = offset != 0 ? moduleBase + offset : target.build12340;
+        GameAddresses::set(target.id, address);
+
+        char hex[16];
+        std::snprintf(hex, sizeof(hex), "0x%08X", static_cast<unsigned>(address));
+        LOG_DEBUG("GameAddressResolver: {} at {}", target.name, hex);
+    }
+}
+
+uint64_t GameAddressResolver::moduleHash(const uint8_t* headers, size_t size) {
+    uint64_t hash = fnv1a(headers, size);
+    for (const auto& target : kTargets) {
+        hash = fnv1a(target.pattern, std::char_traits<char>::length(target.pattern), hash);
+        hash = fnv1a(&target.offset, sizeof(target.offset), hash);
+        hash = fnv1a(&target.resolve, sizeof(target.resolve), hash);
+    }
+    return hash;
+}
+
+std::string GameAddressResolver::serializeCache(uint64_t hash, const Offsets& offsets) {
+    std::ostringstream out;
+    out << kCacheMagic << ' ' << kCacheVersion << ' ' << std::hex << hash << '\n';
+    for (const auto& target : kTargets) {
+        out << target.name << ' ' << offsets[static_cast<size_t>(target.id)] << '\n';
+    }
+    return out.str();
+}
+
+bool GameAddressResolver::parseCache(const std::string& text, uint64_t hash, Offsets& offsets) {
+    std::istringstream in(text);
+
+    std::string magic;
+    int version = 0;
+    uint64_t cachedHash = 0;
+    if (!(in >> magic >> version >> std::hex >> cachedHash) || magic != kCacheMagic || version != kCacheVersion ||
+        cachedHash != hash) {
+        return false;
+    }
+
+    std::array<bool, GameAddresses::kCount> seen{};
+    std::string name;
+    uint32_t offset = 0;
+    while (in >> name >> offset) {
+        for (const auto& target : kTargets) {
+            if (name == target.name) {
+                offsets[static_cast<size_t>(target.id)] = offset;
+                seen[static_cast<size_t>(target.id)] = true;
+            }
+        }
+    }
+
+    for (const bool found : seen) {
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace icecap::agent::core
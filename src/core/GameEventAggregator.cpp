@@ -0,0 +1,195 @@
+#include <icecap/agent/core/GameEventAggregator.hpp>
+
+namespace icecap::agent::core {
+
+bool GameEventAggregator::setPolicy(uint32_t eventId, const Policy& policy) {
+    if (eventId >= GameEventStream::kMaxEventId || policy.sampleEvery == 0) {
+        return false;
+    }
+    if (policy.windowFrames != 0 && policy.windowMs != 0) {
+        return false;
+    }
+    if (m_windows.size() >= kMaxPolicies && !m_windows.contains(eventId)) {
+        return false;
+    }
+
+    Window& window = m_windows[eventId];
+    window = Window{};
+    window.policy = policy;
+    return true;
+}
+
+bool GameEventAggregator::removePolicy(uint32_t eventId) {
+    const auto it = m_windows.find(eventId);
+    if (it == m_windows.end()) {
+        return false;
+    }
+    if (it->second.open) {
+        flush(it->second, m_removed);
+    }
+    m_windows.erase(it);
+    return true;
+}
+
+void GameEventAggregator::clear() {
+    m_windows.clear();
+    m_removed.clear();
+}
+
+void GameEventAggregator::discardPending() {
+    m_removed.clear();
+    for (auto& [eventId, window] : m_windows) {
+        window.open = false;
+        window.groups.clear();
+        window.groupIndex.clear();
+    }
+}
+
+void GameEventAggregator::process(uint64_t frameNumber, uint64_t nowMs, std::vector<GameEvent>& events,
+                                  std::vector<GameEventAggregate>& output) {
+    // Windows cut short by removePolicy() go out before anything folded or passed through this frame
+    for (auto& aggregate : m_removed) {
+        output.push_back(std::move(aggregate));
+    }
+    m_removed.clear();
+
+    for (auto& event : events) {
+        const auto it = m_windows.find(event.eventId);
+        if (it == m_windows.end()) {
+            GameEventAggregate passThrough;
+            passThrough.event = std::move(event);
+            passThrough.windowStartFrame = frameNumber;
+            output.push_back(std::move(passThrough));
+            continue;
+        }
+        fold(it->second, frameNumber, nowMs, event, output);
+    }
+
+    for (auto& [eventId, window] : m_windows) {
+        if (window.open && isDue(window, frameNumber, nowMs)) {
+            flush(window, output);
+        }
+    }
+}
+
+std::string GameEventAggregator::keyOf(const GameEvent& event, uint32_t keyArgument) {
+    if (keyArgument == 0 || keyArgument > event.arguments.size()) {
+        return {};
+    }
+
+    const auto& argument = event.arguments[keyArgument - 1];
+    switch (argument.kind) {
+        case GameEventArgument::Kind::STRING:
+            return argument.text;
+        case GameEventArgument::Kind::NUMBER:
+            return std::to_string(argument.number);
+        case GameEventArgument::Kind::UNREADABLE:
+            return kUnreadableKey;
+        case GameEventArgument::Kind::INTEGER:
+        case GameEventArgument::Kind::BOOLEAN:
+            break;
+    }
+    return std::to_string(argument.integer);
+}
+
+double GameEventAggregator::valueOf(const GameEvent& event, uint32_t valueArgument) {
+    if (valueArgument == 0 || valueArgument > event.arguments.size()) {
+        return 0.0;
+    }
+
+    const auto& argument = event.arguments[valueArgument - 1];
+    switch (argument.kind) {
+        case GameEventArgument::Kind::NUMBER:
+            return argument.number;
+        case GameEventArgument::Kind::INTEGER:
+        case GameEventArgument::Kind::BOOLEAN:
+            return static_cast<double>(argument.integer);
+        case GameEventArgument::Kind::STRING:
+        case GameEventArgument::Kind::UNREADABLE:
+            break;
+    }
+    return 0.0;
+}
+
+void GameEventAggregator::fold(Window& window, uint64_t frameNumber, uint64_t nowMs, GameEvent& event,
+                               std::vector<GameEventAggregate>& output) {
+    const Policy& policy = window.policy;
+
+    if (policy.mode == Mode::SAMPLE) {
+        // The first event of every run of sampleEvery is kept and stands for the whole run
+        if (window.sampleCounter++ % policy.sampleEvery != 0) {
+            return;
+        }
+    }
+
+    if (!window.open) {
+        openWindow(window, frameNumber, nowMs);
+    }
+
+    if (policy.mode == Mode::SAMPLE) {
+        if (window.groups.size() >= kMaxGroupsPerWindow) {
+            flush(window, output);
+            openWindow(window, frameNumber, nowMs);
+        }
+        GameEventAggregate sampled;
+        sampled.event = std::move(event);
+        sampled.count = policy.sampleEvery;
+        sampled.windowStartFrame = window.startFrame;
+        window.groups.push_back(std::move(sampled));
+        return;
+    }
+
+    std::string key = keyOf(event, policy.keyArgument);
+    auto it = window.groupIndex.find(key);
+    if (it == window.groupIndex.end()) {
+        if (window.groups.size() >= kMaxGroupsPerWindow) {
+            flush(window, output);
+            openWindow(window, frameNumber, nowMs);
+        }
+        it = window.groupIndex.emplace(std::move(key), window.groups.size()).first;
+        window.groups.emplace_back();
+        window.groups.back().count = 0;
+        window.groups.back().windowStartFrame = window.startFrame;
+    }
+
+    GameEventAggregate& group = window.groups[it->second];
+    ++group.count;
+    group.sum += valueOf(event, policy.valueArgument);
+
+    if (policy.mode == Mode::LATEST) {
+        group.event = std::move(event);
+    } else if (group.count == 1) {
+        // SUM reports the totals against the key alone
+        group.event.eventId = event.eventId;
+        if (policy.keyArgument != 0 && policy.keyArgument <= event.arguments.size()) {
+            group.event.arguments.push_back(std::move(event.arguments[policy.keyArgument - 1]));
+        }
+    }
+}
+
+void GameEventAggregator::openWindow(Window& window, uint64_t frameNumber, uint64_t nowMs) {
+    window.open = true;
+    window.startFrame = frameNumber;
+    window.startMs = nowMs;
+}
+
+bool GameEventAggregator::isDue(const Window& window, uint64_t frameNumber, uint64_t nowMs) {
+    if (window.policy.windowMs != 0) {
+        return nowMs - window.startMs >= window.policy.windowMs;
+    }
+
+    // A window of N frames covers the frame it opened on and the N - 1 after it
+    const uint64_t frames = window.policy.windowFrames != 0 ? window.policy.windowFrames : 1;
+    return frameNumber - window.startFrame + 1 >= frames;
+}
+
+void GameEventAggregator::flush(Window& window, std::vector<GameEventAggregate>& output) {
+    for (auto& group : window.groups) {
+        output.push_back(std::move(group));
+    }
+    window.groups.clear();
+    window.groupIndex.clear();
+    window.open = false;
+}
+
+} // namespace icecap::agent::core
@@ -0,0 +1,51 @@
+#include <icecap/agent/core/GameEventStream.hpp>
+
+namespace icecap::agent::core {
+
+bool GameEventStream::subscribe(uint32_t eventId) {
+    if (eventId >= kMaxEventId) {
+        return false;
+    }
+
+    const uint64_t bit = 1ull << (eventId % 64);
+    if ((m_subscriptions[eventId / 64].fetch_or(bit, std::memory_order_relaxed) & bit) == 0) {
+        m_subscriptionCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool GameEventStream::unsubscribe(uint32_t eventId) {
+    if (eventId >= kMaxEventId) {
+        return false;
+    }
+
+    const uint64_t bit = 1ull << (eventId % 64);
+    if ((m_subscriptions[eventId / 64].fetch_and(~bit, std::memory_order_relaxed) & bit) != 0) {
+        m_subscriptionCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void GameEventStream::unsubscribeAll() {
+    for (auto& word : m_subscriptions) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    m_subscriptionCount.store(0, std::memory_order_relaxed);
+}
+
+void GameEventStream::push(GameEvent event) {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    if (m_pending.size() >= kMaxPendingEvents) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_pending.push_back(std::move(event));
+}
+
+void GameEventStream::drain(std::vector<GameEvent>& events) {
+    events.clear();
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    events.swap(m_pending);
+}
+
+} // namespace icecap::agent::core
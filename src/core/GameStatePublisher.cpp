@@ -0,0 +1,48 @@
+#include <chrono>
+
+#include <icecap/agent/core/GameStatePublisher.hpp>
+
+namespace icecap::agent::core {
+
+void GameStatePublisher::publish(uint64_t frameNumber, const ObjectSnapshotEngine& objects) {
+    // Only a frame in which the engine walked the object manager tells us anything new
+    if (objects.getCaptureFrame() != frameNumber) {
+        return;
+    }
+
+    const int64_t now = nowMicros();
+    if (!m_current.load(std::memory_order_relaxed) || objects.getVersion() != m_lastObjectsVersion) {
+        // Readers may still hold the previous table, so a changed snapshot is copied into a new state
+        auto state = std::make_shared<GameState>();
+        state->frameNumber = frameNumber;
+        state->publishedAtMicros = now;
+        state->objects = std::make_shared<const ObjectTable>(objects.getTable());
+        state->objectsVersion = objects.getVersion();
+        m_lastObjectsVersion = state->objectsVersion;
+
+        m_current.store(std::move(state), std::memory_order_release);
+    }
+
+    // Confirm after publishing, so a reader that sees this confirmation also sees the state it confirms
+    m_confirmedAtMicros.store(now, std::memory_order_relaxed);
+    m_confirmedFrame.store(frameNumber, std::memory_order_release);
+}
+
+std::shared_ptr<const GameState> GameStatePublisher::acquire() const {
+    return m_current.load(std::memory_order_acquire);
+}
+
+GameStateFreshness GameStatePublisher::getFreshness() const {
+    GameStateFreshness freshness;
+    freshness.frameNumber = m_confirmedFrame.load(std::memory_order_acquire);
+    freshness.confirmedAtMicros = m_confirmedAtMicros.load(std::memory_order_relaxed);
+    return freshness;
+}
+
+int64_t GameStatePublisher::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace icecap::agent::core
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cstring>
+
+#include <icecap/agent/core/MemoryGather.hpp>
+
+namespace icecap::agent::core {
+
+std::string MemoryGather::validate(const std::vector<GatherRequest>& requests) {
+    if (requests.empty()) {
+        return "No memory regions requested";
+    }
+    if (requests.size() > kMaxRequests) {
+        return "Too many memory regions (max " + std::to_string(kMaxRequests) + ")";
+    }
+
+    size_t total = 0;
+    for (const auto& request : requests) {
+        if (request.length == 0 || request.length > kMaxRequestLength) {
+            return "Memory region length must be between 1 and " + std::to_string(kMaxRequestLength);
+        }
+        // Truncating would silently read an unrelated low address on the 32-bit agent
+        if (request.address > UINTPTR_MAX) {
+            return "Memory region address " + std::to_string(request.address) + " is outside the address space";
+        }
+        if (request.offsets.size() > kMaxChainDepth) {
+            return "Pointer chain too deep (max " + std::to_string(kMaxChainDepth) + ")";
+        }
+        total += request.length;
+    }
+    if (total > kMaxTotalLength) {
+        return "Total read size exceeds " + std::to_string(kMaxTotalLength) + " bytes";
+    }
+    return {};
+}
+
+void MemoryGather::gather(const interfaces::IMemoryReader& memory, const std::vector<GatherRequest>& requests,
+                          std::string& data, std::string& failedBitmap) {
+    m_lastReadCount = 0;
+    m_regions.clear();
+
+    size_t total = 0;
+    for (const auto& request : requests) {
+        total += request.length;
+    }
+    data.assign(total, '\0');
+    failedBitmap.assign((requests.size() + 7) / 8, '\0');
+
+    const auto markFailed = [&failedBitmap](size_t index) {
+        failedBitmap[index / 8] = static_cast<char>(failedBitmap[index / 8] | (1 << (index % 8)));
+    };
+
+    // Resolve pointer chains first so the final regions can be sorted and merged
+    size_t outputOffset = 0;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        uintptr_t address = 0;
+        if (resolve(memory, requests[i], address)) {
+            m_regions.push_back({address, requests[i].length, outputOffset, i});
+        } else {
+            markFailed(i);
+        }
+        outputOffset += requests[i].length;
+    }
+
+    std::ranges::sort(m_regions, {}, &Region::address);
+
+    size_t first = 0;
+    while (first < m_regions.size()) {
+        // Extend the batch while the next region starts within the merge gap and the span stays bounded
+        const uintptr_t start = m_regions[first].address;
+        uintptr_t end = start + m_regions[first].length;
+        size_t last = first + 1;
+        while (last < m_regions.size()) {
+            const Region& next = m_regions[last];
+            const uintptr_t nextEnd = std::max(end, next.address + next.length);
+            if (next.address > end + kMergeGap || nextEnd - start > kMaxMergedLength) {
+                break;
+            }
+            end = nextEnd;
+            ++last;
+        }
+
+        m_buffer.resize(end - start);
+        if (readRange(memory, start, m_buffer.data(), m_buffer.size())) {
+            for (size_t i = first; i < last; ++i) {
+                const Region& region = m_regions[i];
+                std::memcpy(data.data() + region.outputOffset, m_buffer.data() + (region.address - start),
+                            region.length);
+            }
+        } else {
+            // Part of the span is unreadable (possibly only a gap between regions): read individually
+            for (size_t i = first; i < last; ++i) {
+                const Region& region = m_regions[i];
+                if (last - first == 1 ||
+                    !readRange(memory, region.address, data.data() + region.outputOffset, region.length)) {
+                    std::memset(data.data() + region.outputOffset, 0, region.length);
+                    markFailed(region.requestIndex);
+                }
+            }
+        }
+
+        first = last;
+    }
+}
+
+bool MemoryGather::resolve(const interfaces::IMemoryReader& memory, const GatherRequest& request,
+                           uintptr_t& address) {
+    address = static_cast<uintptr_t>(request.address);
+    for (const int32_t offset : request.offsets) {
+        uint32_t pointer = 0;
+        ++m_lastReadCount;
+        if (!memory.readValue(address, pointer) || pointer == 0) {
+            return false;
+        }
+        address = static_cast<uintptr_t>(pointer) + static_cast<intptr_t>(offset);
+    }
+    return address != 0;
+}
+
+bool MemoryGather::readRange(const interfaces::IMemoryReader& memory, uintptr_t address, void* out, size_t size) {
+    ++m_lastReadCount;
+    return memory.read(address, out, size);
+}
+
+} // namespace icecap::agent::core
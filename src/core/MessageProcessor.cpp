@@ -1,6 +1,28 @@
+#include <chrono>
+#include <numeric>
+
+#include <icecap/agent/core/AgentMetrics.hpp>
 #include <icecap/agent/core/CommandExecutor.hpp>
 #include <icecap/agent/core/EventPublisher.hpp>
+#include <icecap/agent/core/FrameStallWatchdog.hpp>
+#include <icecap/agent/core/GameEventAggregator.hpp>
+#include <icecap/agent/core/GameEventStream.hpp>
+#include <icecap/agent/core/GameStatePublisher.hpp>
+#include <icecap/agent/core/MemoryGather.hpp>
 #include <icecap/agent/core/MessageProcessor.hpp>
+#include <icecap/agent/core/ObjectQuery.hpp>
+#include <icecap/agent/core/ObjectSnapshot.hpp>
+#include <icecap/agent/core/PageCachedMemoryReader.hpp>
+#include <icecap/agent/core/PathFollower.hpp>
+#include <icecap/agent/core/PositionHistory.hpp>
+#include <icecap/agent/core/RecurringTaskManager.hpp>
+#include <icecap/agent/core/ScriptProfiler.hpp>
+#include <icecap/agent/core/SpatialIndex.hpp>
+#include <icecap/agent/core/StateMachineEngine.hpp>
+#include <icecap/agent/core/TaskScheduler.hpp>
+#include <icecap/agent/core/Tracer.hpp>
+#include <icecap/agent/core/WatchManager.hpp>
+#include <icecap/agent/hooks/hook_manager.hpp>
 #include <icecap/agent/logging.hpp>
 
 namespace icecap::agent::core {
@@ -17,8 +39,13 @@ void MessageProcessor::processCommand(const IncomingMessage& command) {
         return;
     }
 
-    LOG_DEBUG("MessageProcessor: Processing command with ID '" + command.id() + "', operation_id '" +
-              command.operation_id() + "', type: " + std::to_string(static_cast<int>(command.type())));
+    TRACE_SCOPE("MessageProcessor::processCommand", "type", static_cast<uint64_t>(command.type()));
+
+    LOG_DEBUG("MessageProcessor: Processing command with ID '{}', operation_id '{}', type: {}", command.id(),
+              command.operation_id(), static_cast<int>(command.type()));
+
+    m_handlingCommand = true;
+    m_commandFailed = false;
 
     // Route command to appropriate handler
     switch (command.type()) {
@@ -34,11 +61,158 @@ void MessageProcessor::processCommand(const IncomingMessage& command) {
             handleClickToMoveCommand(command);
             break;
 
+        case icecap::agent::v1::COMMAND_TYPE_WATCH_SUBSCRIBE:
+            handleWatchSubscribeCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_WATCH_UNSUBSCRIBE:
+            handleWatchUnsubscribeCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_PATH_FOLLOW:
+            handlePathFollowCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_PATH_STOP:
+            handlePathStopCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_LUA_SEQUENCE:
+            handleLuaSequenceCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_TASK_CANCEL:
+            handleTaskCancelCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_RECURRING_TASK_REGISTER:
+            handleRecurringTaskRegisterCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_RECURRING_TASK_UNREGISTER:
+            handleRecurringTaskUnregisterCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_STATE_MACHINE_LOAD:
+            handleStateMachineLoadCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_STATE_MACHINE_UNLOAD:
+            handleStateMachineUnloadCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_STATE_MACHINE_CONFIGURE:
+            handleStateMachineConfigureCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_OBJECT_SNAPSHOT_SUBSCRIBE:
+            handleObjectSnapshotSubscribeCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_OBJECT_SNAPSHOT_UNSUBSCRIBE:
+            handleObjectSnapshotUnsubscribeCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_SPATIAL_QUERY:
+            handleSpatialQueryCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_GAME_STATE_QUERY:
+            handleGameStateQueryCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_POSITION_HISTORY_TRACK:
+            handlePositionHistoryTrackCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_POSITION_HISTORY_UNTRACK:
+            handlePositionHistoryUntrackCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_POSITION_HISTORY_QUERY:
+            handlePositionHistoryQueryCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_MEMORY_READ:
+            handleMemoryReadCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_OBJECT_QUERY:
+            handleObjectQueryCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_GAME_EVENT_SUBSCRIBE:
+            handleGameEventSubscribeCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_GAME_EVENT_UNSUBSCRIBE:
+            handleGameEventUnsubscribeCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_GAME_EVENT_AGGREGATE:
+            handleGameEventAggregateCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_LATENCY_QUERY:
+            handleLatencyQueryCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_TRACE_CONTROL:
+            handleTraceControlCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_SLOW_FRAME_CONFIGURE:
+            handleSlowFrameConfigureCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_SLOW_FRAME_HISTORY_QUERY:
+            handleSlowFrameHistoryQueryCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_FRAME_TIMING_QUERY:
+            handleFrameTimingQueryCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_FRAME_TIMING_SUBSCRIBE:
+            handleFrameTimingSubscribeCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_PING:
+            handlePingCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_SCRIPT_PROFILE_QUERY:
+            handleScriptProfileQueryCommand(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_HOOK_STATS_QUERY:
+            handleHookStatsQueryCommand(command);
+            break;
+
         default:
-            LOG_WARN("MessageProcessor: Unknown command type " + std::to_string(static_cast<int>(command.type())) +
-                     " for message ID " + command.id());
+            LOG_WARN("MessageProcessor: Unknown command type {} for message ID {}", static_cast<int>(command.type()),
+                     command.id());
+            m_commandFailed = true;
             break;
     }
+
+    m_handlingCommand = false;
+    m_context->getMetrics().recordCommand(static_cast<uint32_t>(command.type()), m_commandFailed);
+}
+
+void MessageProcessor::processCommand(interfaces::QueuedCommand& entry) {
+    const int64_t startMicros = CommandTimeline::nowMicros();
+    m_timeline = &entry.timeline;
+    processCommand(entry.command);
+    m_context->getFrameStallWatchdog().noteCommand(entry.command.id(), static_cast<uint32_t>(entry.command.type()),
+                                                   CommandTimeline::nowMicros() - startMicros);
+
+    // Commands that answer later (paths, sequences) or not at all end their timeline here
+    if (m_timeline) {
+        m_timeline->stamp(CommandStage::EXECUTED);
+        m_context->getCommandLatency().record(*m_timeline);
+        m_timeline = nullptr;
+    }
 }
 
 bool MessageProcessor::hasOutgoingEvents() const {
@@ -60,30 +234,196 @@ OutgoingMessage MessageProcessor::getNextOutgoingEvent() {
         throw std::runtime_error("MessageProcessor: No outgoing events available");
     }
 
-    OutgoingMessage event = m_context->getOutboxQueue().front();
+    auto& entry = m_context->getOutboxQueue().front();
+    m_context->getMetrics().recordOutboxPop(entry.bytes);
+    OutgoingMessage event = std::move(entry.event);
     m_context->getOutboxQueue().pop();
     return event;
 }
 
+void MessageProcessor::processFrame(uint64_t frameNumber) {
+    if (!m_context) {
+        return;
+    }
+
+    TRACE_SCOPE("MessageProcessor::processFrame");
+
+    // World state is captured first so everything after it sees this frame's objects
+    updateObjectSnapshot(frameNumber);
+    updatePositionHistory(frameNumber);
+    updateGameEvents(frameNumber);
+    m_context->getGameStatePublisher().publish(frameNumber, m_context->getObjectSnapshotEngine());
+
+    CommandExecutor executor(&m_context->getScriptProfiler());
+    updateWatches(frameNumber, executor);
+    updatePath(frameNumber, executor);
+    updateTasks(frameNumber);
+    updateRecurringTasks(frameNumber, executor);
+    updateStateMachines(frameNumber, executor);
+
+    updateFrameTiming(frameNumber);
+
+    // Last, so the measured time covers all of this frame's agent work
+    updateStallWatchdog();
+}
+
+void MessageProcessor::updateFrameTiming(uint64_t frameNumber) {
+    auto& timing = m_context->getFrameTiming();
+    if (timing.isPublishDue(frameNumber)) {
+        enqueueEvent(EventPublisher::createFrameTimingEvent(timing.summarize()));
+    }
+}
+
+void MessageProcessor::updateStallWatchdog() {
+    auto& watchdog = m_context->getFrameStallWatchdog();
+    SlowFrame slowFrame;
+    if (!watchdog.endFrame(CommandTimeline::nowMicros(), slowFrame)) {
+        return;
+    }
+
+    LOG_DEBUG("MessageProcessor: Frame {} held the render thread for {} us", slowFrame.frameNumber,
+              slowFrame.agentMicros);
+    if (watchdog.isPublishing()) {
+        enqueueEvent(EventPublisher::createSlowFrameEvent(slowFrame));
+    }
+}
+
+void MessageProcessor::updateWatches(uint64_t frameNumber, CommandExecutor& executor) {
+    auto& watchManager = m_context->getWatchManager();
+    if (watchManager.getSubscriptionCount() == 0) {
+        return;
+    }
+
+    // All changes observed on this frame go out as a single event
+    std::vector<WatchChange> changes;
+    watchManager.evaluate(frameNumber, executor, changes);
+
+    if (!changes.empty()) {
+        enqueueEvent(EventPublisher::createWatchValuesChangedEvent(changes));
+    }
+}
+
+void MessageProcessor::updatePath(uint64_t frameNumber, CommandExecutor& executor) {
+    auto& pathFollower = m_context->getPathFollower();
+    if (!pathFollower.isActive()) {
+        return;
+    }
+
+    std::vector<PathProgress> progress;
+    pathFollower.update(frameNumber, executor, m_context->getMemoryReader(), progress);
+    enqueuePathProgress(progress);
+}
+
+void MessageProcessor::updateTasks(uint64_t frameNumber) {
+    auto& scheduler = m_context->getTaskScheduler();
+    if (scheduler.getTaskCount() == 0) {
+        return;
+    }
+
+    // A task that throws never reports its own outcome, so report it for the controller waiting on it
+    std::vector<TaskScheduler::Failure> failures;
+    scheduler.tick(frameNumber, failures);
+    for (const auto& failure : failures) {
+        enqueueEvent(EventPublisher::createErrorEvent(failure.id, "Task failed: " + failure.error));
+    }
+}
+
+void MessageProcessor::updateRecurringTasks(uint64_t frameNumber, CommandExecutor& executor) {
+    auto& recurringTasks = m_context->getRecurringTaskManager();
+    if (recurringTasks.getTaskCount() == 0) {
+        return;
+    }
+
+    const auto nowMs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+
+    std::vector<RecurringTaskResult> results;
+    recurringTasks.update(frameNumber, nowMs, executor, results);
+
+    for (const auto& result : results) {
+        if (result.isRead && result.success) {
+            enqueueEvent(EventPublisher::createLuaVariableReadEvent(result.taskId, result.value));
+        } else {
+            enqueueEvent(EventPublisher::createErrorEvent(result.taskId, "Recurring task run failed"));
+        }
+    }
+}
+
+void MessageProcessor::updateStateMachines(uint64_t frameNumber, CommandExecutor& executor) {
+    auto& engine = m_context->getStateMachineEngine();
+    if (engine.getMachineCount() == 0) {
+        return;
+    }
+
+    // Only state changes leave the agent
+    std::vector<StateTransition> transitions;
+    engine.evaluate(frameNumber, executor, transitions);
+
+    for (const auto& transition : transitions) {
+        enqueueEvent(EventPublisher::createStateMachineTransitionEvent(transition));
+    }
+}
+
+void MessageProcessor::updateObjectSnapshot(uint64_t frameNumber) {
+    // The table is captured even without a delta subscription, so game state queries always have objects
+    auto& engine = m_context->getObjectSnapshotEngine();
+    const auto& memory = m_context->getMemoryReader();
+    ObjectDelta delta;
+    if (engine.update(frameNumber, memory, delta) && !delta.empty()) {
+        enqueueEvent(EventPublisher::createObjectSnapshotDeltaEvent(frameNumber, engine.getTable(), delta));
+    }
+}
+
+void MessageProcessor::updatePositionHistory(uint64_t frameNumber) {
+    auto& history = m_context->getPositionHistory();
+    if (history.getTrackCount() == 0) {
+        return;
+    }
+
+    const auto& memory = m_context->getMemoryReader();
+    history.record(frameNumber, GameStatePublisher::nowMicros(), memory);
+}
+
+void MessageProcessor::updateGameEvents(uint64_t frameNumber) {
+    auto& stream = m_context->getGameEventStream();
+    if (!stream.hasSubscriptions()) {
+        return;
+    }
+
+    const auto nowMs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+
+    // Coalesce before serializing so high-frequency events cost one message per window
+    std::vector<GameEvent> events;
+    std::vector<GameEventAggregate> aggregates;
+    stream.drain(events);
+    m_context->getGameEventAggregator().process(frameNumber, nowMs, events, aggregates);
+    for (const auto& aggregate : aggregates) {
+        enqueueEvent(EventPublisher::createGameEvent(frameNumber, aggregate));
+    }
+}
+
 void MessageProcessor::handleLuaExecuteCommand(const IncomingMessage& command) {
     if (!command.has_lua_execute_payload()) {
-        LOG_WARN("MessageProcessor: LUA_EXECUTE command missing payload for message ID " + command.id());
+        LOG_WARN("MessageProcessor: LUA_EXECUTE command missing payload for message ID {}", command.id());
         return;
     }
 
     const auto& payload = command.lua_execute_payload();
-    LOG_INFO("MessageProcessor: Executing Lua code for message ID " + command.id());
+    LOG_INFO("MessageProcessor: Executing Lua code for message ID {}", command.id());
 
-    CommandExecutor executor;
-    bool success = executor.executeLuaCode(payload.executable_code(), "source");
+    CommandExecutor executor(&m_context->getScriptProfiler());
+    bool success = executor.executeLuaCode(payload.executable_code(), payload.script_name());
 
     if (success) {
-        LOG_INFO("MessageProcessor: Lua execution successful for message ID " + command.id() + " operation ID " +
+        LOG_INFO("MessageProcessor: Lua execution successful for message ID {} operation ID {}", command.id(),
                  command.operation_id());
         OutgoingMessage event = EventPublisher::createSuccessEvent(command);
         enqueueEvent(event);
     } else {
-        LOG_ERROR("MessageProcessor: Lua execution failed for message ID " + command.id());
+        LOG_ERROR("MessageProcessor: Lua execution failed for message ID {}", command.id());
         OutgoingMessage event = EventPublisher::createErrorEvent(command, "Lua execution failed");
         enqueueEvent(event);
     }
@@ -91,46 +431,46 @@ void MessageProcessor::handleLuaExecuteCommand(const IncomingMessage& command) {
 
 void MessageProcessor::handleLuaReadVariableCommand(const IncomingMessage& command) {
     if (!command.has_lua_read_variable_payload()) {
-        LOG_WARN("MessageProcessor: LUA_READ_VARIABLE command missing payload for message ID " + command.id());
+        LOG_WARN("MessageProcessor: LUA_READ_VARIABLE command missing payload for message ID {}", command.id());
         return;
     }
 
     const auto& payload = command.lua_read_variable_payload();
-    LOG_INFO("MessageProcessor: Reading Lua variable '" + payload.variable_name() + "' for message ID " + command.id());
+    LOG_INFO("MessageProcessor: Reading Lua variable '{}' for message ID {}", payload.variable_name(), command.id());
 
-    CommandExecutor executor;
+    CommandExecutor executor(&m_context->getScriptProfiler());
     std::string result = executor.readLuaVariable(payload.variable_name());
 
     // Create and enqueue response event
     OutgoingMessage event = EventPublisher::createLuaVariableReadEvent(command, result);
 
-    LOG_DEBUG("MessageProcessor: Created event with ID '" + event.id() + "', operation_id '" + event.operation_id() +
-              "' for command ID '" + command.id() + "'");
+    LOG_DEBUG("MessageProcessor: Created event with ID '{}', operation_id '{}' for command ID '{}'", event.id(),
+              event.operation_id(), command.id());
 
     enqueueEvent(event);
 
-    LOG_INFO("MessageProcessor: Successfully read variable '" + payload.variable_name() + "' for message ID " +
+    LOG_INFO("MessageProcessor: Successfully read variable '{}' for message ID {}", payload.variable_name(),
              command.id());
 }
 
 void MessageProcessor::handleClickToMoveCommand(const IncomingMessage& command) {
     if (!command.has_click_to_move_payload()) {
-        LOG_WARN("MessageProcessor: CLICK_TO_MOVE command missing payload for message ID " + command.id());
+        LOG_WARN("MessageProcessor: CLICK_TO_MOVE command missing payload for message ID {}", command.id());
         return;
     }
 
     const auto& payload = command.click_to_move_payload();
-    LOG_INFO("MessageProcessor: Processing ClickToMove command for message ID " + command.id());
+    LOG_INFO("MessageProcessor: Processing ClickToMove command for message ID {}", command.id());
 
     const uintptr_t playerBaseAddress = payload.player_base_address();
     if (playerBaseAddress == 0) {
-        LOG_ERROR("MessageProcessor: ClickToMove command has invalid player_base_address (0) for message ID " +
+        LOG_ERROR("MessageProcessor: ClickToMove command has invalid player_base_address (0) for message ID {}",
                   command.id());
         return;
     }
 
     if (!payload.has_position()) {
-        LOG_ERROR("MessageProcessor: ClickToMove command missing position for message ID " + command.id());
+        LOG_ERROR("MessageProcessor: ClickToMove command missing position for message ID {}", command.id());
         return;
     }
 
@@ -139,24 +479,793 @@ void MessageProcessor::handleClickToMoveCommand(const IncomingMessage& command)
         executor.executeClickToMove(playerBaseAddress, payload.position(), payload.action(), payload.precision());
 
     if (success) {
-        LOG_INFO("MessageProcessor: ClickToMove successful for message ID " + command.id());
+        LOG_INFO("MessageProcessor: ClickToMove successful for message ID {}", command.id());
         OutgoingMessage event = EventPublisher::createSuccessEvent(command);
         enqueueEvent(event);
     } else {
-        LOG_WARN("MessageProcessor: ClickToMove failed for message ID " + command.id());
+        LOG_WARN("MessageProcessor: ClickToMove failed for message ID {}", command.id());
         OutgoingMessage event = EventPublisher::createErrorEvent(command, "ClickToMove execution failed");
         enqueueEvent(event);
     }
 }
 
+void MessageProcessor::handleWatchSubscribeCommand(const IncomingMessage& command) {
+    if (!command.has_watch_subscribe_payload()) {
+        LOG_WARN("MessageProcessor: WATCH_SUBSCRIBE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.watch_subscribe_payload();
+    LOG_INFO("MessageProcessor: Registering watch subscription '{}' with {} expressions for message ID {}",
+             command.operation_id(), payload.expressions_size(), command.id());
+
+    // The subscribing operation ID identifies the subscription in change events
+    const std::vector<std::string> expressions(payload.expressions().begin(), payload.expressions().end());
+    if (m_context->getWatchManager().subscribe(command.operation_id(), expressions, payload.interval_frames())) {
+        enqueueEvent(EventPublisher::createSuccessEvent(command));
+    } else {
+        LOG_WARN("MessageProcessor: Watch subscription rejected for message ID {}", command.id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Watch subscription rejected"));
+    }
+}
+
+void MessageProcessor::handleWatchUnsubscribeCommand(const IncomingMessage& command) {
+    if (!command.has_watch_unsubscribe_payload()) {
+        LOG_WARN("MessageProcessor: WATCH_UNSUBSCRIBE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.watch_unsubscribe_payload();
+    LOG_INFO("MessageProcessor: Removing watch subscription '{}' for message ID {}", payload.subscription_id(),
+             command.id());
+
+    if (m_context->getWatchManager().unsubscribe(payload.subscription_id())) {
+        enqueueEvent(EventPublisher::createSuccessEvent(command));
+    } else {
+        LOG_WARN("MessageProcessor: Unknown watch subscription '{}'", payload.subscription_id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Unknown watch subscription"));
+    }
+}
+
+void MessageProcessor::handlePathFollowCommand(const IncomingMessage& command) {
+    if (!command.has_path_follow_payload()) {
+        LOG_WARN("MessageProcessor: PATH_FOLLOW command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.path_follow_payload();
+    LOG_INFO("MessageProcessor: Following path with {} waypoints for message ID {}", payload.waypoints_size(),
+             command.id());
+
+    PathFollower::Path path;
+    path.operationId = command.operation_id();
+    path.playerBaseAddress = payload.player_base_address();
+    path.waypoints.assign(payload.waypoints().begin(), payload.waypoints().end());
+    path.arrivalRadius = payload.arrival_radius();
+    path.precision = payload.precision();
+    path.action = payload.action();
+
+    // Progress, completion and abort events carry the path's operation ID
+    std::vector<PathProgress> progress;
+    const bool started = m_context->getPathFollower().start(std::move(path), progress);
+    enqueuePathProgress(progress);
+
+    if (!started) {
+        LOG_WARN("MessageProcessor: Path rejected for message ID {}", command.id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Path rejected"));
+        return;
+    }
+
+    // Sent after the replaced path's abort so the controller sees the old path end before the new one is accepted
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handlePathStopCommand(const IncomingMessage& command) {
+    LOG_INFO("MessageProcessor: Stopping path for message ID {}", command.id());
+
+    std::vector<PathProgress> progress;
+    m_context->getPathFollower().stop("Stopped by controller", progress);
+    enqueuePathProgress(progress);
+
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handleLuaSequenceCommand(const IncomingMessage& command) {
+    if (!command.has_lua_sequence_payload()) {
+        LOG_WARN("MessageProcessor: LUA_SEQUENCE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    LOG_INFO("MessageProcessor: Starting Lua sequence with {} steps for message ID {}",
+             command.lua_sequence_payload().steps_size(), command.id());
+
+    // The task is keyed by operation ID so it can be cancelled; it reports its own outcome
+    if (!m_context->getTaskScheduler().spawn(command.operation_id(), runLuaSequence(m_context, command))) {
+        LOG_WARN("MessageProcessor: Lua sequence rejected for message ID {}", command.id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Lua sequence rejected"));
+    }
+}
+
+void MessageProcessor::handleTaskCancelCommand(const IncomingMessage& command) {
+    if (!command.has_task_cancel_payload()) {
+        LOG_WARN("MessageProcessor: TASK_CANCEL command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.task_cancel_payload();
+    LOG_INFO("MessageProcessor: Cancelling task '{}' for message ID {}", payload.operation_id(), command.id());
+
+    if (m_context->getTaskScheduler().cancel(payload.operation_id())) {
+        enqueueEvent(EventPublisher::createErrorEvent(payload.operation_id(), "Task cancelled"));
+        enqueueEvent(EventPublisher::createSuccessEvent(command));
+    } else {
+        LOG_WARN("MessageProcessor: Unknown task '{}'", payload.operation_id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Unknown task"));
+    }
+}
+
+void MessageProcessor::handleRecurringTaskRegisterCommand(const IncomingMessage& command) {
+    if (!command.has_recurring_task_register_payload()) {
+        LOG_WARN("MessageProcessor: RECURRING_TASK_REGISTER command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.recurring_task_register_payload();
+    LOG_INFO("MessageProcessor: Registering recurring task '{}' for message ID {}", command.operation_id(),
+             command.id());
+
+    // The registering operation ID identifies the task in its result events
+    RecurringTaskManager::Definition definition;
+    definition.id = command.operation_id();
+    definition.intervalFrames = payload.interval_frames();
+    definition.intervalMs = payload.interval_ms();
+    if (payload.has_read_expression()) {
+        definition.action = RecurringTaskManager::Action::READ;
+        definition.code = payload.read_expression();
+    } else {
+        definition.action = RecurringTaskManager::Action::EXECUTE;
+        definition.code = payload.execute_code();
+    }
+
+    if (m_context->getRecurringTaskManager().registerTask(definition)) {
+        enqueueEvent(EventPublisher::createSuccessEvent(command));
+    } else {
+        LOG_WARN("MessageProcessor: Recurring task rejected for message ID {}", command.id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Recurring task rejected"));
+    }
+}
+
+void MessageProcessor::handleRecurringTaskUnregisterCommand(const IncomingMessage& command) {
+    if (!command.has_recurring_task_unregister_payload()) {
+        LOG_WARN("MessageProcessor: RECURRING_TASK_UNREGISTER command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.recurring_task_unregister_payload();
+    LOG_INFO("MessageProcessor: Removing recurring task '{}' for message ID {}", payload.task_id(), command.id());
+
+    if (m_context->getRecurringTaskManager().unregisterTask(payload.task_id())) {
+        enqueueEvent(EventPublisher::createSuccessEvent(command));
+    } else {
+        LOG_WARN("MessageProcessor: Unknown recurring task '{}'", payload.task_id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Unknown recurring task"));
+    }
+}
+
+void MessageProcessor::handleStateMachineLoadCommand(const IncomingMessage& command) {
+    if (!command.has_state_machine_load_payload()) {
+        LOG_WARN("MessageProcessor: STATE_MACHINE_LOAD command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.state_machine_load_payload();
+    LOG_INFO("MessageProcessor: Loading state machine '{}' with {} states for message ID {}", command.operation_id(),
+             payload.states_size(), command.id());
+
+    // The loading operation ID identifies the machine in transition events
+    StateMachineDefinition definition;
+    definition.id = command.operation_id();
+    definition.initialState = payload.initial_state();
+    definition.intervalFrames = payload.interval_frames();
+    for (const auto& state : payload.states()) {
+        definition.states.push_back({state.name(), state.on_enter()});
+    }
+    for (const auto& transition : payload.transitions()) {
+        definition.transitions.push_back({transition.from(), transition.to(), transition.condition()});
+    }
+
+    if (m_context->getStateMachineEngine().load(definition)) {
+        enqueueEvent(EventPublisher::createSuccessEvent(command));
+    } else {
+        LOG_WARN("MessageProcessor: State machine rejected for message ID {}", command.id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "State machine rejected"));
+    }
+}
+
+void MessageProcessor::handleStateMachineUnloadCommand(const IncomingMessage& command) {
+    if (!command.has_state_machine_unload_payload()) {
+        LOG_WARN("MessageProcessor: STATE_MACHINE_UNLOAD command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.state_machine_unload_payload();
+    LOG_INFO("MessageProcessor: Unloading state machine '{}' for message ID {}", payload.machine_id(), command.id());
+
+    if (m_context->getStateMachineEngine().unload(payload.machine_id())) {
+        enqueueEvent(EventPublisher::createSuccessEvent(command));
+    } else {
+        LOG_WARN("MessageProcessor: Unknown state machine '{}'", payload.machine_id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Unknown state machine"));
+    }
+}
+
+void MessageProcessor::handleStateMachineConfigureCommand(const IncomingMessage& command) {
+    if (!command.has_state_machine_configure_payload()) {
+        LOG_WARN("MessageProcessor: STATE_MACHINE_CONFIGURE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    // The budget is shared by every loaded machine; 0 keeps the current one, so the command doubles as a stats query
+    const auto& payload = command.state_machine_configure_payload();
+    auto& engine = m_context->getStateMachineEngine();
+    if (payload.frame_budget_us() != 0) {
+        engine.setFrameBudget(std::chrono::microseconds(payload.frame_budget_us()));
+        LOG_INFO("MessageProcessor: State machine frame budget set to {} us", payload.frame_budget_us());
+    }
+
+    enqueueEvent(EventPublisher::createStateMachineStatsEvent(command, engine));
+    if (payload.reset_stats()) {
+        engine.resetStats();
+    }
+}
+
+void MessageProcessor::handleObjectSnapshotSubscribeCommand(const IncomingMessage& command) {
+    if (!command.has_object_snapshot_subscribe_payload()) {
+        LOG_WARN("MessageProcessor: OBJECT_SNAPSHOT_SUBSCRIBE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.object_snapshot_subscribe_payload();
+    LOG_INFO("MessageProcessor: Enabling object snapshot deltas for message ID {}", command.id());
+
+    // The first delta after (re)subscribing spawns every object, giving the controller a full baseline
+    m_context->getObjectSnapshotEngine().enable(payload.interval_frames(), payload.type_mask(),
+                                                payload.position_epsilon());
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handleObjectSnapshotUnsubscribeCommand(const IncomingMessage& command) {
+    LOG_INFO("MessageProcessor: Disabling object snapshot deltas for message ID {}", command.id());
+
+    m_context->getObjectSnapshotEngine().disable();
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handleSpatialQueryCommand(const IncomingMessage& command) {
+    if (!command.has_spatial_query_payload()) {
+        LOG_WARN("MessageProcessor: SPATIAL_QUERY command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.spatial_query_payload();
+    if (payload.nearest_count() == 0 && payload.radius() <= 0.0f) {
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Spatial query needs a radius or a nearest count"));
+        return;
+    }
+
+    const ObjectTable& table = acquireObjectTable();
+    auto& index = m_context->getSpatialIndex();
+    index.build(table, m_context->getObjectSnapshotEngine().getVersion());
+
+    const auto& center = payload.center();
+    std::vector<SpatialIndex::Neighbor> neighbors;
+    if (payload.nearest_count() > 0) {
+        index.queryNearest(center.x(), center.y(), center.z(), payload.nearest_count(), payload.radius(),
+                           payload.type_mask(), neighbors);
+    } else {
+        index.queryRadius(center.x(), center.y(), center.z(), payload.radius(), payload.type_mask(), neighbors);
+    }
+
+    LOG_DEBUG("MessageProcessor: Spatial query matched {} objects for message ID {}", neighbors.size(), command.id());
+    enqueueEvent(EventPublisher::createSpatialQueryResultEvent(command, table, neighbors));
+}
+
+void MessageProcessor::handleObjectQueryCommand(const IncomingMessage& command) {
+    if (!command.has_object_query_payload()) {
+        LOG_WARN("MessageProcessor: OBJECT_QUERY command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    std::string error;
+    const auto query = ObjectQuery::compile(command.object_query_payload().query(), error);
+    if (!query) {
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Invalid object query: " + error));
+        return;
+    }
+
+    const ObjectTable& table = acquireObjectTable();
+    std::vector<size_t> rows;
+    query->select(table, rows);
+
+    LOG_DEBUG("MessageProcessor: Object query matched {} of {} objects for message ID {}", rows.size(), table.size(),
+              command.id());
+    enqueueEvent(EventPublisher::createObjectQueryResultEvent(command, table, rows, query->getProjection()));
+}
+
+void MessageProcessor::handleGameEventSubscribeCommand(const IncomingMessage& command) {
+    if (!command.has_game_event_subscribe_payload()) {
+        LOG_WARN("MessageProcessor: GAME_EVENT_SUBSCRIBE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    // Validate every id first so a rejected command leaves the subscription set untouched
+    const auto& eventIds = command.game_event_subscribe_payload().event_ids();
+    for (const uint32_t eventId : eventIds) {
+        if (eventId >= GameEventStream::kMaxEventId) {
+            LOG_WARN("MessageProcessor: GAME_EVENT_SUBSCRIBE rejected event ID {} for message ID {}", eventId,
+                     command.id());
+            enqueueEvent(EventPublisher::createErrorEvent(
+                command, "Event ID " + std::to_string(eventId) + " exceeds " +
+                             std::to_string(GameEventStream::kMaxEventId - 1)));
+            return;
+        }
+    }
+
+    auto& stream = m_context->getGameEventStream();
+    for (const uint32_t eventId : eventIds) {
+        stream.subscribe(eventId);
+    }
+
+    LOG_INFO("MessageProcessor: Subscribed to {} game events for message ID {}",
+             command.game_event_subscribe_payload().event_ids_size(), command.id());
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handleGameEventUnsubscribeCommand(const IncomingMessage& command) {
+    auto& stream = m_context->getGameEventStream();
+
+    // No payload or no ids clears every subscription
+    if (!command.has_game_event_unsubscribe_payload() ||
+        command.game_event_unsubscribe_payload().event_ids_size() == 0) {
+        stream.unsubscribeAll();
+    } else {
+        for (const uint32_t eventId : command.game_event_unsubscribe_payload().event_ids()) {
+            stream.unsubscribe(eventId);
+        }
+    }
+
+    // Drop anything captured or aggregated under the old subscription set
+    std::vector<GameEvent> discarded;
+    if (!stream.hasSubscriptions()) {
+        stream.drain(discarded);
+        m_context->getGameEventAggregator().discardPending();
+    }
+
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handleGameEventAggregateCommand(const IncomingMessage& command) {
+    if (!command.has_game_event_aggregate_payload()) {
+        LOG_WARN("MessageProcessor: GAME_EVENT_AGGREGATE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.game_event_aggregate_payload();
+    auto& aggregator = m_context->getGameEventAggregator();
+
+    // NONE restores pass-through delivery for the event; its open window is still delivered next frame
+    if (payload.mode() == icecap::agent::v1::GAME_EVENT_AGGREGATION_NONE) {
+        aggregator.removePolicy(payload.event_id());
+        enqueueEvent(EventPublisher::createSuccessEvent(command));
+        return;
+    }
+
+    GameEventAggregator::Policy policy;
+    switch (payload.mode()) {
+        case icecap::agent::v1::GAME_EVENT_AGGREGATION_SUM:
+            policy.mode = GameEventAggregator::Mode::SUM;
+            break;
+        case icecap::agent::v1::GAME_EVENT_AGGREGATION_SAMPLE:
+            policy.mode = GameEventAggregator::Mode::SAMPLE;
+            break;
+        default:
+            policy.mode = GameEventAggregator::Mode::LATEST;
+            break;
+    }
+    policy.keyArgument = payload.key_argument();
+    policy.valueArgument = payload.value_argument();
+    policy.sampleEvery = payload.sample_every() != 0 ? payload.sample_every() : 1;
+    policy.windowFrames = payload.window_frames();
+    policy.windowMs = payload.window_ms();
+
+    if (!aggregator.setPolicy(payload.event_id(), policy)) {
+        LOG_WARN("MessageProcessor: Game event aggregation rejected for message ID {}", command.id());
+        enqueueEvent(EventPublisher::createErrorEvent(command, "Game event aggregation rejected"));
+        return;
+    }
+
+    LOG_INFO("MessageProcessor: Aggregating game event {} for message ID {}", payload.event_id(), command.id());
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+const ObjectTable& MessageProcessor::acquireObjectTable() {
+    // Captured by processFrame on every frame, so this is the table as of the previous frame
+    return m_context->getObjectSnapshotEngine().getTable();
+}
+
+void MessageProcessor::handleGameStateQueryCommand(const IncomingMessage& command) {
+    // Normally answered on the network thread; this path serves commands that reached the inbox anyway
+    answerReadOnlyQueryOnFrame(command);
+}
+
+void MessageProcessor::handleLatencyQueryCommand(const IncomingMessage& command) {
+    // Normally answered on the network thread, like game state queries
+    answerReadOnlyQueryOnFrame(command);
+}
+
+void MessageProcessor::handleTraceControlCommand(const IncomingMessage& command) {
+    // Normally handled on the network thread so a dump never stalls a frame
+    answerReadOnlyQueryOnFrame(command);
+}
+
+void MessageProcessor::handlePingCommand(const IncomingMessage& command) {
+    // Normally answered on the network thread; from here the send time includes the wait for a frame
+    answerReadOnlyQueryOnFrame(command);
+}
+
+void MessageProcessor::handleHookStatsQueryCommand(const IncomingMessage& command) {
+    // Normally answered on the network thread; the counters are atomics
+    answerReadOnlyQueryOnFrame(command);
+}
+
+void MessageProcessor::handleScriptProfileQueryCommand(const IncomingMessage& command) {
+    // The payload is optional: without one, report the default number of scripts and keep the profile
+    const auto& payload = command.script_profile_query_payload();
+    const size_t count = payload.top_count() != 0 ? payload.top_count() : ScriptProfiler::kDefaultTopCount;
+
+    auto& profiler = m_context->getScriptProfiler();
+    enqueueEvent(EventPublisher::createScriptProfileEvent(command, profiler.top(count), profiler.getScriptCount()));
+    if (payload.reset()) {
+        profiler.reset();
+        LOG_INFO("MessageProcessor: Script profile reset");
+    }
+}
+
+void MessageProcessor::answerReadOnlyQueryOnFrame(const IncomingMessage& command) {
+    OutgoingMessage response;
+    if (answerReadOnlyQuery(*m_context, command, m_timeline ? *m_timeline : CommandTimeline{}, response)) {
+        enqueueEvent(response);
+    }
+}
+
+void MessageProcessor::handleSlowFrameConfigureCommand(const IncomingMessage& command) {
+    if (!command.has_slow_frame_configure_payload()) {
+        LOG_WARN("MessageProcessor: SLOW_FRAME_CONFIGURE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.slow_frame_configure_payload();
+    auto& watchdog = m_context->getFrameStallWatchdog();
+    watchdog.setThreshold(payload.threshold_us());
+    watchdog.setPublishing(payload.publish());
+
+    LOG_INFO("MessageProcessor: Slow frame threshold set to {} us, publishing {}", watchdog.getThreshold(),
+             (payload.publish() ? "on" : "off"));
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handleSlowFrameHistoryQueryCommand(const IncomingMessage& command) {
+    const auto& history = m_context->getFrameStallWatchdog().getHistory();
+    enqueueEvent(EventPublisher::createSlowFrameHistoryEvent(command, history));
+}
+
+void MessageProcessor::handleFrameTimingQueryCommand(const IncomingMessage& command) {
+    enqueueEvent(EventPublisher::createFrameTimingEvent(command, m_context->getFrameTiming().summarize()));
+}
+
+void MessageProcessor::handleFrameTimingSubscribeCommand(const IncomingMessage& command) {
+    if (!command.has_frame_timing_subscribe_payload()) {
+        LOG_WARN("MessageProcessor: FRAME_TIMING_SUBSCRIBE command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const uint32_t intervalFrames = command.frame_timing_subscribe_payload().interval_frames();
+    m_context->getFrameTiming().setPublishInterval(intervalFrames);
+
+    LOG_INFO("MessageProcessor: Frame timing published every {} frames", intervalFrames);
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+bool MessageProcessor::answerReadOnlyQuery(interfaces::IApplicationContext& context, const IncomingMessage& command,
+                                           const CommandTimeline& timeline, OutgoingMessage& response) {
+    switch (command.type()) {
+        case icecap::agent::v1::COMMAND_TYPE_GAME_STATE_QUERY:
+            response = answerGameStateQuery(context.getGameStatePublisher(), command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_LATENCY_QUERY: {
+            auto& latency = context.getCommandLatency();
+            response = EventPublisher::createLatencyReportEvent(command, latency);
+            if (command.has_latency_query_payload() && command.latency_query_payload().reset()) {
+                latency.reset();
+            }
+            break;
+        }
+
+        case icecap::agent::v1::COMMAND_TYPE_TRACE_CONTROL:
+            response = answerTraceControl(command);
+            break;
+
+        case icecap::agent::v1::COMMAND_TYPE_PING: {
+            // Receive time is when recv() returned the frame; without a timeline, the best we have is now
+            const int64_t receivedMicros = timeline.isActive()
+                                               ? timeline.micros[static_cast<size_t>(CommandStage::RECEIVED)]
+                                               : CommandTimeline::nowMicros();
+            response = EventPublisher::createPongEvent(command, receivedMicros, CommandTimeline::nowMicros());
+            break;
+        }
+
+        case icecap::agent::v1::COMMAND_TYPE_HOOK_STATS_QUERY: {
+            const auto* registry = hooks::GetHookRegistry();
+            if (!registry) {
+                response = EventPublisher::createErrorEvent(command, "Hooks are not installed");
+                break;
+            }
+            response = EventPublisher::createHookStatsEvent(command, registry->getHookStats(),
+                                                            registry->getCyclesPerSecond());
+            break;
+        }
+
+        default:
+            return false;
+    }
+
+    // Answered between frames: stamp with the frame the render thread is in or last finished
+    response.set_frame_number(context.getFrameTiming().getCurrentFrame());
+    return true;
+}
+
+OutgoingMessage MessageProcessor::answerTraceControl(const IncomingMessage& command) {
+    if (!command.has_trace_control_payload()) {
+        LOG_WARN("MessageProcessor: Trace control command missing payload for message ID {}", command.id());
+        return EventPublisher::createErrorEvent(command, "Trace control command missing payload");
+    }
+
+    const auto& payload = command.trace_control_payload();
+    switch (payload.action()) {
+        case icecap::agent::v1::TRACE_ACTION_START:
+            Tracer::clear();
+            Tracer::setEnabled(true);
+            LOG_INFO("MessageProcessor: Tracing started");
+            return EventPublisher::createSuccessEvent(command);
+
+        case icecap::agent::v1::TRACE_ACTION_STOP:
+            Tracer::setEnabled(false);
+            LOG_INFO("MessageProcessor: Tracing stopped");
+            return EventPublisher::createSuccessEvent(command);
+
+        case icecap::agent::v1::TRACE_ACTION_DUMP: {
+            std::string path;
+            size_t spanCount = 0;
+            if (!Tracer::dump(payload.path(), path, spanCount)) {
+                return EventPublisher::createErrorEvent(command, "Failed to write trace file");
+            }
+            LOG_INFO("MessageProcessor: Wrote {} trace spans to {}", spanCount, path);
+            return EventPublisher::createTraceDumpedEvent(command, path, spanCount);
+        }
+
+        default:
+            return EventPublisher::createErrorEvent(command, "Unknown trace action");
+    }
+}
+
+OutgoingMessage MessageProcessor::answerGameStateQuery(const GameStatePublisher& publisher,
+                                                       const IncomingMessage& command) {
+    // Freshness first: a state published after it is only newer than what it confirms
+    const GameStateFreshness freshness = publisher.getFreshness();
+    const auto state = publisher.acquire();
+    if (!state) {
+        return EventPublisher::createErrorEvent(command, "No game state has been published yet");
+    }
+
+    // Select the requested rows; no GUIDs means every object in the snapshot
+    std::vector<size_t> rows;
+    if (state->objects) {
+        const auto& guids = command.game_state_query_payload().guids();
+        if (guids.empty()) {
+            rows.resize(state->objects->size());
+            std::iota(rows.begin(), rows.end(), size_t{0});
+        } else {
+            for (const uint64_t guid : guids) {
+                if (const auto row = state->objects->find(guid)) {
+                    rows.push_back(*row);
+                }
+            }
+        }
+    }
+
+    // An unchanged state is as current as the last capture that confirmed it
+    const bool confirmed = freshness.frameNumber > state->frameNumber;
+    const uint64_t frameNumber = confirmed ? freshness.frameNumber : state->frameNumber;
+    const int64_t observedAtMicros = confirmed ? freshness.confirmedAtMicros : state->publishedAtMicros;
+    const int64_t ageMicros = GameStatePublisher::nowMicros() - observedAtMicros;
+    return EventPublisher::createGameStateEvent(command, *state, rows, frameNumber, ageMicros);
+}
+
+void MessageProcessor::handlePositionHistoryTrackCommand(const IncomingMessage& command) {
+    if (!command.has_position_history_track_payload()) {
+        LOG_WARN("MessageProcessor: POSITION_HISTORY_TRACK command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.position_history_track_payload();
+    LOG_INFO("MessageProcessor: Recording position history for GUID {} (message ID {})", payload.guid(), command.id());
+
+    if (!m_context->getPositionHistory().track(payload.guid(), payload.capacity())) {
+        enqueueEvent(EventPublisher::createErrorEvent(
+            command, "Position history track limit reached (" + std::to_string(PositionHistory::kMaxTracks) + ")"));
+        return;
+    }
+
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handlePositionHistoryUntrackCommand(const IncomingMessage& command) {
+    if (!command.has_position_history_untrack_payload()) {
+        LOG_WARN("MessageProcessor: POSITION_HISTORY_UNTRACK command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const uint64_t guid = command.position_history_untrack_payload().guid();
+    if (!m_context->getPositionHistory().untrack(guid)) {
+        enqueueEvent(EventPublisher::createErrorEvent(command, "GUID " + std::to_string(guid) + " is not tracked"));
+        return;
+    }
+
+    enqueueEvent(EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::handlePositionHistoryQueryCommand(const IncomingMessage& command) {
+    if (!command.has_position_history_query_payload()) {
+        LOG_WARN("MessageProcessor: POSITION_HISTORY_QUERY command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.position_history_query_payload();
+    std::vector<PositionSample> samples;
+    if (!m_context->getPositionHistory().query(payload.guid(), payload.window_frames(), payload.window_micros(),
+                                               samples)) {
+        enqueueEvent(
+            EventPublisher::createErrorEvent(command, "GUID " + std::to_string(payload.guid()) + " is not tracked"));
+        return;
+    }
+
+    enqueueEvent(EventPublisher::createPositionHistoryEvent(command, payload.guid(), samples));
+}
+
+void MessageProcessor::handleMemoryReadCommand(const IncomingMessage& command) {
+    if (!command.has_memory_read_payload()) {
+        LOG_WARN("MessageProcessor: MEMORY_READ command missing payload for message ID {}", command.id());
+        return;
+    }
+
+    const auto& payload = command.memory_read_payload();
+    std::vector<GatherRequest> requests;
+    requests.reserve(payload.regions_size());
+    for (const auto& region : payload.regions()) {
+        requests.push_back(
+            {region.address(), std::vector<int32_t>(region.offsets().begin(), region.offsets().end()), region.length()});
+    }
+
+    if (const std::string error = MemoryGather::validate(requests); !error.empty()) {
+        enqueueEvent(EventPublisher::createErrorEvent(command, error));
+        return;
+    }
+
+    const auto& memory = m_context->getMemoryReader();
+    MemoryGather gather;
+    std::string data;
+    std::string failedBitmap;
+    gather.gather(memory, requests, data, failedBitmap);
+
+    LOG_DEBUG("MessageProcessor: Read {} memory regions in {} reads for message ID {}", requests.size(),
+              gather.getLastReadCount(), command.id());
+    enqueueEvent(EventPublisher::createMemoryReadResultEvent(command, std::move(data), std::move(failedBitmap)));
+}
+
+Task MessageProcessor::runLuaSequence(interfaces::IApplicationContext* context, IncomingMessage command) {
+    const auto& payload = command.lua_sequence_payload();
+    CommandExecutor executor(&context->getScriptProfiler());
+
+    for (int i = 0; i < payload.steps_size(); ++i) {
+        const auto& step = payload.steps(i);
+
+        switch (step.step_case()) {
+            case icecap::agent::v1::LuaSequenceStep::kExecuteCode:
+                if (!executor.executeLuaCode(step.execute_code())) {
+                    LOG_WARN("MessageProcessor: Lua sequence '{}' failed at step {}", command.operation_id(), i);
+                    enqueueEvent(context, EventPublisher::createErrorEvent(command, "Lua sequence step failed"));
+                    co_return;
+                }
+                break;
+
+            case icecap::agent::v1::LuaSequenceStep::kReadVariable:
+                enqueueEvent(context, EventPublisher::createLuaVariableReadEvent(
+                                          command, executor.readLuaVariable(step.read_variable())));
+                break;
+
+            case icecap::agent::v1::LuaSequenceStep::kWaitFrames:
+                co_await WaitFrames{step.wait_frames()};
+                break;
+
+            case icecap::agent::v1::LuaSequenceStep::kWaitUntil: {
+                const auto& wait = step.wait_until();
+                const bool satisfied = co_await WaitUntil{[&executor, &wait] {
+                                                              bool result = false;
+                                                              return executor.evaluateLuaCondition(wait.condition(),
+                                                                                                   result) &&
+                                                                     result;
+                                                          },
+                                                          wait.poll_interval_frames(), wait.timeout_frames()};
+                if (!satisfied) {
+                    LOG_WARN("MessageProcessor: Lua sequence '{}' timed out waiting at step {}", command.operation_id(),
+                             i);
+                    enqueueEvent(context, EventPublisher::createErrorEvent(command, "Lua sequence wait timed out"));
+                    co_return;
+                }
+                break;
+            }
+
+            default:
+                LOG_WARN("MessageProcessor: Lua sequence '{}' has an empty step {}", command.operation_id(), i);
+                enqueueEvent(context, EventPublisher::createErrorEvent(command, "Invalid Lua sequence step"));
+                co_return;
+        }
+    }
+
+    enqueueEvent(context, EventPublisher::createSuccessEvent(command));
+}
+
+void MessageProcessor::enqueuePathProgress(const std::vector<PathProgress>& progress) {
+    // Progress belongs to a path, not to the command being handled, so it never carries the command's timeline
+    for (const auto& entry : progress) {
+        enqueueEvent(m_context, EventPublisher::createPathProgressEvent(entry), nullptr);
+    }
+}
+
 void MessageProcessor::enqueueEvent(const OutgoingMessage& event) {
-    if (!m_context) {
+    if (m_handlingCommand && event.type() == icecap::agent::v1::EVENT_TYPE_OPERATION_FAILED) {
+        m_commandFailed = true;
+    }
+
+    // The first event of the command being processed carries its timeline on to the network thread
+    if (m_timeline) {
+        m_timeline->stamp(CommandStage::EXECUTED);
+    }
+    enqueueEvent(m_context, event, m_timeline);
+    m_timeline = nullptr;
+}
+
+void MessageProcessor::enqueueEvent(interfaces::IApplicationContext* context, const OutgoingMessage& event,
+                                    CommandTimeline* timeline) {
+    if (!context) {
         LOG_ERROR("MessageProcessor: Cannot enqueue event - no application context");
         return;
     }
 
-    std::lock_guard<std::mutex> lock(m_context->getOutboxMutex());
-    m_context->getOutboxQueue().push(event);
+    interfaces::QueuedEvent entry{event, {}, 0};
+    entry.event.set_frame_number(context->getFrameTiming().getCurrentFrame());
+    entry.bytes = entry.event.ByteSizeLong();
+    const size_t bytes = entry.bytes;
+    {
+        std::lock_guard<std::mutex> lock(context->getOutboxMutex());
+        if (timeline) {
+            timeline->stamp(CommandStage::EVENT_ENQUEUED);
+            entry.timeline = *timeline;
+        }
+        context->getOutboxQueue().push(std::move(entry));
+    }
+    context->getMetrics().recordOutboxPush(bytes);
 }
 
 } // namespace icecap::agent::core
\ No newline at end of file
@@ -0,0 +1,632 @@
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <icecap/agent/core/ObjectQuery.hpp>
+
+namespace icecap::agent::core {
+
+namespace {
+
+struct Token {
+    enum class Kind { IDENTIFIER, NUMBER, SYMBOL, END };
+
+    Kind kind{Kind::END};
+    std::string_view text;
+};
+
+// Split the query into identifiers, numbers and operator symbols
+bool tokenize(std::string_view text, std::vector<Token>& tokens, std::string& error) {
+    static constexpr std::string_view kSymbols[] = {"->", "==", "!=", "<=", ">=", "&&", "||", "<",
+                                                    ">",  "!",  "(",  ")",  ",",  "-",  "*"};
+    static constexpr std::string_view kUnicodeArrow = "\xE2\x86\x92"; // U+2192
+
+    size_t i = 0;
+    while (i < text.size()) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (std::isspace(c)) {
+            ++i;
+            continue;
+        }
+
+        const size_t start = i;
+        if (std::isalpha(c) || c == '_') {
+            while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_')) {
+                ++i;
+            }
+            tokens.push_back({Token::Kind::IDENTIFIER, text.substr(start, i - start)});
+            continue;
+        }
+        const bool fraction = c == '.' && i + 1 < text.size() && std::isdigit(static_cast<unsigned char>(text[i + 1]));
+        if (std::isdigit(c) || fraction) {
+            const bool hex = c == '0' && i + 1 < text.size() && (text[i + 1] == 'x' || text[i + 1] == 'X');
+            while (i < text.size()) {
+                const unsigned char d = static_cast<unsigned char>(text[i]);
+                // A sign directly after a decimal exponent marker belongs to the number (1e-5)
+                const bool exponentSign = !hex && (d == '+' || d == '-') && (text[i - 1] == 'e' || text[i - 1] == 'E');
+                if (!std::isalnum(d) && d != '.' && !exponentSign) {
+                    break;
+                }
+                ++i;
+            }
+            tokens.push_back({Token::Kind::NUMBER, text.substr(start, i - start)});
+            continue;
+        }
+        if (text.substr(i).starts_with(kUnicodeArrow)) {
+            tokens.push_back({Token::Kind::SYMBOL, "->"});
+            i += kUnicodeArrow.size();
+            continue;
+        }
+
+        bool matched = false;
+        for (const auto symbol : kSymbols) {
+            if (text.substr(i).starts_with(symbol)) {
+                tokens.push_back({Token::Kind::SYMBOL, symbol});
+                i += symbol.size();
+                matched = true;
+                break;
+            }
+        }
+        if (!matched) {
+            error = "Unexpected character '" + std::string(1, text[i]) + "' at offset " + std::to_string(i);
+            return false;
+        }
+    }
+
+    tokens.push_back({Token::Kind::END, {}});
+    return true;
+}
+
+// Compare every value of a column against a literal; the switch sits outside the loops so each one vectorizes.
+// A NaN value (an undefined derived column) matches no comparison, != included.
+template <typename T, typename V>
+void compareColumn(const T* values, size_t count, auto op, V literal, uint8_t* out) {
+    using Op = decltype(op);
+    switch (op) {
+        case Op::EQ:
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = static_cast<V>(values[i]) == literal;
+            }
+            break;
+        case Op::NE:
+            for (size_t i = 0; i < count; ++i) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    out[i] = (static_cast<V>(values[i]) < literal) | (static_cast<V>(values[i]) > literal);
+                } else {
+                    out[i] = static_cast<V>(values[i]) != literal;
+                }
+            }
+            break;
+        case Op::LT:
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = static_cast<V>(values[i]) < literal;
+            }
+            break;
+        case Op::LE:
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = static_cast<V>(values[i]) <= literal;
+            }
+            break;
+        case Op::GT:
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = static_cast<V>(values[i]) > literal;
+            }
+            break;
+        case Op::GE:
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = static_cast<V>(values[i]) >= literal;
+            }
+            break;
+    }
+}
+
+// Health percentage per row; objects without health (max 0) get NaN so that no hp_pct comparison selects them.
+// To keep the loop vectorizable it divides unconditionally (by 1 instead of 0), converts through int32, which
+// health always fits, and sets the NaN bits with integer operations rather than a floating-point select.
+void computeHealthPct(const uint32_t* health, const uint32_t* maxHealth, size_t count, float* out) {
+    constexpr uint32_t kQuietNanBits = 0x7FC00000u;
+    for (size_t i = 0; i < count; ++i) {
+        const int32_t max = static_cast<int32_t>(maxHealth[i]);
+        const float pct = 100.0f * static_cast<float>(static_cast<int32_t>(health[i])) /
+                          static_cast<float>(max + (max == 0));
+        const uint32_t nanBits = max == 0 ? kQuietNanBits : 0u;
+        out[i] = std::bit_cast<float>(std::bit_cast<uint32_t>(pct) | nanBits);
+    }
+}
+
+// Compare an unsigned integer column against a numeric literal in the column's own type. The literal is rewritten
+// into an exact integer bound (x < 2.5 is x <= 2); a bound outside the type's range selects all rows or none.
+template <typename T>
+void compareIntegerColumn(const T* values, size_t count, auto op, double literal, uint8_t* out) {
+    using Op = decltype(op);
+    constexpr double kMax = static_cast<double>(std::numeric_limits<T>::max());
+    const double below = std::floor(literal);
+    const double above = std::ceil(literal);
+
+    int result = -1; // Constant outcome for every row, or -1 to compare against `bound`
+    T bound{};
+    switch (op) {
+        case Op::EQ:
+        case Op::NE:
+            if (below != literal || literal < 0.0 || literal > kMax) {
+                result = op == Op::NE;
+            } else {
+                bound = static_cast<T>(literal);
+            }
+            break;
+        case Op::LT:
+        case Op::GE:
+            if (above <= 0.0 || above > kMax) {
+                result = (above <= 0.0) == (op == Op::GE);
+            } else {
+                bound = static_cast<T>(above);
+            }
+            break;
+        case Op::LE:
+        case Op::GT:
+            if (below < 0.0 || below >= kMax) {
+                result = (below < 0.0) == (op == Op::GT);
+            } else {
+                bound = static_cast<T>(below);
+            }
+            break;
+    }
+
+    if (result >= 0) {
+        std::memset(out, result, count);
+    } else {
+        compareColumn(values, count, op, bound, out);
+    }
+}
+
+} // namespace
+
+class ObjectQuery::Parser {
+public:
+    Parser(const std::vector<Token>& tokens, ObjectQuery& query, std::string& error)
+        : m_tokens(tokens), m_query(query), m_error(error) {}
+
+    bool parse() {
+        // Filter (optional) followed by an optional projection
+        if (!peek("->") && m_tokens[m_position].kind != Token::Kind::END) {
+            if (!parseOr()) {
+                return false;
+            }
+        }
+        if (accept("->")) {
+            if (!parseProjection()) {
+                return false;
+            }
+        }
+        if (m_tokens[m_position].kind != Token::Kind::END) {
+            return fail("Unexpected '" + std::string(m_tokens[m_position].text) + "'");
+        }
+        return true;
+    }
+
+private:
+    bool parseOr() {
+        if (!parseAnd()) {
+            return false;
+        }
+        while (accept("||")) {
+            if (!parseAnd()) {
+                return false;
+            }
+            emit(Instruction::Kind::OR);
+        }
+        return true;
+    }
+
+    bool parseAnd() {
+        if (!parseUnary()) {
+            return false;
+        }
+        while (accept("&&")) {
+            if (!parseUnary()) {
+                return false;
+            }
+            emit(Instruction::Kind::AND);
+        }
+        return true;
+    }
+
+    bool parseUnary() {
+        if (accept("!")) {
+            if (!parseUnary()) {
+                return false;
+            }
+            emit(Instruction::Kind::NOT);
+            return true;
+        }
+        if (accept("(")) {
+            if (!parseOr()) {
+                return false;
+            }
+            return accept(")") || fail("Expected ')'");
+        }
+        return parseComparison();
+    }
+
+    bool parseComparison() {
+        const Token& name = m_tokens[m_position];
+        Column column;
+        if (name.kind != Token::Kind::IDENTIFIER || !lookupColumn(name.text, column)) {
+            return fail("Expected a column name, got '" + std::string(name.text) + "'");
+        }
+        ++m_position;
+
+        using OperatorName = std::pair<std::string_view, Op>;
+        static constexpr OperatorName kOperators[] = {{"==", Op::EQ}, {"!=", Op::NE}, {"<", Op::LT},
+                                                      {"<=", Op::LE}, {">", Op::GT},  {">=", Op::GE}};
+        const auto op = std::ranges::find(kOperators, m_tokens[m_position].text, &OperatorName::first);
+        if (m_tokens[m_position].kind != Token::Kind::SYMBOL || op == std::end(kOperators)) {
+            return fail("Expected a comparison after '" + std::string(name.text) + "'");
+        }
+        ++m_position;
+
+        Instruction instruction;
+        instruction.kind = Instruction::Kind::COMPARE;
+        instruction.column = column;
+        instruction.op = op->second;
+        if (!parseLiteral(column, instruction)) {
+            return false;
+        }
+        if (column == Column::DISTANCE) {
+            // Distances are compared squared; none is negative, so every negative literal behaves like -1
+            instruction.number = instruction.number < 0.0 ? -1.0 : instruction.number * instruction.number;
+        }
+
+        m_query.m_usesHealthPct |= column == Column::HEALTH_PCT;
+        m_query.m_usesDistance |= column == Column::DISTANCE;
+        return push(instruction);
+    }
+
+    bool parseLiteral(Column column, Instruction& instruction) {
+        const bool negative = accept("-");
+        const Token& token = m_tokens[m_position];
+
+        if (token.kind == Token::Kind::IDENTIFIER && !negative) {
+            ObjectType type;
+            if (column != Column::TYPE || !lookupType(token.text, type)) {
+                return fail("Unexpected name '" + std::string(token.text) + "'");
+            }
+            instruction.integer = static_cast<uint64_t>(type);
+            instruction.number = static_cast<double>(instruction.integer);
+            ++m_position;
+            return true;
+        }
+        if (token.kind != Token::Kind::NUMBER) {
+            return fail("Expected a number");
+        }
+
+        const std::string literal(token.text);
+        const bool hex = literal.size() > 2 && literal[0] == '0' && (literal[1] == 'x' || literal[1] == 'X');
+        char* end = nullptr;
+        if (column == Column::GUID || column == Column::TARGET) {
+            // GUIDs compare exactly as 64-bit integers, which no fraction, exponent or sign can express
+            errno = 0;
+            instruction.integer = std::strtoull(literal.c_str() + (hex ? 2 : 0), &end, hex ? 16 : 10);
+            instruction.number = static_cast<double>(instruction.integer);
+            if (negative || end != literal.c_str() + literal.size() || errno == ERANGE) {
+                const std::string shown = negative ? "-" + literal : literal;
+                return fail("Expected a non-negative 64-bit integer GUID, got '" + shown + "'");
+            }
+            ++m_position;
+            return true;
+        }
+        if (hex) {
+            instruction.integer = std::strtoull(literal.c_str() + 2, &end, 16);
+            instruction.number = static_cast<double>(instruction.integer);
+        } else {
+            instruction.number = std::strtod(literal.c_str(), &end);
+            instruction.integer = instruction.number >= 0.0 ? static_cast<uint64_t>(instruction.number) : 0;
+        }
+        if (end != literal.c_str() + literal.size()) {
+            return fail("Invalid number '" + literal + "'");
+        }
+
+        if (negative) {
+            instruction.number = -instruction.number;
+            instruction.integer = 0;
+        }
+        ++m_position;
+        return true;
+    }
+
+    bool parseProjection() {
+        m_query.m_projection = 0;
+        do {
+            const Token& token = m_tokens[m_position];
+            if (token.kind == Token::Kind::SYMBOL && token.text == "*") {
+                m_query.m_projection = ~0u;
+            } else if (token.kind == Token::Kind::IDENTIFIER) {
+                uint32_t field = 0;
+                if (!lookupField(token.text, field)) {
+                    // Appended in place: GCC 12 reports a false -Wrestrict on the temporary chain
+                    std::string message = "'";
+                    message += token.text;
+                    message += "' cannot be projected";
+                    return fail(message);
+                }
+                m_query.m_projection |= field;
+            } else {
+                return fail("Expected a field name");
+            }
+            ++m_position;
+        } while (accept(","));
+        return true;
+    }
+
+    static bool lookupColumn(std::string_view name, Column& column) {
+        static constexpr std::pair<std::string_view, Column> kColumns[] = {
+            {"guid", Column::GUID},
+            {"type", Column::TYPE},
+            {"base", Column::BASE_ADDRESS},
+            {"x", Column::X},
+            {"y", Column::Y},
+            {"z", Column::Z},
+            {"facing", Column::FACING},
+            {"hp", Column::HEALTH},
+            {"max_hp", Column::MAX_HEALTH},
+            {"hp_pct", Column::HEALTH_PCT},
+            {"level", Column::LEVEL},
+            {"target", Column::TARGET},
+            {"dist", Column::DISTANCE}};
+        const auto it = std::ranges::find(kColumns, name, &std::pair<std::string_view, Column>::first);
+        if (it == std::end(kColumns)) {
+            return false;
+        }
+        column = it->second;
+        return true;
+    }
+
+    static bool lookupType(std::string_view name, ObjectType& type) {
+        static constexpr std::pair<std::string_view, ObjectType> kTypes[] = {
+            {"ITEM", ObjectType::ITEM},
+            {"CONTAINER", ObjectType::CONTAINER},
+            {"UNIT", ObjectType::UNIT},
+            {"PLAYER", ObjectType::PLAYER},
+            {"GAMEOBJECT", ObjectType::GAMEOBJECT},
+            {"DYNAMICOBJECT", ObjectType::DYNAMICOBJECT},
+            {"CORPSE", ObjectType::CORPSE}};
+        const auto it = std::ranges::find(kTypes, name, &std::pair<std::string_view, ObjectType>::first);
+        if (it == std::end(kTypes)) {
+            return false;
+        }
+        type = it->second;
+        return true;
+    }
+
+    static bool lookupField(std::string_view name, uint32_t& field) {
+        // GUID and type are always present in a result row
+        static constexpr std::pair<std::string_view, uint32_t> kFields[] = {
+            {"guid", 0},
+            {"type", 0},
+            {"base", OBJECT_FIELD_BASE_ADDRESS},
+            {"pos", OBJECT_FIELD_POSITION},
+            {"facing", OBJECT_FIELD_FACING},
+            {"hp", OBJECT_FIELD_HEALTH},
+            {"max_hp", OBJECT_FIELD_MAX_HEALTH},
+            {"level", OBJECT_FIELD_LEVEL},
+            {"target", OBJECT_FIELD_TARGET}};
+        const auto it = std::ranges::find(kFields, name, &std::pair<std::string_view, uint32_t>::first);
+        if (it == std::end(kFields)) {
+            return false;
+        }
+        field = it->second;
+        return true;
+    }
+
+    bool peek(std::string_view symbol) const {
+        const Token& token = m_tokens[m_position];
+        return token.kind == Token::Kind::SYMBOL && token.text == symbol;
+    }
+
+    bool accept(std::string_view symbol) {
+        if (!peek(symbol)) {
+            return false;
+        }
+        ++m_position;
+        return true;
+    }
+
+    bool emit(Instruction::Kind kind) {
+        Instruction instruction;
+        instruction.kind = kind;
+        return push(instruction);
+    }
+
+    bool push(const Instruction& instruction) {
+        if (m_query.m_program.size() >= kMaxInstructions) {
+            return fail("Query too complex (max " + std::to_string(kMaxInstructions) + " operations)");
+        }
+        m_query.m_program.push_back(instruction);
+
+        // Track the evaluation stack: a comparison pushes a mask, AND/OR combine two into one
+        if (instruction.kind == Instruction::Kind::COMPARE) {
+            m_query.m_stackDepth = std::max(m_query.m_stackDepth, ++m_depth);
+        } else if (instruction.kind != Instruction::Kind::NOT) {
+            --m_depth;
+        }
+        return true;
+    }
+
+    bool fail(const std::string& message) {
+        if (m_error.empty()) {
+            m_error = message;
+        }
+        return false;
+    }
+
+    const std::vector<Token>& m_tokens;
+    size_t m_position{0};
+    size_t m_depth{0};
+    ObjectQuery& m_query;
+    std::string& m_error;
+};
+
+std::optional<ObjectQuery> ObjectQuery::compile(std::string_view text, std::string& error) {
+    error.clear();
+    if (text.size() > kMaxQueryLength) {
+        error = "Query too long (max " + std::to_string(kMaxQueryLength) + " characters)";
+        return std::nullopt;
+    }
+
+    std::vector<Token> tokens;
+    if (!tokenize(text, tokens, error)) {
+        return std::nullopt;
+    }
+
+    ObjectQuery query;
+    Parser parser(tokens, query, error);
+    if (!parser.parse()) {
+        return std::nullopt;
+    }
+    return query;
+}
+
+void ObjectQuery::select(const ObjectTable& table, std::vector<size_t>& rows) const {
+    const size_t count = table.size();
+    rows.clear();
+
+    if (m_program.empty()) {
+        rows.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            rows[i] = i;
+        }
+        return;
+    }
+
+    // Derived columns, materialized only when the filter references them
+    std::vector<float> healthPct;
+    if (m_usesHealthPct) {
+        healthPct.resize(count);
+        computeHealthPct(table.health.data(), table.maxHealth.data(), count, healthPct.data());
+    }
+
+    // Squared, so the loop needs no sqrt (which keeps errno semantics and does not vectorize everywhere)
+    std::vector<float> distance;
+    if (m_usesDistance) {
+        distance.assign(count, INFINITY);
+        if (const auto self = table.find(table.localPlayerGuid)) {
+            const float px = table.x[*self];
+            const float py = table.y[*self];
+            const float pz = table.z[*self];
+            for (size_t i = 0; i < count; ++i) {
+                const float dx = table.x[i] - px;
+                const float dy = table.y[i] - py;
+                const float dz = table.z[i] - pz;
+                distance[i] = dx * dx + dy * dy + dz * dz;
+            }
+        }
+    }
+
+    // Mask stack in one buffer, left uninitialized because every comparison overwrites its whole slot
+    const std::unique_ptr<uint8_t[]> masks(new uint8_t[m_stackDepth * count]);
+    size_t depth = 0;
+
+    for (const auto& instruction : m_program) {
+        switch (instruction.kind) {
+            case Instruction::Kind::COMPARE: {
+                uint8_t* out = masks.get() + depth++ * count;
+                const float number = static_cast<float>(instruction.number);
+                switch (instruction.column) {
+                    case Column::GUID:
+                        compareColumn(table.guid.data(), count, instruction.op, instruction.integer, out);
+                        break;
+                    case Column::TARGET:
+                        compareColumn(table.targetGuid.data(), count, instruction.op, instruction.integer, out);
+                        break;
+                    case Column::TYPE:
+                        compareIntegerColumn(reinterpret_cast<const uint8_t*>(table.type.data()), count,
+                                             instruction.op, instruction.number, out);
+                        break;
+                    case Column::BASE_ADDRESS:
+                        compareIntegerColumn(table.baseAddress.data(), count, instruction.op, instruction.number, out);
+                        break;
+                    case Column::X:
+                        compareColumn(table.x.data(), count, instruction.op, number, out);
+                        break;
+                    case Column::Y:
+                        compareColumn(table.y.data(), count, instruction.op, number, out);
+                        break;
+                    case Column::Z:
+                        compareColumn(table.z.data(), count, instruction.op, number, out);
+                        break;
+                    case Column::FACING:
+                        compareColumn(table.facing.data(), count, instruction.op, number, out);
+                        break;
+                    case Column::HEALTH:
+                        compareIntegerColumn(table.health.data(), count, instruction.op, instruction.number, out);
+                        break;
+                    case Column::MAX_HEALTH:
+                        compareIntegerColumn(table.maxHealth.data(), count, instruction.op, instruction.number, out);
+                        break;
+                    case Column::LEVEL:
+                        compareIntegerColumn(table.level.data(), count, instruction.op, instruction.number, out);
+                        break;
+                    case Column::HEALTH_PCT:
+                        compareColumn(healthPct.data(), count, instruction.op, number, out);
+                        break;
+                    case Column::DISTANCE:
+                        compareColumn(distance.data(), count, instruction.op, number, out);
+                        break;
+                }
+                break;
+            }
+
+            case Instruction::Kind::AND:
+            case Instruction::Kind::OR: {
+                --depth;
+                uint8_t* left = masks.get() + (depth - 1) * count;
+                const uint8_t* other = masks.get() + depth * count;
+                if (instruction.kind == Instruction::Kind::AND) {
+                    for (size_t i = 0; i < count; ++i) {
+                        left[i] &= other[i];
+                    }
+                } else {
+                    for (size_t i = 0; i < count; ++i) {
+                        left[i] |= other[i];
+                    }
+                }
+                break;
+            }
+
+            case Instruction::Kind::NOT: {
+                uint8_t* mask = masks.get() + (depth - 1) * count;
+                for (size_t i = 0; i < count; ++i) {
+                    mask[i] ^= 1;
+                }
+                break;
+            }
+        }
+    }
+
+    // Branch-free compaction, skipping eight rows at a time where none matched (the common case for a filter)
+    const uint8_t* result = masks.get();
+    rows.resize(count);
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 8 == 0 && i + 8 <= count) {
+            uint64_t word;
+            std::memcpy(&word, result + i, sizeof(word));
+            if (word == 0) {
+                i += 7;
+                continue;
+            }
+        }
+        rows[matched] = i;
+        matched += result[i];
+    }
+    rows.resize(matched);
+}
+
+} // namespace icecap::agent::core
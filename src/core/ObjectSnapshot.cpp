@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include <icecap/agent/core/ObjectSnapshot.hpp>
+
+namespace icecap::agent::core {
+
+namespace {
+
+// Bitwise, so a NaN column that did not change compares equal
+template <typename T>
+bool sameColumn(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+bool sameRows(const ObjectTable& a, const ObjectTable& b) {
+    return sameColumn(a.guid, b.guid) && sameColumn(a.type, b.type) && sameColumn(a.baseAddress, b.baseAddress) &&
+           sameColumn(a.x, b.x) && sameColumn(a.y, b.y) && sameColumn(a.z, b.z) && sameColumn(a.facing, b.facing) &&
+           sameColumn(a.health, b.health) && sameColumn(a.maxHealth, b.maxHealth) && sameColumn(a.level, b.level) &&
+           sameColumn(a.targetGuid, b.targetGuid) && a.localPlayerGuid == b.localPlayerGuid;
+}
+
+void appendRow(ObjectTable& table, const ObjectTable& source, size_t row) {
+    table.guid.push_back(source.guid[row]);
+    table.type.push_back(source.type[row]);
+    table.baseAddress.push_back(source.baseAddress[row]);
+    table.x.push_back(source.x[row]);
+    table.y.push_back(source.y[row]);
+    table.z.push_back(source.z[row]);
+    table.facing.push_back(source.facing[row]);
+    table.health.push_back(source.health[row]);
+    table.maxHealth.push_back(source.maxHealth[row]);
+    table.level.push_back(source.level[row]);
+    table.targetGuid.push_back(source.targetGuid[row]);
+}
+
+} // namespace
+
+void ObjectTable::clear() {
+    resize(0);
+    localPlayerGuid = 0;
+}
+
+void ObjectTable::reserve(size_t capacity) {
+    guid.reserve(capacity);
+    type.reserve(capacity);
+    baseAddress.reserve(capacity);
+    x.reserve(capacity);
+    y.reserve(capacity);
+    z.reserve(capacity);
+    facing.reserve(capacity);
+    health.reserve(capacity);
+    maxHealth.reserve(capacity);
+    level.reserve(capacity);
+    targetGuid.reserve(capacity);
+}
+
+void ObjectTable::resize(size_t count) {
+    guid.resize(count);
+    type.resize(count);
+    baseAddress.resize(count);
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    facing.resize(count);
+    health.resize(count);
+    maxHealth.resize(count);
+    level.resize(count);
+    targetGuid.resize(count);
+}
+
+std::optional<size_t> ObjectTable::find(uint64_t objectGuid) const {
+    auto it = std::ranges::lower_bound(guid, objectGuid);
+    if (it == guid.end() || *it != objectGuid) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(it - guid.begin());
+}
+
+void ObjectSnapshotEngine::enable(uint32_t intervalFrames, uint32_t typeMask, float positionEpsilon) {
+    m_enabled = true;
+    m_intervalFrames = std::max<uint32_t>(intervalFrames, 1);
+    m_typeMask = typeMask == 0 ? kDefaultTypeMask : typeMask;
+    m_positionEpsilon = std::isnan(positionEpsilon) ? 0.0f : std::max(positionEpsilon, 0.0f);
+    m_nextDueFrame = 0;
+    m_reported.clear();
+}
+
+void ObjectSnapshotEngine::disable() {
+    m_enabled = false;
+    m_intervalFrames = 1;
+    m_typeMask = kDefaultTypeMask;
+    m_positionEpsilon = 0.0f;
+    m_nextDueFrame = 0;
+    m_reported.clear();
+}
+
+bool ObjectSnapshotEngine::update(uint64_t frameNumber, const interfaces::IMemoryReader& memory, ObjectDelta& delta) {
+    // The table is exact on every frame; only the delta waits for its interval
+    m_captureFrame = frameNumber;
+    refresh(memory);
+
+    if (!m_enabled || frameNumber < m_nextDueFrame) {
+        return false;
+    }
+    m_nextDueFrame = frameNumber + m_intervalFrames;
+
+    delta.clear();
+    diff(delta);
+    return true;
+}
+
+void ObjectSnapshotEngine::capture(const interfaces::IMemoryReader& memory, ObjectDelta& delta) {
+    refresh(memory);
+
+    delta.clear();
+    diff(delta);
+}
+
+void ObjectSnapshotEngine::refresh(const interfaces::IMemoryReader& memory) {
+    walk(memory);
+
+    std::swap(m_previous, m_current);
+    sortScratch();
+
+    if (!sameRows(m_previous, m_current)) {
+        ++m_version;
+    }
+}
+
+uint64_t ObjectSnapshotEngine::readLocalPlayerGuid(const interfaces::IMemoryReader& memory) {
+    uint64_t localGuid = 0;
+    const uint32_t manager = readObjectManager(memory);
+    if (manager == 0 || !memory.readValue(manager + Offsets::kLocalGuid, localGuid)) {
+        return 0;
+    }
+    return localGuid;
+}
+
+uint32_t ObjectSnapshotEngine::findObjectAddress(const interfaces::IMemoryReader& memory, uint64_t objectGuid) {
+    const uint32_t manager = readObjectManager(memory);
+    uint32_t object = 0;
+    if (manager == 0 || objectGuid == 0 || !memory.readValue(manager + Offsets::kFirstObject, object)) {
+        return 0;
+    }
+
+    for (size_t visited = 0; object != 0 && (object & 1) == 0 && visited < kMaxObjects; ++visited) {
+        uint64_t guid = 0;
+        if (!memory.readValue(object + Offsets::kObjectGuid, guid)) {
+            return 0;
+        }
+        if (guid == objectGuid) {
+            return object;
+        }
+        if (!memory.readValue(object + Offsets::kNextObject, object)) {
+            return 0;
+        }
+    }
+    return 0;
+}
+
+uint32_t ObjectSnapshotEngine::readObjectManager(const interfaces::IMemoryReader& memory) {
+    // Outside the world (login screen, loading) there is no object manager
+    uint32_t connection = 0;
+    uint32_t manager = 0;
+    if (!memory.readValue(Offsets::kClientConnection, connection) || connection == 0 ||
+        !memory.readValue(connection + Offsets::kObjectManager, manager)) {
+        return 0;
+    }
+    return manager;
+}
+
+void ObjectSnapshotEngine::walk(const interfaces::IMemoryReader& memory) {
+    m_scratch.clear();
+
+    // Without an object manager the snapshot is empty
+    const uint32_t manager = readObjectManager(memory);
+    if (manager == 0) {
+        return;
+    }
+
+    memory.readValue(manager + Offsets::kLocalGuid, m_scratch.localPlayerGuid);
+
+    uint32_t object = 0;
+    if (!memory.readValue(manager + Offsets::kFirstObject, object)) {
+        return;
+    }
+
+    // The list ends on a null or tagged (odd) pointer; the object cap guards against corrupt links
+    for (size_t visited = 0; object != 0 && (object & 1) == 0 && visited < kMaxObjects; ++visited) {
+        uint32_t rawType = 0;
+        uint64_t objectGuid = 0;
+        if (!memory.readValue(object + Offsets::kObjectType, rawType) ||
+            !memory.readValue(object + Offsets::kObjectGuid, objectGuid)) {
+            break;
+        }
+
+        // The subscription can add types to the table but never takes the default ones away
+        if (rawType < 32 && ((kDefaultTypeMask | m_typeMask) & (1u << rawType)) != 0) {
+            readObject(memory, object, static_cast<ObjectType>(rawType), objectGuid);
+        }
+
+        if (!memory.readValue(object + Offsets::kNextObject, object)) {
+            break;
+        }
+    }
+}
+
+void ObjectSnapshotEngine::readObject(const interfaces::IMemoryReader& memory, uint32_t object, ObjectType type,
+                                      uint64_t objectGuid) {
+    float position[3] = {0.0f, 0.0f, 0.0f};
+    float facing = 0.0f;
+    uint32_t health = 0;
+    uint32_t maxHealth = 0;
+    uint32_t level = 0;
+    uint64_t targetGuid = 0;
+
+    if (type == ObjectType::UNIT || type == ObjectType::PLAYER) {
+        // Position and facing share one read
+        float movement[(Offsets::kUnitFacing - Offsets::kUnitPosition) / sizeof(float) + 1] = {};
+        if (memory.read(object + Offsets::kUnitPosition, movement, sizeof(movement))) {
+            std::copy_n(movement, 3, position);
+            facing = movement[std::size(movement) - 1];
+        }
+
+        uint32_t descriptors = 0;
+        if (memory.readValue(object + Offsets::kObjectDescriptors, descriptors) && descriptors != 0) {
+            memory.readValue(descriptors + Offsets::kUnitTarget, targetGuid);
+            memory.readValue(descriptors + Offsets::kUnitHealth, health);
+            memory.readValue(descriptors + Offsets::kUnitMaxHealth, maxHealth);
+            memory.readValue(descriptors + Offsets::kUnitLevel, level);
+        }
+    } else if (type == ObjectType::GAMEOBJECT) {
+        memory.read(object + Offsets::kGameObjectPosition, position, sizeof(position));
+    }
+
+    m_scratch.guid.push_back(objectGuid);
+    m_scratch.type.push_back(type);
+    m_scratch.baseAddress.push_back(object);
+    // The game stores (Y, X, Z) relative to the contract
+    m_scratch.x.push_back(position[1]);
+    m_scratch.y.push_back(position[0]);
+    m_scratch.z.push_back(position[2]);
+    m_scratch.facing.push_back(facing);
+    m_scratch.health.push_back(health);
+    m_scratch.maxHealth.push_back(maxHealth);
+    m_scratch.level.push_back(level);
+    m_scratch.targetGuid.push_back(targetGuid);
+}
+
+void ObjectSnapshotEngine::sortScratch() {
+    const size_t count = m_scratch.size();
+
+    m_order.resize(count);
+    std::iota(m_order.begin(), m_order.end(), 0u);
+    std::ranges::sort(m_order, {}, [this](uint32_t row) { return m_scratch.guid[row]; });
+
+    m_current.resize(count);
+    m_current.localPlayerGuid = m_scratch.localPlayerGuid;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t row = m_order[i];
+        m_current.guid[i] = m_scratch.guid[row];
+        m_current.type[i] = m_scratch.type[row];
+        m_current.baseAddress[i] = m_scratch.baseAddress[row];
+        m_current.x[i] = m_scratch.x[row];
+        m_current.y[i] = m_scratch.y[row];
+        m_current.z[i] = m_scratch.z[row];
+        m_current.facing[i] = m_scratch.facing[row];
+        m_current.health[i] = m_scratch.health[row];
+        m_current.maxHealth[i] = m_scratch.maxHealth[row];
+        m_current.level[i] = m_scratch.level[row];
+        m_current.targetGuid[i] = m_scratch.targetGuid[row];
+    }
+}
+
+void ObjectSnapshotEngine::diff(ObjectDelta& delta) {
+    const ObjectTable& before = m_reported;
+    const ObjectTable& after = m_current;
+    m_nextReported.resize(0);
+
+    // Both tables are sorted by GUID, so a single merge pass classifies every row
+    size_t i = 0;
+    size_t j = 0;
+    while (i < before.size() || j < after.size()) {
+        // Rows of types outside the subscription are in the table but never reported
+        if (j < after.size() && (m_typeMask & (1u << static_cast<uint32_t>(after.type[j]))) == 0) {
+            ++j;
+            continue;
+        }
+        if (j == after.size() || (i < before.size() && before.guid[i] < after.guid[j])) {
+            delta.despawned.push_back(before.guid[i++]);
+            continue;
+        }
+
+        appendRow(m_nextReported, after, j);
+        if (i == before.size() || after.guid[j] < before.guid[i]) {
+            delta.spawned.push_back(j++);
+            continue;
+        }
+
+        uint32_t changed = 0;
+        if (before.baseAddress[i] != after.baseAddress[j]) {
+            changed |= OBJECT_FIELD_BASE_ADDRESS;
+        }
+        if (std::fabs(before.x[i] - after.x[j]) > m_positionEpsilon ||
+            std::fabs(before.y[i] - after.y[j]) > m_positionEpsilon ||
+            std::fabs(before.z[i] - after.z[j]) > m_positionEpsilon) {
+            changed |= OBJECT_FIELD_POSITION;
+        } else {
+            // Keep the last reported position so slow drift still crosses the epsilon eventually
+            m_nextReported.x.back() = before.x[i];
+            m_nextReported.y.back() = before.y[i];
+            m_nextReported.z.back() = before.z[i];
+        }
+        if (before.facing[i] != after.facing[j]) {
+            changed |= OBJECT_FIELD_FACING;
+        }
+        if (before.health[i] != after.health[j]) {
+            changed |= OBJECT_FIELD_HEALTH;
+        }
+        if (before.maxHealth[i] != after.maxHealth[j]) {
+            changed |= OBJECT_FIELD_MAX_HEALTH;
+        }
+        if (before.level[i] != after.level[j]) {
+            changed |= OBJECT_FIELD_LEVEL;
+        }
+        if (before.targetGuid[i] != after.targetGuid[j]) {
+            changed |= OBJECT_FIELD_TARGET;
+        }
+
+        if (changed != 0) {
+            delta.updated.push_back({j, changed});
+        }
+        ++i;
+        ++j;
+    }
+
+    std::swap(m_reported, m_nextReported);
+}
+
+} // namespace icecap::agent::core
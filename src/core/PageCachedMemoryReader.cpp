@@ -0,0 +1,140 @@
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ICECAP_HAS_SSE2 1
+#endif
+
+#include <icecap/agent/core/PageCachedMemoryReader.hpp>
+
+namespace icecap::agent::core {
+
+namespace {
+
+// Index of the first NUL in data[0, size), or size if there is none
+size_t findTerminator(const char* data, size_t size) {
+    size_t i = 0;
+#ifdef ICECAP_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero));
+        if (mask != 0) {
+            for (int bit = 0; bit < 16; ++bit) {
+                if (mask & (1 << bit)) {
+                    return i + static_cast<size_t>(bit);
+                }
+            }
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i] == '\0') {
+            return i;
+        }
+    }
+    return size;
+}
+
+} // namespace
+
+PageCachedMemoryReader::PageCachedMemoryReader(const interfaces::IMemoryRegionSource& source) : m_source(source) {}
+
+bool PageCachedMemoryReader::read(uintptr_t address, void* out, size_t size) const {
+    if (address == 0 || out == nullptr || address + size < address) {
+        return false;
+    }
+
+    // Every byte must fall inside cached readable ranges before anything is copied
+    for (uintptr_t cursor = address; cursor < address + size;) {
+        cursor = readableEnd(cursor);
+        if (cursor == 0) {
+            return false;
+        }
+    }
+
+    return copy(address, out, size);
+}
+
+bool PageCachedMemoryReader::readString(uintptr_t address, std::string& out, size_t maxLength) const {
+    out.clear();
+    if (address == 0) {
+        return false;
+    }
+
+    char chunk[kStringChunk];
+    while (out.size() < maxLength) {
+        const uintptr_t end = readableEnd(address);
+        if (end == 0) {
+            return !out.empty();
+        }
+
+        // Stay inside the validated range so the copy never touches an unmapped page
+        size_t length = end - address < sizeof(chunk) ? end - address : sizeof(chunk);
+        length = length < maxLength - out.size() ? length : maxLength - out.size();
+        if (!copy(address, chunk, length)) {
+            return !out.empty();
+        }
+
+        const size_t terminator = findTerminator(chunk, length);
+        out.append(chunk, terminator);
+        if (terminator < length) {
+            return true;
+        }
+        address += length;
+    }
+    return true;
+}
+
+void PageCachedMemoryReader::invalidate() const {
+    m_rangeCount = 0;
+    m_nextVictim = 0;
+    m_lastHit = 0;
+    ++m_stats.invalidations;
+}
+
+uintptr_t PageCachedMemoryReader::readableEnd(uintptr_t address) const {
+    // Consecutive reads usually land in the same range, so check the last hit first
+    if (m_lastHit < m_rangeCount && address >= m_ranges[m_lastHit].begin && address < m_ranges[m_lastHit].end) {
+        ++m_stats.hits;
+        return m_ranges[m_lastHit].end;
+    }
+    for (size_t i = 0; i < m_rangeCount; ++i) {
+        if (address >= m_ranges[i].begin && address < m_ranges[i].end) {
+            m_lastHit = i;
+            ++m_stats.hits;
+            return m_ranges[i].end;
+        }
+    }
+
+    ++m_stats.misses;
+    Range range;
+    if (!m_source.queryReadableRegion(address, range.begin, range.end) || address < range.begin ||
+        address >= range.end) {
+        return 0;
+    }
+
+    // Round-robin replacement once the table is full
+    size_t slot = m_rangeCount;
+    if (m_rangeCount < kCachedRanges) {
+        ++m_rangeCount;
+    } else {
+        slot = m_nextVictim;
+        m_nextVictim = (m_nextVictim + 1) % kCachedRanges;
+    }
+    m_ranges[slot] = range;
+    m_lastHit = slot;
+    return range.end;
+}
+
+bool PageCachedMemoryReader::copy(uintptr_t address, void* out, size_t size) const {
+    if (m_source.copy(address, out, size)) {
+        return true;
+    }
+
+    // The memory changed under a cached range: distrust everything we know
+    invalidate();
+    return false;
+}
+
+} // namespace icecap::agent::core
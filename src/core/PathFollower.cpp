@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cmath>
+
+#include <icecap/agent/core/CommandExecutor.hpp>
+#include <icecap/agent/core/PathFollower.hpp>
+#include <icecap/agent/logging.hpp>
+
+namespace icecap::agent::core {
+
+bool PathFollower::start(Path path, std::vector<PathProgress>& progress) {
+    if (path.playerBaseAddress == 0) {
+        LOG_WARN("PathFollower: Invalid player base address (0)");
+        return false;
+    }
+
+    if (path.waypoints.empty() || path.waypoints.size() > kMaxWaypoints) {
+        LOG_WARN("PathFollower: Path must contain between 1 and {} waypoints", kMaxWaypoints);
+        return false;
+    }
+
+    // std::max would carry a NaN through and the path could never arrive
+    if (std::isnan(path.arrivalRadius) || std::isnan(path.precision)) {
+        LOG_WARN("PathFollower: Path arrival radius and precision must be numbers");
+        return false;
+    }
+
+    // Arrival radius can never be tighter than what ClickToMove itself guarantees
+    path.arrivalRadius = std::max(path.arrivalRadius, path.precision);
+    if (path.arrivalRadius <= 0.0f) {
+        LOG_WARN("PathFollower: Path requires a positive arrival radius or precision");
+        return false;
+    }
+
+    if (m_active) {
+        stop("Path replaced", progress);
+    }
+
+    m_path = std::move(path);
+    m_currentIndex = 0;
+    m_lastPlayerPosition.Clear();
+    m_issued = false;
+    m_active = true;
+
+    LOG_DEBUG("PathFollower: Following path '{}' with {} waypoints", m_path.operationId, m_path.waypoints.size());
+    return true;
+}
+
+bool PathFollower::stop(const std::string& reason, std::vector<PathProgress>& progress) {
+    if (!m_active) {
+        return false;
+    }
+
+    PathProgress aborted = makeProgress(PathProgress::Kind::ABORTED, m_lastPlayerPosition);
+    aborted.reason = reason;
+    progress.push_back(std::move(aborted));
+
+    LOG_DEBUG("PathFollower: Path '{}' aborted: {}", m_path.operationId, reason);
+    m_active = false;
+    m_path = Path{};
+    return true;
+}
+
+void PathFollower::update(uint64_t frameNumber, CommandExecutor& executor, const interfaces::IMemoryReader& memory,
+                          std::vector<PathProgress>& progress) {
+    if (!m_active) {
+        return;
+    }
+
+    icecap::agent::v1::Position playerPosition;
+    if (!executor.readUnitPosition(memory, m_path.playerBaseAddress, playerPosition)) {
+        stop("Failed to read player position", progress);
+        return;
+    }
+    m_lastPlayerPosition = playerPosition;
+
+    // Consume every waypoint already inside the arrival radius (horizontal distance)
+    const float radiusSq = m_path.arrivalRadius * m_path.arrivalRadius;
+    while (m_currentIndex < m_path.waypoints.size()) {
+        const auto& target = m_path.waypoints[m_currentIndex];
+        const float dx = target.x() - playerPosition.x();
+        const float dy = target.y() - playerPosition.y();
+        if (dx * dx + dy * dy > radiusSq) {
+            break;
+        }
+
+        progress.push_back(makeProgress(PathProgress::Kind::WAYPOINT_REACHED, playerPosition));
+        ++m_currentIndex;
+        m_issued = false;
+    }
+
+    if (m_currentIndex >= m_path.waypoints.size()) {
+        m_currentIndex = m_path.waypoints.size() - 1;
+        progress.push_back(makeProgress(PathProgress::Kind::COMPLETED, playerPosition));
+        LOG_DEBUG("PathFollower: Path '{}' completed", m_path.operationId);
+        m_active = false;
+        m_path = Path{};
+        return;
+    }
+
+    if (m_issued && frameNumber - m_lastIssuedFrame < kReissueIntervalFrames) {
+        return;
+    }
+
+    if (!executor.executeClickToMove(m_path.playerBaseAddress, m_path.waypoints[m_currentIndex], m_path.action,
+                                     m_path.precision)) {
+        stop("ClickToMove failed", progress);
+        return;
+    }
+
+    m_issued = true;
+    m_lastIssuedFrame = frameNumber;
+}
+
+PathProgress PathFollower::makeProgress(PathProgress::Kind kind, const icecap::agent::v1::Position& position) const {
+    PathProgress result;
+    result.kind = kind;
+    result.operationId = m_path.operationId;
+    result.waypointIndex = static_cast<uint32_t>(m_currentIndex);
+    result.waypointCount = static_cast<uint32_t>(m_path.waypoints.size());
+    result.position = position;
+    return result;
+}
+
+} // namespace icecap::agent::core
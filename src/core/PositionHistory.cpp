@@ -0,0 +1,148 @@
+#include <algorithm>
+
+#include <icecap/agent/core/ObjectSnapshot.hpp>
+#include <icecap/agent/core/PositionHistory.hpp>
+
+namespace icecap::agent::core {
+
+PositionHistory::PositionHistory() {
+    track(kLocalPlayer, kDefaultCapacity);
+}
+
+bool PositionHistory::track(uint64_t guid, uint32_t capacity) {
+    Track* track = findTrack(guid);
+    if (!track) {
+        if (m_tracks.size() >= kMaxTracks) {
+            return false;
+        }
+        m_tracks.emplace_back();
+        track = &m_tracks.back();
+        track->guid = guid;
+    }
+
+    track->ring.assign(std::clamp<uint32_t>(capacity == 0 ? kDefaultCapacity : capacity, 1, kMaxCapacity),
+                       PositionSample{});
+    track->head = 0;
+    track->count = 0;
+    track->address = 0;
+    track->resolvedGuid = 0;
+    track->nextResolveFrame = 0;
+    return true;
+}
+
+bool PositionHistory::untrack(uint64_t guid) {
+    auto it = std::ranges::find(m_tracks, guid, &Track::guid);
+    if (it == m_tracks.end()) {
+        return false;
+    }
+    m_tracks.erase(it);
+    return true;
+}
+
+void PositionHistory::clear() {
+    m_tracks.clear();
+}
+
+void PositionHistory::record(uint64_t frameNumber, int64_t nowMicros, const interfaces::IMemoryReader& memory) {
+    if (m_tracks.empty()) {
+        return;
+    }
+    m_lastFrame = frameNumber;
+    m_lastMicros = nowMicros;
+
+    // Only resolve the local player when a track follows it
+    const bool followsLocal = std::ranges::any_of(m_tracks, [](const Track& t) { return t.guid == kLocalPlayer; });
+    const uint64_t localGuid = followsLocal ? ObjectSnapshotEngine::readLocalPlayerGuid(memory) : 0;
+
+    for (auto& track : m_tracks) {
+        if (!resolve(track, frameNumber, localGuid, memory)) {
+            continue;
+        }
+
+        float position[3];
+        if (!memory.read(track.address + ObjectSnapshotEngine::Offsets::kUnitPosition, position, sizeof(position))) {
+            track.address = 0;
+            continue;
+        }
+
+        // The game stores (Y, X, Z) relative to the contract
+        track.ring[track.head] = PositionSample{frameNumber, nowMicros, position[1], position[0], position[2]};
+        track.head = (track.head + 1) % track.ring.size();
+        track.count = std::min(track.count + 1, track.ring.size());
+    }
+}
+
+bool PositionHistory::query(uint64_t guid, uint64_t windowFrames, uint64_t windowMicros,
+                            std::vector<PositionSample>& samples) const {
+    const Track* track = findTrack(guid);
+    if (!track) {
+        return false;
+    }
+
+    const uint64_t firstFrame = windowFrames == 0 || windowFrames > m_lastFrame ? 0 : m_lastFrame - windowFrames + 1;
+    const int64_t firstMicros = windowMicros == 0 || windowMicros > static_cast<uint64_t>(INT64_MAX)
+                                    ? INT64_MIN
+                                    : m_lastMicros - static_cast<int64_t>(windowMicros);
+    const size_t capacity = track->ring.size();
+    const size_t oldest = (track->head + capacity - track->count) % capacity;
+
+    samples.clear();
+    samples.reserve(track->count);
+    for (size_t i = 0; i < track->count; ++i) {
+        const auto& sample = track->ring[(oldest + i) % capacity];
+        if (sample.frameNumber >= firstFrame && sample.timestampMicros >= firstMicros) {
+            samples.push_back(sample);
+        }
+    }
+    return true;
+}
+
+PositionHistory::Track* PositionHistory::findTrack(uint64_t guid) {
+    auto it = std::ranges::find(m_tracks, guid, &Track::guid);
+    return it == m_tracks.end() ? nullptr : &*it;
+}
+
+const PositionHistory::Track* PositionHistory::findTrack(uint64_t guid) const {
+    auto it = std::ranges::find(m_tracks, guid, &Track::guid);
+    return it == m_tracks.end() ? nullptr : &*it;
+}
+
+bool PositionHistory::resolve(Track& track, uint64_t frameNumber, uint64_t localGuid,
+                              const interfaces::IMemoryReader& memory) {
+    const uint64_t target = track.guid == kLocalPlayer ? localGuid : track.guid;
+    if (target == 0) {
+        track.address = 0;
+        return false;
+    }
+
+    // A different character behind the local player alias starts a fresh history
+    if (target != track.resolvedGuid) {
+        track.resolvedGuid = target;
+        track.address = 0;
+        track.head = 0;
+        track.count = 0;
+        track.nextResolveFrame = 0;
+    }
+
+    // The cached address stays valid while it still holds the same GUID
+    if (track.address != 0) {
+        uint64_t guid = 0;
+        if (memory.readValue(track.address + ObjectSnapshotEngine::Offsets::kObjectGuid, guid) && guid == target) {
+            return true;
+        }
+        track.address = 0;
+    }
+
+    if (frameNumber < track.nextResolveFrame) {
+        return false;
+    }
+
+    track.address = ObjectSnapshotEngine::findObjectAddress(memory, target);
+    if (track.address == 0) {
+        track.nextResolveFrame = frameNumber + kResolveRetryFrames;
+        return false;
+    }
+    return true;
+}
+
+} // namespace icecap::agent::core
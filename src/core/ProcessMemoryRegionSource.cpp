@@ -0,0 +1,116 @@
+#include <windows.h>
+
+#include <csetjmp>
+#include <cstring>
+
+#include <icecap/agent/core/ProcessMemoryRegionSource.hpp>
+
+namespace icecap::agent::core {
+
+namespace {
+
+constexpr DWORD kReadableProtection = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ |
+                                      PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+
+#ifdef _MSC_VER
+// Kept free of C++ objects so it can use __try
+bool guardedMemcpy(void* out, const void* source, size_t size) {
+    __try {
+        std::memcpy(out, source, size);
+        return true;
+    } __except (EXCEPTION_EXECUTE_HANDLER) {
+        return false;
+    }
+}
+#else
+// No __try outside MSVC. While a guarded copy runs on a thread, its recovery point sits in a TLS slot and an access
+// violation is redirected by the vectored handler to recoverFromFault, which longjmps out of the copy once the
+// dispatcher has returned. Win32 TLS rather than thread_local: emulated TLS may allocate on first access, which is
+// not safe on a thread that faulted somewhere else entirely.
+struct RecoverySlot {
+    DWORD index{TlsAlloc()};
+
+    ~RecoverySlot() {
+        if (index != TLS_OUT_OF_INDEXES) {
+            TlsFree(index);
+        }
+    }
+} g_recoverySlot;
+
+[[noreturn]] void recoverFromFault() {
+    std::longjmp(*static_cast<std::jmp_buf*>(TlsGetValue(g_recoverySlot.index)), 1);
+}
+
+LONG CALLBACK redirectCopyFault(PEXCEPTION_POINTERS exception) {
+    if (exception->ExceptionRecord->ExceptionCode != EXCEPTION_ACCESS_VIOLATION ||
+        TlsGetValue(g_recoverySlot.index) == nullptr) {
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+#if defined(_WIN64)
+    exception->ContextRecord->Rip = reinterpret_cast<DWORD64>(&recoverFromFault);
+#else
+    exception->ContextRecord->Eip = reinterpret_cast<DWORD>(&recoverFromFault);
+#endif
+    return EXCEPTION_CONTINUE_EXECUTION;
+}
+
+bool guardedMemcpy(void* out, const void* source, size_t size) {
+    std::jmp_buf recovery;
+    if (setjmp(recovery) != 0) {
+        TlsSetValue(g_recoverySlot.index, nullptr);
+        return false;
+    }
+    TlsSetValue(g_recoverySlot.index, &recovery);
+    std::memcpy(out, source, size);
+    TlsSetValue(g_recoverySlot.index, nullptr);
+    return true;
+}
+#endif
+
+} // namespace
+
+ProcessMemoryRegionSource::ProcessMemoryRegionSource() {
+#ifndef _MSC_VER
+    // First in the chain so the game's own handlers never see a fault raised by a guarded copy
+    if (g_recoverySlot.index != TLS_OUT_OF_INDEXES) {
+        m_faultHandler = AddVectoredExceptionHandler(1, redirectCopyFault);
+    }
+#endif
+}
+
+ProcessMemoryRegionSource::~ProcessMemoryRegionSource() {
+    if (m_faultHandler != nullptr) {
+        RemoveVectoredExceptionHandler(m_faultHandler);
+    }
+}
+
+bool ProcessMemoryRegionSource::queryReadableRegion(uintptr_t address, uintptr_t& begin, uintptr_t& end) const {
+    MEMORY_BASIC_INFORMATION info{};
+    if (address == 0 || VirtualQuery(reinterpret_cast<LPCVOID>(address), &info, sizeof(info)) != sizeof(info)) {
+        return false;
+    }
+
+    if (info.State != MEM_COMMIT || (info.Protect & kReadableProtection) == 0 ||
+        (info.Protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0) {
+        return false;
+    }
+
+    begin = reinterpret_cast<uintptr_t>(info.BaseAddress);
+    end = begin + info.RegionSize;
+    return true;
+}
+
+bool ProcessMemoryRegionSource::copy(uintptr_t address, void* out, size_t size) const {
+#ifdef _MSC_VER
+    return guardedMemcpy(out, reinterpret_cast<const void*>(address), size);
+#else
+    if (m_faultHandler != nullptr) {
+        return guardedMemcpy(out, reinterpret_cast<const void*>(address), size);
+    }
+    SIZE_T bytesRead = 0;
+    return ReadProcessMemory(GetCurrentProcess(), reinterpret_cast<LPCVOID>(address), out, size, &bytesRead) &&
+           bytesRead == size;
+#endif
+}
+
+} // namespace icecap::agent::core
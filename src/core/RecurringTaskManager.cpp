@@ -0,0 +1,144 @@
+#include <algorithm>
+
+#include <icecap/agent/core/CommandExecutor.hpp>
+#include <icecap/agent/core/RecurringTaskManager.hpp>
+#include <icecap/agent/logging.hpp>
+
+namespace icecap::agent::core {
+
+bool RecurringTaskManager::registerTask(const Definition& definition) {
+    if (definition.id.empty() || definition.code.empty()) {
+        LOG_WARN("RecurringTaskManager: Task requires an ID and Lua code");
+        return false;
+    }
+
+    if ((definition.intervalFrames == 0) == (definition.intervalMs == 0)) {
+        LOG_WARN("RecurringTaskManager: Task '{}' must set exactly one of interval_frames / interval_ms",
+                 definition.id);
+        return false;
+    }
+
+    const bool replacing = m_tasks.contains(definition.id);
+    if (!replacing && m_tasks.size() >= kMaxTasks) {
+        LOG_WARN("RecurringTaskManager: Task limit of {} reached", kMaxTasks);
+        return false;
+    }
+
+    if (replacing) {
+        unregisterTask(definition.id);
+    }
+
+    Entry entry;
+    entry.definition = definition;
+    entry.timeBased = definition.intervalMs != 0;
+
+    TimerWheel& wheel = entry.timeBased ? m_timeWheel : m_frameWheel;
+    std::vector<std::string>& owners = entry.timeBased ? m_timeOwners : m_frameOwners;
+
+    entry.timer = wheel.create();
+    if (entry.timer >= owners.size()) {
+        owners.resize(entry.timer + 1);
+    }
+    owners[entry.timer] = definition.id;
+    wheel.schedule(entry.timer, entry.timeBased ? definition.intervalMs : definition.intervalFrames);
+
+    m_tasks.emplace(definition.id, std::move(entry));
+    LOG_DEBUG("RecurringTaskManager: Registered task '{}'", definition.id);
+    return true;
+}
+
+bool RecurringTaskManager::unregisterTask(const std::string& taskId) {
+    auto it = m_tasks.find(taskId);
+    if (it == m_tasks.end()) {
+        return false;
+    }
+
+    if (it->second.timeBased) {
+        m_timeWheel.destroy(it->second.timer);
+        m_timeOwners[it->second.timer].clear();
+    } else {
+        m_frameWheel.destroy(it->second.timer);
+        m_frameOwners[it->second.timer].clear();
+    }
+
+    m_tasks.erase(it);
+    LOG_DEBUG("RecurringTaskManager: Removed task '{}'", taskId);
+
+    // update() is not called while there are no tasks; resync both cursors on the next one
+    if (m_tasks.empty()) {
+        m_started = false;
+    }
+    return true;
+}
+
+void RecurringTaskManager::clear() {
+    m_tasks.clear();
+    m_frameWheel.clear();
+    m_timeWheel.clear();
+    m_frameOwners.clear();
+    m_timeOwners.clear();
+    m_started = false;
+}
+
+void RecurringTaskManager::update(uint64_t frameNumber, uint64_t nowMs, CommandExecutor& executor,
+                                  std::vector<RecurringTaskResult>& results) {
+    if (!m_started) {
+        m_lastFrame = frameNumber;
+        m_lastTimeMs = nowMs;
+        m_started = true;
+        return;
+    }
+
+    // Collect everything that expired since the last frame first, so a task
+    // runs at most once per frame even after a long stall
+    m_expired.clear();
+    catchUp(m_frameWheel, m_lastFrame, frameNumber);
+    fire(m_frameWheel, m_frameOwners, executor, results);
+
+    m_expired.clear();
+    catchUp(m_timeWheel, m_lastTimeMs, nowMs);
+    fire(m_timeWheel, m_timeOwners, executor, results);
+}
+
+void RecurringTaskManager::catchUp(TimerWheel& wheel, uint64_t& last, uint64_t now) {
+    // Past kMaxCatchUpTicks the rest of the gap is skipped, which delays every pending task by the excess
+    const uint64_t ticks = now > last ? std::min<uint64_t>(now - last, kMaxCatchUpTicks) : 0;
+    for (uint64_t i = 0; i < ticks; ++i) {
+        wheel.advance(m_expired);
+    }
+    last = std::max(last, now);
+}
+
+void RecurringTaskManager::fire(TimerWheel& wheel, std::vector<std::string>& owners, CommandExecutor& executor,
+                                std::vector<RecurringTaskResult>& results) {
+    for (const TimerWheel::TimerId timer : m_expired) {
+        auto it = m_tasks.find(owners[timer]);
+        if (it == m_tasks.end()) {
+            continue;
+        }
+
+        Entry& entry = it->second;
+        run(entry, executor, results);
+        wheel.schedule(timer, entry.timeBased ? entry.definition.intervalMs : entry.definition.intervalFrames);
+    }
+}
+
+void RecurringTaskManager::run(Entry& entry, CommandExecutor& executor, std::vector<RecurringTaskResult>& results) {
+    const Definition& definition = entry.definition;
+
+    if (definition.action == Action::READ) {
+        RecurringTaskResult result;
+        result.taskId = definition.id;
+        result.isRead = true;
+        result.success = executor.evaluateLuaExpression(definition.code, result.value, definition.id);
+        results.push_back(std::move(result));
+        return;
+    }
+
+    // Successful executions stay silent; only failures are reported
+    if (!executor.executeLuaCode(definition.code, definition.id)) {
+        results.push_back({definition.id, false, false, ""});
+    }
+}
+
+} // namespace icecap::agent::core
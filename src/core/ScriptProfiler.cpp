@@ -0,0 +1,43 @@
+#include <algorithm>
+
+#include <icecap/agent/core/ScriptProfiler.hpp>
+
+namespace icecap::agent::core {
+
+void ScriptProfiler::onScriptExecuted(const std::string& scriptName, int64_t elapsedMicros) {
+    auto it = m_scripts.find(scriptName);
+    if (it == m_scripts.end()) {
+        const bool full = m_scripts.size() >= kMaxScripts - 1;
+        it = m_scripts.try_emplace(full ? kOtherScripts : scriptName).first;
+        if (!it->second) {
+            it->second = std::make_unique<LatencyHistogram>();
+        }
+    }
+    it->second->record(static_cast<uint64_t>(std::max<int64_t>(elapsedMicros, 0)));
+
+    m_next.onScriptExecuted(scriptName, elapsedMicros);
+}
+
+std::vector<ScriptProfile> ScriptProfiler::top(size_t count) const {
+    std::vector<ScriptProfile> profiles;
+    profiles.reserve(m_scripts.size());
+    for (const auto& [name, histogram] : m_scripts) {
+        const auto summary = histogram->summarize();
+        profiles.push_back({name, summary.count, summary.sumMicros, summary.maxMicros, summary.p99Micros});
+    }
+
+    const auto byTotal = [](const ScriptProfile& a, const ScriptProfile& b) {
+        return a.totalMicros != b.totalMicros ? a.totalMicros > b.totalMicros : a.name < b.name;
+    };
+    count = std::min(count, profiles.size());
+    std::partial_sort(profiles.begin(), profiles.begin() + static_cast<std::ptrdiff_t>(count), profiles.end(),
+                      byTotal);
+    profiles.resize(count);
+    return profiles;
+}
+
+void ScriptProfiler::reset() {
+    m_scripts.clear();
+}
+
+} // namespace icecap::agent::core
@@ -0,0 +1,173 @@
+#include <cctype>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ICECAP_HAS_SSE2 1
+#endif
+
+#include <icecap/agent/core/SignatureScanner.hpp>
+
+namespace icecap::agent::core {
+
+namespace {
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+// Bytes that open or fill most x86 functions make poor filters
+bool isCommonByte(uint8_t value) {
+    switch (value) {
+        case 0x00:
+        case 0xFF:
+        case 0xCC:
+        case 0x8B:
+        case 0x89:
+        case 0x55:
+        case 0xE8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+std::optional<Signature> Signature::parse(std::string_view pattern) {
+    Signature signature;
+
+    size_t i = 0;
+    while (i < pattern.size()) {
+        if (std::isspace(static_cast<unsigned char>(pattern[i]))) {
+            ++i;
+            continue;
+        }
+        if (i + 1 >= pattern.size()) {
+            return std::nullopt;
+        }
+
+        const char high = pattern[i];
+        const char low = pattern[i + 1];
+        if (high == '?' && low == '?') {
+            signature.bytes.push_back(0);
+            signature.mask.push_back(0x00);
+        } else {
+            const int h = hexDigit(high);
+            const int l = hexDigit(low);
+            if (h < 0 || l < 0) {
+                return std::nullopt;
+            }
+            signature.bytes.push_back(static_cast<uint8_t>(h << 4 | l));
+            signature.mask.push_back(0xFF);
+        }
+
+        i += 2;
+        if (i < pattern.size() && !std::isspace(static_cast<unsigned char>(pattern[i]))) {
+            return std::nullopt;
+        }
+    }
+
+    // Anchor on the first and last concrete bytes, preferring ones that are rare in code
+    std::optional<size_t> first;
+    std::optional<size_t> last;
+    for (size_t j = 0; j < signature.size(); ++j) {
+        if (signature.mask[j] == 0) {
+            continue;
+        }
+        if (!first || (isCommonByte(signature.bytes[*first]) && !isCommonByte(signature.bytes[j]))) {
+            first = j;
+        }
+    }
+    for (size_t j = signature.size(); j-- > 0;) {
+        if (signature.mask[j] == 0 || j == first) {
+            continue;
+        }
+        if (!last || (isCommonByte(signature.bytes[*last]) && !isCommonByte(signature.bytes[j]))) {
+            last = j;
+        }
+    }
+
+    if (!first) {
+        return std::nullopt;
+    }
+    signature.firstAnchor = *first;
+    signature.lastAnchor = last.value_or(*first);
+    return signature;
+}
+
+size_t SignatureScanner::find(const uint8_t* data, size_t size, const Signature& signature, size_t start) {
+    const size_t length = signature.size();
+    if (data == nullptr || length == 0 || size < length || start > size - length) {
+        return kNotFound;
+    }
+
+    // Positions [start, end] are candidate match offsets
+    const size_t end = size - length;
+    const uint8_t* first = data + signature.firstAnchor;
+    const uint8_t* last = data + signature.lastAnchor;
+    size_t position = start;
+
+#ifdef ICECAP_HAS_SSE2
+    const __m128i firstByte = _mm_set1_epi8(static_cast<char>(signature.bytes[signature.firstAnchor]));
+    const __m128i lastByte = _mm_set1_epi8(static_cast<char>(signature.bytes[signature.lastAnchor]));
+    for (; end - position >= 16; position += 16) {
+        const __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + position));
+        const __m128i lastBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last + position));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(firstBlock, firstByte), _mm_cmpeq_epi8(lastBlock, lastByte))));
+
+        while (mask != 0) {
+            unsigned bit = 0;
+            while ((mask & (1u << bit)) == 0) {
+                ++bit;
+            }
+            mask &= mask - 1;
+
+            if (matchesAt(data, size, signature, position + bit)) {
+                return position + bit;
+            }
+        }
+    }
+#endif
+
+    for (; position <= end; ++position) {
+        if (first[position] == signature.bytes[signature.firstAnchor] &&
+            last[position] == signature.bytes[signature.lastAnchor] && matchesAt(data, size, signature, position)) {
+            return position;
+        }
+    }
+    return kNotFound;
+}
+
+size_t SignatureScanner::count(const uint8_t* data, size_t size, const Signature& signature, size_t limit) {
+    size_t matches = 0;
+    size_t position = find(data, size, signature);
+    while (position != kNotFound && matches < limit) {
+        ++matches;
+        position = find(data, size, signature, position + 1);
+    }
+    return matches;
+}
+
+bool SignatureScanner::matchesAt(const uint8_t* data, size_t size, const Signature& signature, size_t offset) {
+    const size_t length = signature.size();
+    if (data == nullptr || size < length || offset > size - length) {
+        return false;
+    }
+
+    for (size_t i = 0; i < length; ++i) {
+        if ((data[offset + i] & signature.mask[i]) != signature.bytes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace icecap::agent::core
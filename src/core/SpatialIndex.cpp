@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cmath>
+
+#include <icecap/agent/core/SpatialIndex.hpp>
+
+namespace icecap::agent::core {
+
+SpatialIndex::SpatialIndex() {
+    m_bucketStart.fill(0);
+    m_bucketVisited.fill(0);
+}
+
+void SpatialIndex::build(const ObjectTable& table, uint64_t version) {
+    if (m_table == &table && m_version == version) {
+        return;
+    }
+    m_table = &table;
+    m_version = version;
+
+    const size_t count = table.size();
+    m_rowBucket.resize(count);
+    m_rows.resize(count);
+    m_bucketStart.fill(0);
+
+    // Counting sort: histogram, exclusive prefix sum, scatter
+    for (size_t row = 0; row < count; ++row) {
+        const uint32_t bucket = bucketOf(cellCoordinate(table.x[row]), cellCoordinate(table.y[row]));
+        m_rowBucket[row] = bucket;
+        ++m_bucketStart[bucket + 1];
+    }
+    for (uint32_t bucket = 0; bucket < kBucketCount; ++bucket) {
+        m_bucketStart[bucket + 1] += m_bucketStart[bucket];
+    }
+
+    std::array<uint32_t, kBucketCount> cursor;
+    std::copy_n(m_bucketStart.begin(), kBucketCount, cursor.begin());
+    for (size_t row = 0; row < count; ++row) {
+        m_rows[cursor[m_rowBucket[row]]++] = static_cast<uint32_t>(row);
+    }
+}
+
+void SpatialIndex::queryRadius(float x, float y, float z, float radius, uint32_t typeMask,
+                               std::vector<Neighbor>& results) {
+    results.clear();
+    collect(x, y, z, radius, typeMask, results);
+    std::ranges::sort(results, {}, &Neighbor::distanceSquared);
+}
+
+void SpatialIndex::queryNearest(float x, float y, float z, size_t count, float maxRadius, uint32_t typeMask,
+                                std::vector<Neighbor>& results) {
+    results.clear();
+    if (m_table == nullptr || count == 0) {
+        return;
+    }
+
+    // Grow the search radius until it holds `count` candidates; anything outside the radius
+    // is farther than every candidate inside it, so the closest `count` of them are exact
+    const bool bounded = maxRadius > 0.0f;
+    float radius = bounded ? std::min(kCellSize, maxRadius) : kCellSize;
+    for (;;) {
+        results.clear();
+        collect(x, y, z, radius, typeMask, results);
+
+        const bool exhausted = bounded ? radius >= maxRadius : std::isinf(radius);
+        if (results.size() >= count || exhausted) {
+            break;
+        }
+
+        // Once an unbounded search would scan the whole table anyway, do it once and stop
+        const float next = radius * 2.0f;
+        if (bounded) {
+            radius = std::min(next, maxRadius);
+        } else {
+            radius = scansLinearly(next) ? INFINITY : next;
+        }
+    }
+
+    const size_t kept = std::min(count, results.size());
+    std::ranges::partial_sort(results, results.begin() + static_cast<std::ptrdiff_t>(kept), {},
+                              &Neighbor::distanceSquared);
+    results.resize(kept);
+}
+
+int32_t SpatialIndex::cellCoordinate(float value) {
+    return static_cast<int32_t>(std::floor(value / kCellSize));
+}
+
+uint32_t SpatialIndex::bucketOf(int32_t cellX, int32_t cellY) {
+    const uint32_t hash = static_cast<uint32_t>(cellX) * 0x9E3779B1u ^ static_cast<uint32_t>(cellY) * 0x85EBCA77u;
+    return hash >> (32 - kBucketBits);
+}
+
+bool SpatialIndex::scansLinearly(float radius) {
+    // Decided in floating point since cell coordinates would overflow for huge radii
+    const float span = 2.0f * radius / kCellSize + 2.0f;
+    return !(span * span <= static_cast<float>(kMaxScannedCells));
+}
+
+bool SpatialIndex::accepts(size_t row, uint32_t typeMask) const {
+    return typeMask == 0 || (typeMask & (1u << static_cast<uint32_t>(m_table->type[row]))) != 0;
+}
+
+float SpatialIndex::distanceSquared(size_t row, float x, float y, float z) const {
+    const float dx = m_table->x[row] - x;
+    const float dy = m_table->y[row] - y;
+    const float dz = m_table->z[row] - z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+void SpatialIndex::collect(float x, float y, float z, float radius, uint32_t typeMask,
+                           std::vector<Neighbor>& results) {
+    if (m_table == nullptr || !(radius >= 0.0f)) {
+        return;
+    }
+
+    const float radiusSquared = radius * radius;
+    const auto consider = [&](size_t row) {
+        if (!accepts(row, typeMask)) {
+            return;
+        }
+        const float distance = distanceSquared(row, x, y, z);
+        if (distance <= radiusSquared) {
+            results.push_back({row, distance});
+        }
+    };
+
+    if (scansLinearly(radius)) {
+        for (size_t row = 0; row < m_table->size(); ++row) {
+            consider(row);
+        }
+        return;
+    }
+
+    const int32_t minCellX = cellCoordinate(x - radius);
+    const int32_t maxCellX = cellCoordinate(x + radius);
+    const int32_t minCellY = cellCoordinate(y - radius);
+    const int32_t maxCellY = cellCoordinate(y + radius);
+
+    if (++m_queryGeneration == 0) {
+        m_bucketVisited.fill(0);
+        m_queryGeneration = 1;
+    }
+
+    for (int32_t cellX = minCellX; cellX <= maxCellX; ++cellX) {
+        for (int32_t cellY = minCellY; cellY <= maxCellY; ++cellY) {
+            const uint32_t bucket = bucketOf(cellX, cellY);
+            if (m_bucketVisited[bucket] == m_queryGeneration) {
+                continue;
+            }
+            m_bucketVisited[bucket] = m_queryGeneration;
+
+            for (uint32_t i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; ++i) {
+                consider(m_rows[i]);
+            }
+        }
+    }
+}
+
+} // namespace icecap::agent::core
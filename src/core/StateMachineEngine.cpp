@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <unordered_map>
+
+#include <icecap/agent/core/CommandExecutor.hpp>
+#include <icecap/agent/core/StateMachineEngine.hpp>
+#include <icecap/agent/logging.hpp>
+
+namespace icecap::agent::core {
+
+bool StateMachineEngine::load(const StateMachineDefinition& definition) {
+    if (definition.id.empty() || definition.states.empty() || definition.states.size() > kMaxStates) {
+        LOG_WARN("StateMachineEngine: Machine requires an ID and between 1 and {} states", kMaxStates);
+        return false;
+    }
+
+    Machine machine;
+    machine.id = definition.id;
+    machine.states = definition.states;
+    machine.intervalFrames = std::max<uint32_t>(definition.intervalFrames, 1);
+    machine.transitions.resize(definition.states.size());
+
+    std::unordered_map<std::string, size_t> stateIndex;
+    for (size_t i = 0; i < definition.states.size(); ++i) {
+        const auto& name = definition.states[i].name;
+        if (name.empty() || name == StateMachineDefinition::kAnyState || !stateIndex.emplace(name, i).second) {
+            LOG_WARN("StateMachineEngine: Machine '{}' has an empty, reserved or duplicate state", definition.id);
+            return false;
+        }
+    }
+
+    auto initial = stateIndex.find(definition.initialState);
+    if (initial == stateIndex.end()) {
+        LOG_WARN("StateMachineEngine: Machine '{}' has an unknown initial state", definition.id);
+        return false;
+    }
+    machine.initialState = initial->second;
+
+    for (const auto& transition : definition.transitions) {
+        auto target = stateIndex.find(transition.to);
+        if (target == stateIndex.end() || transition.condition.empty()) {
+            LOG_WARN("StateMachineEngine: Machine '{}' has an invalid transition to '{}'", definition.id,
+                     transition.to);
+            return false;
+        }
+
+        if (transition.from == StateMachineDefinition::kAnyState) {
+            for (size_t state = 0; state < machine.transitions.size(); ++state) {
+                // An any-state transition never re-enters the state it targets
+                if (state != target->second) {
+                    machine.transitions[state].push_back({target->second, transition.condition});
+                }
+            }
+            continue;
+        }
+
+        auto source = stateIndex.find(transition.from);
+        if (source == stateIndex.end()) {
+            LOG_WARN("StateMachineEngine: Machine '{}' has an invalid transition from '{}'", definition.id,
+                     transition.from);
+            return false;
+        }
+        machine.transitions[source->second].push_back({target->second, transition.condition});
+    }
+
+    auto it = std::ranges::find(m_machines, definition.id, &Machine::id);
+    if (it != m_machines.end()) {
+        *it = std::move(machine);
+        LOG_DEBUG("StateMachineEngine: Replaced machine '{}'", definition.id);
+        return true;
+    }
+
+    if (m_machines.size() >= kMaxMachines) {
+        LOG_WARN("StateMachineEngine: Machine limit of {} reached", kMaxMachines);
+        return false;
+    }
+
+    m_machines.push_back(std::move(machine));
+    LOG_DEBUG("StateMachineEngine: Loaded machine '{}'", definition.id);
+    return true;
+}
+
+bool StateMachineEngine::unload(const std::string& machineId) {
+    auto it = std::ranges::find(m_machines, machineId, &Machine::id);
+    if (it == m_machines.end()) {
+        return false;
+    }
+
+    m_machines.erase(it);
+    m_cursor = 0;
+    LOG_DEBUG("StateMachineEngine: Unloaded machine '{}'", machineId);
+    return true;
+}
+
+void StateMachineEngine::clear() {
+    m_machines.clear();
+    m_cursor = 0;
+}
+
+void StateMachineEngine::evaluate(uint64_t frameNumber, CommandExecutor& executor,
+                                  std::vector<StateTransition>& transitions) {
+    if (m_machines.empty()) {
+        return;
+    }
+
+    m_frameStart = std::chrono::steady_clock::now();
+    m_frameLuaCalls = 0;
+    const size_t count = m_machines.size();
+    m_cursor %= count;
+
+    // Start where the previous frame ran out of budget
+    size_t visited = 0;
+    for (; visited < count; ++visited) {
+        Machine& machine = m_machines[(m_cursor + visited) % count];
+        if (frameNumber < machine.nextDueFrame) {
+            continue;
+        }
+        if (!step(machine, frameNumber, executor, transitions)) {
+            break;
+        }
+        machine.nextDueFrame = frameNumber + machine.intervalFrames;
+    }
+
+    if (visited < count) {
+        m_stats.deferredEvaluations += count - visited;
+    }
+    m_cursor = (m_cursor + visited) % count;
+
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_frameStart);
+    m_stats.lastFrameCostUs = static_cast<uint32_t>(elapsed.count());
+    m_stats.maxFrameCostUs = std::max(m_stats.maxFrameCostUs, m_stats.lastFrameCostUs);
+}
+
+bool StateMachineEngine::hasBudget() {
+    // The first Lua call of a frame always runs, so a single expensive condition still makes progress
+    if (m_frameLuaCalls > 0 && std::chrono::steady_clock::now() - m_frameStart >= m_frameBudget) {
+        return false;
+    }
+    ++m_frameLuaCalls;
+    return true;
+}
+
+bool StateMachineEngine::step(Machine& machine, uint64_t frameNumber, CommandExecutor& executor,
+                              std::vector<StateTransition>& transitions) {
+    if (machine.currentState == kNoState) {
+        enterState(machine, machine.initialState, frameNumber, executor, transitions);
+        return !machine.onEnterPending;
+    }
+
+    if (machine.onEnterPending) {
+        if (!hasBudget()) {
+            return false;
+        }
+        runOnEnter(machine, executor);
+    }
+
+    const auto& candidates = machine.transitions[machine.currentState];
+    for (; machine.nextTransition < candidates.size(); ++machine.nextTransition) {
+        if (!hasBudget()) {
+            return false;
+        }
+
+        const auto& transition = candidates[machine.nextTransition];
+        bool holds = false;
+        if (executor.evaluateLuaCondition(transition.condition, holds) && holds) {
+            enterState(machine, transition.target, frameNumber, executor, transitions);
+            return !machine.onEnterPending;
+        }
+    }
+
+    machine.nextTransition = 0;
+    return true;
+}
+
+void StateMachineEngine::enterState(Machine& machine, size_t state, uint64_t frameNumber, CommandExecutor& executor,
+                                    std::vector<StateTransition>& transitions) {
+    StateTransition transition;
+    transition.machineId = machine.id;
+    transition.fromState = machine.currentState == kNoState ? "" : machine.states[machine.currentState].name;
+    transition.toState = machine.states[state].name;
+    transition.frameNumber = frameNumber;
+
+    machine.currentState = state;
+    machine.nextTransition = 0;
+
+    // On-enter code is a Lua call like any condition; without budget it runs first thing next frame
+    machine.onEnterPending = !machine.states[state].onEnter.empty();
+    if (machine.onEnterPending && hasBudget()) {
+        runOnEnter(machine, executor);
+    }
+
+    transition.evaluationTimeUs = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_frameStart)
+            .count());
+    transitions.push_back(std::move(transition));
+}
+
+void StateMachineEngine::runOnEnter(Machine& machine, CommandExecutor& executor) {
+    machine.onEnterPending = false;
+
+    const auto& state = machine.states[machine.currentState];
+    if (!executor.executeLuaCode(state.onEnter, machine.id)) {
+        LOG_WARN("StateMachineEngine: On-enter code failed for state '{}' of machine '{}'", state.name, machine.id);
+    }
+}
+
+} // namespace icecap::agent::core
@@ -0,0 +1,108 @@
+#include <icecap/agent/core/TaskScheduler.hpp>
+#include <icecap/agent/logging.hpp>
+
+namespace icecap::agent::core {
+
+bool TaskScheduler::spawn(const std::string& id, Task task) {
+    if (id.empty() || !task) {
+        LOG_WARN("TaskScheduler: Task requires an ID and a coroutine");
+        return false;
+    }
+
+    if (m_tasks.contains(id)) {
+        LOG_WARN("TaskScheduler: Task '{}' is already running", id);
+        return false;
+    }
+
+    if (m_tasks.size() >= kMaxTasks) {
+        LOG_WARN("TaskScheduler: Task limit of {} reached", kMaxTasks);
+        return false;
+    }
+
+    auto& entry = m_tasks[id];
+    entry.task = std::move(task);
+    schedule(id, entry, 0);
+
+    LOG_DEBUG("TaskScheduler: Spawned task '{}'", id);
+    return true;
+}
+
+bool TaskScheduler::cancel(const std::string& id) {
+    // Destroying the task destroys the suspended coroutine frame; its wake entry goes stale
+    if (m_tasks.erase(id) == 0) {
+        return false;
+    }
+
+    LOG_DEBUG("TaskScheduler: Cancelled task '{}'", id);
+    return true;
+}
+
+void TaskScheduler::clear() {
+    m_tasks.clear();
+    m_wakeQueue = {};
+}
+
+void TaskScheduler::tick(uint64_t frameNumber, std::vector<Failure>& failures) {
+    while (!m_wakeQueue.empty() && m_wakeQueue.top().wakeFrame <= frameNumber) {
+        const WakeEntry wake = m_wakeQueue.top();
+        m_wakeQueue.pop();
+
+        auto it = m_tasks.find(wake.id);
+        if (it == m_tasks.end() || it->second.generation != wake.generation) {
+            continue;
+        }
+
+        auto handle = it->second.task.handle();
+        auto& promise = handle.promise();
+        promise.currentFrame = frameNumber;
+
+        // Poll a pending wait-until condition before paying for a resume
+        if (promise.predicate) {
+            if (promise.predicate()) {
+                promise.waitSatisfied = true;
+            } else if (promise.deadlineFrame != 0 && frameNumber >= promise.deadlineFrame) {
+                promise.waitSatisfied = false;
+            } else {
+                schedule(wake.id, it->second, frameNumber + promise.pollIntervalFrames);
+                continue;
+            }
+            promise.predicate = nullptr;
+        }
+
+        // A task that suspends without an awaitable resumes on the next frame
+        promise.wakeFrame = frameNumber + 1;
+        handle.resume();
+
+        // The coroutine body may have touched the scheduler, so look the task up again
+        it = m_tasks.find(wake.id);
+        if (it == m_tasks.end()) {
+            continue;
+        }
+
+        if (handle.done()) {
+            if (promise.exception) {
+                try {
+                    std::rethrow_exception(promise.exception);
+                } catch (const std::exception& e) {
+                    LOG_ERROR("TaskScheduler: Task '{}' failed: {}", wake.id, e.what());
+                    failures.push_back({wake.id, e.what()});
+                } catch (...) {
+                    LOG_ERROR("TaskScheduler: Task '{}' failed with unknown exception", wake.id);
+                    failures.push_back({wake.id, "Unknown exception"});
+                }
+            }
+            LOG_DEBUG("TaskScheduler: Task '{}' finished", wake.id);
+            m_tasks.erase(it);
+            continue;
+        }
+
+        schedule(wake.id, it->second, promise.wakeFrame);
+    }
+}
+
+void TaskScheduler::schedule(const std::string& id, TaskEntry& entry, uint64_t wakeFrame) {
+    entry.generation = ++m_nextGeneration;
+    m_wakeQueue.push({wakeFrame, entry.generation, id});
+}
+
+} // namespace icecap::agent::core
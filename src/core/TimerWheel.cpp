@@ -0,0 +1,146 @@
+#include <algorithm>
+
+#include <icecap/agent/core/TimerWheel.hpp>
+
+namespace icecap::agent::core {
+
+TimerWheel::TimerWheel() {
+    m_slots.fill(kNoNode);
+}
+
+TimerWheel::TimerId TimerWheel::create() {
+    TimerId timer;
+    if (!m_freeNodes.empty()) {
+        timer = m_freeNodes.back();
+        m_freeNodes.pop_back();
+        m_nodes[timer] = Node{};
+    } else {
+        timer = static_cast<TimerId>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    m_nodes[timer].allocated = true;
+    return timer;
+}
+
+void TimerWheel::destroy(TimerId timer) {
+    if (timer >= m_nodes.size() || !m_nodes[timer].allocated) {
+        return;
+    }
+
+    unlink(timer);
+    m_nodes[timer].allocated = false;
+    m_freeNodes.push_back(timer);
+}
+
+void TimerWheel::schedule(TimerId timer, uint64_t delayTicks) {
+    if (timer >= m_nodes.size() || !m_nodes[timer].allocated) {
+        return;
+    }
+
+    unlink(timer);
+    m_nodes[timer].expiry = m_currentTick + std::clamp<uint64_t>(delayTicks, 1, kMaxDelay);
+    link(timer);
+}
+
+void TimerWheel::cancel(TimerId timer) {
+    if (timer >= m_nodes.size()) {
+        return;
+    }
+
+    unlink(timer);
+}
+
+void TimerWheel::advance(std::vector<TimerId>& expired) {
+    ++m_currentTick;
+
+    // Pull timers from higher levels down whenever a lower level wraps around
+    for (uint32_t level = 1; level < kLevels; ++level) {
+        if ((m_currentTick & ((1ull << (kLevelBits * level)) - 1)) != 0) {
+            break;
+        }
+        cascade(level);
+    }
+
+    const uint32_t slot = static_cast<uint32_t>(m_currentTick & (kSlotsPerLevel - 1));
+    uint32_t node = m_slots[slot];
+    m_slots[slot] = kNoNode;
+
+    while (node != kNoNode) {
+        const uint32_t next = m_nodes[node].next;
+        m_nodes[node].linked = false;
+        m_nodes[node].prev = kNoNode;
+        m_nodes[node].next = kNoNode;
+        expired.push_back(node);
+        node = next;
+    }
+}
+
+void TimerWheel::clear() {
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_slots.fill(kNoNode);
+    m_currentTick = 0;
+}
+
+void TimerWheel::link(TimerId timer) {
+    Node& node = m_nodes[timer];
+    const uint64_t delta = node.expiry > m_currentTick ? node.expiry - m_currentTick : 0;
+
+    // Pick the lowest level whose span covers the remaining delay
+    uint32_t level = 0;
+    while (level + 1 < kLevels && delta >= (1ull << (kLevelBits * (level + 1)))) {
+        ++level;
+    }
+
+    const uint64_t expiry = std::max(node.expiry, m_currentTick);
+    const uint32_t index =
+        level * kSlotsPerLevel + static_cast<uint32_t>((expiry >> (kLevelBits * level)) & (kSlotsPerLevel - 1));
+
+    node.slot = static_cast<uint16_t>(index);
+    node.prev = kNoNode;
+    node.next = m_slots[index];
+    if (node.next != kNoNode) {
+        m_nodes[node.next].prev = timer;
+    }
+    m_slots[index] = timer;
+    node.linked = true;
+}
+
+void TimerWheel::unlink(TimerId timer) {
+    Node& node = m_nodes[timer];
+    if (!node.linked) {
+        return;
+    }
+
+    if (node.prev != kNoNode) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        m_slots[node.slot] = node.next;
+    }
+    if (node.next != kNoNode) {
+        m_nodes[node.next].prev = node.prev;
+    }
+
+    node.prev = kNoNode;
+    node.next = kNoNode;
+    node.linked = false;
+}
+
+void TimerWheel::cascade(uint32_t level) {
+    const uint32_t index =
+        level * kSlotsPerLevel + static_cast<uint32_t>((m_currentTick >> (kLevelBits * level)) & (kSlotsPerLevel - 1));
+
+    m_cascadeScratch.clear();
+    for (uint32_t node = m_slots[index]; node != kNoNode; node = m_nodes[node].next) {
+        m_cascadeScratch.push_back(node);
+    }
+    m_slots[index] = kNoNode;
+
+    for (const TimerId timer : m_cascadeScratch) {
+        m_nodes[timer].linked = false;
+        link(timer);
+    }
+}
+
+} // namespace icecap::agent::core
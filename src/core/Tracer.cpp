@@ -0,0 +1,171 @@
+#include <windows.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <icecap/agent/core/Tracer.hpp>
+
+namespace icecap::agent::core {
+
+namespace {
+
+// Written only by its thread; `written` publishes each record to dumping threads
+struct ThreadRing {
+    DWORD threadId{0};
+    std::atomic<const char*> threadName{nullptr};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> clearedAt{0};
+    std::unique_ptr<TraceRecord[]> records{new TraceRecord[Tracer::kRingCapacity]};
+};
+
+// Rings outlive their threads so a dump still shows threads that have exited. They are never freed, so a dump
+// can walk a snapshot of the list without holding the mutex
+std::mutex g_ringsMutex;
+std::vector<std::unique_ptr<ThreadRing>> g_rings;
+
+thread_local ThreadRing* t_ring = nullptr;
+thread_local const char* t_threadName = nullptr;
+
+ThreadRing& threadRing() {
+    if (!t_ring) {
+        auto ring = std::make_unique<ThreadRing>();
+        ring->threadId = GetCurrentThreadId();
+        ring->threadName.store(t_threadName, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(g_ringsMutex);
+        t_ring = ring.get();
+        g_rings.push_back(std::move(ring));
+    }
+    return *t_ring;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+void Tracer::setEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(g_ringsMutex);
+    for (const auto& ring : g_rings) {
+        ring->clearedAt.store(ring->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void Tracer::nameThread(const char* name) {
+    t_threadName = name;
+    if (t_ring) {
+        t_ring->threadName.store(name, std::memory_order_relaxed);
+    }
+}
+
+void Tracer::record(const TraceRecord& record) {
+    ThreadRing& ring = threadRing();
+    const uint64_t index = ring.written.load(std::memory_order_relaxed);
+    ring.records[index % kRingCapacity] = record;
+    ring.written.store(index + 1, std::memory_order_release);
+}
+
+size_t Tracer::writeChromeTrace(std::ostream& out) {
+    const DWORD processId = GetCurrentProcessId();
+    std::vector<TraceRecord> copy;
+    copy.reserve(kRingCapacity);
+    size_t spans = 0;
+    bool first = true;
+
+    const auto separator = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    // Streaming to disk under the mutex would stall every thread that records its first span
+    std::vector<const ThreadRing*> rings;
+    {
+        std::lock_guard<std::mutex> lock(g_ringsMutex);
+        rings.reserve(g_rings.size());
+        for (const auto& ring : g_rings) {
+            rings.push_back(ring.get());
+        }
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (const ThreadRing* ring : rings) {
+        // Copy the live window, then drop whatever the owning thread overwrote while we copied
+        const uint64_t end = ring->written.load(std::memory_order_acquire);
+        const uint64_t begin = std::max(ring->clearedAt.load(std::memory_order_relaxed),
+                                        end > kRingCapacity ? end - kRingCapacity : 0);
+        copy.clear();
+        for (uint64_t index = begin; index < end; ++index) {
+            copy.push_back(ring->records[index % kRingCapacity]);
+        }
+        const uint64_t after = ring->written.load(std::memory_order_acquire);
+        const uint64_t firstIntact = after >= kRingCapacity ? after - kRingCapacity + 1 : 0;
+        const size_t skip = static_cast<size_t>(std::min<uint64_t>(firstIntact > begin ? firstIntact - begin : 0,
+                                                                    copy.size()));
+
+        if (const char* name = ring->threadName.load(std::memory_order_relaxed)) {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << processId << ",\"tid\":" << ring->threadId
+                << ",\"args\":{\"name\":\"" << name << "\"}}";
+        }
+
+        for (size_t i = skip; i < copy.size(); ++i) {
+            const TraceRecord& record = copy[i];
+            separator();
+            out << "{\"name\":\"" << record.name << "\",\"cat\":\"icecap\",\"ph\":\"X\",\"ts\":" << record.startMicros
+                << ",\"dur\":" << record.durationMicros << ",\"pid\":" << processId << ",\"tid\":" << ring->threadId;
+            if (record.argName) {
+                out << ",\"args\":{\"" << record.argName << "\":" << record.argValue << "}";
+            }
+            out << "}";
+            ++spans;
+        }
+    }
+
+    out << "\n]}\n";
+    return spans;
+}
+
+bool Tracer::dump(std::string path, std::string& writtenPath, size_t& spanCount) {
+    if (path.empty()) {
+        // Default to %TEMP%\icecap-agent\icecap-trace-<unix seconds>.json, next to the log
+        char tempPath[MAX_PATH];
+        const DWORD result = GetTempPathA(MAX_PATH, tempPath);
+        std::filesystem::path defaultPath = result == 0 || result > MAX_PATH ? "." : tempPath;
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+                                 std::chrono::system_clock::now().time_since_epoch())
+                                 .count();
+        defaultPath /= "icecap-agent";
+        defaultPath /= "icecap-trace-" + std::to_string(seconds) + ".json";
+        path = defaultPath.string();
+    }
+
+    std::error_code error;
+    const std::filesystem::path target(path);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), error);
+    }
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    spanCount = writeChromeTrace(out);
+    writtenPath = path;
+    return static_cast<bool>(out);
+}
+
+int64_t Tracer::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace icecap::agent::core
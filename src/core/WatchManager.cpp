@@ -0,0 +1,90 @@
+#include <algorithm>
+
+#include <icecap/agent/core/CommandExecutor.hpp>
+#include <icecap/agent/core/WatchManager.hpp>
+#include <icecap/agent/logging.hpp>
+
+namespace icecap::agent::core {
+
+bool WatchManager::subscribe(const std::string& subscriptionId, const std::vector<std::string>& expressions,
+                             uint32_t intervalFrames) {
+    if (subscriptionId.empty() || expressions.empty()) {
+        LOG_WARN("WatchManager: Subscription requires an ID and at least one expression");
+        return false;
+    }
+
+    if (expressions.size() > kMaxExpressionsPerSubscription) {
+        LOG_WARN("WatchManager: Subscription '{}' exceeds the limit of {} expressions", subscriptionId,
+                 kMaxExpressionsPerSubscription);
+        return false;
+    }
+
+    Subscription subscription;
+    subscription.id = subscriptionId;
+    subscription.intervalFrames = std::max<uint32_t>(intervalFrames, 1);
+    subscription.expressions.reserve(expressions.size());
+    for (const auto& expression : expressions) {
+        if (expression.empty()) {
+            LOG_WARN("WatchManager: Subscription '{}' contains an empty expression", subscriptionId);
+            return false;
+        }
+        subscription.expressions.push_back({expression, "", false});
+    }
+
+    auto it = std::ranges::find(m_subscriptions, subscriptionId, &Subscription::id);
+    if (it != m_subscriptions.end()) {
+        *it = std::move(subscription);
+        LOG_DEBUG("WatchManager: Replaced subscription '{}'", subscriptionId);
+        return true;
+    }
+
+    if (m_subscriptions.size() >= kMaxSubscriptions) {
+        LOG_WARN("WatchManager: Subscription limit of {} reached", kMaxSubscriptions);
+        return false;
+    }
+
+    m_subscriptions.push_back(std::move(subscription));
+    LOG_DEBUG("WatchManager: Registered subscription '{}'", subscriptionId);
+    return true;
+}
+
+bool WatchManager::unsubscribe(const std::string& subscriptionId) {
+    auto it = std::ranges::find(m_subscriptions, subscriptionId, &Subscription::id);
+    if (it == m_subscriptions.end()) {
+        return false;
+    }
+
+    m_subscriptions.erase(it);
+    LOG_DEBUG("WatchManager: Removed subscription '{}'", subscriptionId);
+    return true;
+}
+
+void WatchManager::clear() {
+    m_subscriptions.clear();
+}
+
+void WatchManager::evaluate(uint64_t frameNumber, CommandExecutor& executor, std::vector<WatchChange>& changes) {
+    for (auto& subscription : m_subscriptions) {
+        if (frameNumber < subscription.nextDueFrame) {
+            continue;
+        }
+        subscription.nextDueFrame = frameNumber + subscription.intervalFrames;
+
+        for (auto& watched : subscription.expressions) {
+            std::string value;
+            if (!executor.evaluateLuaExpression(watched.expression, value)) {
+                continue;
+            }
+
+            if (watched.hasValue && watched.lastValue == value) {
+                continue;
+            }
+
+            watched.lastValue = value;
+            watched.hasValue = true;
+            changes.push_back({subscription.id, watched.expression, std::move(value)});
+        }
+    }
+}
+
+} // namespace icecap::agent::core
@@ -3,40 +3,50 @@
 
 namespace icecap::agent::hooks {
 
-BaseHook::BaseHook(std::string name) : m_name(std::move(name)) {}
+BaseHook::BaseHook(std::string name, const HookCounters& counters) : m_name(std::move(name)), m_counters(counters) {}
+
+interfaces::HookStats BaseHook::getStats() const {
+    interfaces::HookStats stats;
+    stats.name = m_name;
+    stats.installed = m_installed.load(std::memory_order_acquire);
+    stats.invocations = m_counters.invocations.load(std::memory_order_relaxed);
+    stats.inclusiveCycles = m_counters.inclusiveCycles.load(std::memory_order_relaxed);
+    stats.exclusiveCycles = m_counters.exclusiveCycles.load(std::memory_order_relaxed);
+    return stats;
+}
 
 bool BaseHook::install() {
-    if (m_installed) {
-        LOG_WARN("Hook '" + m_name + "' is already installed");
+    if (m_installed.load(std::memory_order_acquire)) {
+        LOG_WARN("Hook '{}' is already installed", m_name);
         return true;
     }
 
-    LOG_DEBUG("Installing hook: " + m_name);
+    LOG_DEBUG("Installing hook: {}", m_name);
 
     if (doInstall()) {
-        m_installed = true;
-        LOG_INFO("Successfully installed hook: " + m_name);
+        m_installed.store(true, std::memory_order_release);
+        LOG_INFO("Successfully installed hook: {}", m_name);
         return true;
     } else {
-        LOG_ERROR("Failed to install hook: " + m_name);
+        LOG_ERROR("Failed to install hook: {}", m_name);
         return false;
     }
 }
 
 bool BaseHook::uninstall() {
-    if (!m_installed) {
-        LOG_WARN("Hook '" + m_name + "' is not installed");
+    if (!m_installed.load(std::memory_order_acquire)) {
+        LOG_WARN("Hook '{}' is not installed", m_name);
         return true;
     }
 
-    LOG_DEBUG("Uninstalling hook: " + m_name);
+    LOG_DEBUG("Uninstalling hook: {}", m_name);
 
     if (doUninstall()) {
-        m_installed = false;
-        LOG_INFO("Successfully uninstalled hook: " + m_name);
+        m_installed.store(false, std::memory_order_release);
+        LOG_INFO("Successfully uninstalled hook: {}", m_name);
         return true;
     } else {
-        LOG_ERROR("Failed to uninstall hook: " + m_name);
+        LOG_ERROR("Failed to uninstall hook: {}", m_name);
         return false;
     }
 }
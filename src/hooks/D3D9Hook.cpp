@@ -3,7 +3,14 @@
 #include "MinHook.h"
 
 #include <icecap/agent/application_context.hpp>
+#include <icecap/agent/core/AgentMetrics.hpp>
+#include <icecap/agent/core/FrameStallWatchdog.hpp>
+#include <icecap/agent/core/FrameTiming.hpp>
+#include <icecap/agent/core/GameAddresses.hpp>
 #include <icecap/agent/core/MessageProcessor.hpp>
+#include <icecap/agent/core/PageCachedMemoryReader.hpp>
+#include <icecap/agent/core/ProcessMemoryRegionSource.hpp>
+#include <icecap/agent/core/Tracer.hpp>
 #include <icecap/agent/hooks/D3D9Hook.hpp>
 #include <icecap/agent/logging.hpp>
 #include <icecap/agent/shared_state.hpp>
@@ -12,8 +19,10 @@ namespace icecap::agent::hooks {
 
 // Static member initialization
 D3D9Hook::EndSceneFunc D3D9Hook::s_originalEndScene = nullptr;
+std::atomic<uint64_t> D3D9Hook::s_frameCount{0};
+HookCounters D3D9Hook::s_counters;
 
-D3D9Hook::D3D9Hook() : BaseHook("D3D9EndScene") {}
+D3D9Hook::D3D9Hook() : BaseHook("D3D9EndScene", s_counters) {}
 
 bool D3D9Hook::doInstall() {
     if (!findEndSceneAddress()) {
@@ -31,7 +40,16 @@ long(__stdcall* D3D9Hook::GetOriginalEndScene())(IDirect3DDevice9*) {
     return s_originalEndScene;
 }
 
+uint64_t D3D9Hook::GetFrameCount() {
+    return s_frameCount.load(std::memory_order_relaxed);
+}
+
 bool D3D9Hook::findEndSceneAddress() {
+    // Reading the game's own device avoids creating a throwaway one
+    if (findGameDeviceEndScene()) {
+        return true;
+    }
+
     try {
         // Get D3D9 module handle
         HMODULE d3d9Module = GetModuleHandleA("d3d9.dll");
@@ -66,11 +84,11 @@ bool D3D9Hook::findEndSceneAddress() {
 
         // Get vtable and extract EndScene address
         void** vtable = *reinterpret_cast<void***>(device);
-        m_targetAddress = vtable[42]; // EndScene is at index 42
+        m_targetAddress = vtable[kEndSceneIndex];
 
         device->Release();
 
-        LOG_DEBUG("D3D9Hook: Found EndScene address: " + std::to_string(reinterpret_cast<uintptr_t>(m_targetAddress)));
+        LOG_DEBUG("D3D9Hook: Found EndScene address: {}", reinterpret_cast<uintptr_t>(m_targetAddress));
         return true;
 
     } catch (...) {
@@ -79,6 +97,27 @@ bool D3D9Hook::findEndSceneAddress() {
     }
 }
 
+bool D3D9Hook::findGameDeviceEndScene() {
+    core::ProcessMemoryRegionSource source;
+    core::PageCachedMemoryReader memory(source);
+
+    // g_theGxDevicePtr -> CGxDevice -> IDirect3DDevice9 -> vtable -> EndScene
+    uint32_t gxDevice = 0;
+    uint32_t device = 0;
+    uint32_t vtable = 0;
+    uint32_t endScene = 0;
+    if (!memory.readValue(core::GameAddresses::get(core::GameAddress::GX_DEVICE), gxDevice) || gxDevice == 0 ||
+        !memory.readValue(gxDevice + kGxDeviceD3DOffset, device) || device == 0 || !memory.readValue(device, vtable) ||
+        !memory.readValue(vtable + kEndSceneIndex * sizeof(uint32_t), endScene) || endScene == 0) {
+        LOG_DEBUG("D3D9Hook: Game device not available yet, falling back to a temporary device");
+        return false;
+    }
+
+    m_targetAddress = reinterpret_cast<void*>(static_cast<uintptr_t>(endScene));
+    LOG_DEBUG("D3D9Hook: Found EndScene address from the game device: {}", endScene);
+    return true;
+}
+
 bool D3D9Hook::installMinHook() {
     if (!m_targetAddress) {
         LOG_ERROR("D3D9Hook: No target address available");
@@ -90,14 +129,14 @@ bool D3D9Hook::installMinHook() {
                                      reinterpret_cast<LPVOID*>(&s_originalEndScene));
 
     if (status != MH_OK) {
-        LOG_ERROR("D3D9Hook: MH_CreateHook failed with status " + std::to_string(status));
+        LOG_ERROR("D3D9Hook: MH_CreateHook failed with status {}", static_cast<int>(status));
         return false;
     }
 
     // Enable the hook
     status = MH_EnableHook(m_targetAddress);
     if (status != MH_OK) {
-        LOG_ERROR("D3D9Hook: MH_EnableHook failed with status " + std::to_string(status));
+        LOG_ERROR("D3D9Hook: MH_EnableHook failed with status {}", static_cast<int>(status));
         MH_RemoveHook(m_targetAddress);
         return false;
     }
@@ -114,13 +153,13 @@ bool D3D9Hook::uninstallMinHook() {
     // Disable the hook
     MH_STATUS status = MH_DisableHook(m_targetAddress);
     if (status != MH_OK) {
-        LOG_ERROR("D3D9Hook: MH_DisableHook failed with status " + std::to_string(status));
+        LOG_ERROR("D3D9Hook: MH_DisableHook failed with status {}", static_cast<int>(status));
     }
 
     // Remove the hook
     status = MH_RemoveHook(m_targetAddress);
     if (status != MH_OK) {
-        LOG_ERROR("D3D9Hook: MH_RemoveHook failed with status " + std::to_string(status));
+        LOG_ERROR("D3D9Hook: MH_RemoveHook failed with status {}", static_cast<int>(status));
         return false;
     }
 
@@ -130,30 +169,58 @@ bool D3D9Hook::uninstallMinHook() {
 }
 
 long __stdcall D3D9Hook::HookedEndScene(IDirect3DDevice9* pDevice) {
+    HookTimer timer(s_counters);
+    const uint64_t frameNumber = s_frameCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
     auto* appContext = GetApplicationContext();
     if (!appContext) {
         LOG_WARN("D3D9Hook: No application context available");
-        return s_originalEndScene(pDevice);
+        timer.beginOriginal();
+        const long result = s_originalEndScene(pDevice);
+        timer.endOriginal();
+        return result;
     }
 
-    // Process any pending commands using the message processor
-    std::lock_guard lk(appContext->getInboxMutex());
-    if (!appContext->getInboxQueue().empty()) {
-        auto cmd = appContext->getInboxQueue().front();
-        appContext->getInboxQueue().pop();
-
-        // Use MessageProcessor to handle the command
-        try {
-            core::MessageProcessor processor(appContext);
-            processor.processCommand(cmd);
-        } catch (const std::exception& e) {
-            LOG_ERROR("D3D9Hook: Exception in MessageProcessor: " + std::string(e.what()));
-        } catch (...) {
-            LOG_ERROR("D3D9Hook: Unknown exception in MessageProcessor");
+    const int64_t hookStartMicros = core::CommandTimeline::nowMicros();
+    appContext->getFrameTiming().onFrame(frameNumber, hookStartMicros);
+    appContext->getFrameStallWatchdog().beginFrame(frameNumber, hookStartMicros);
+
+    core::Tracer::nameThread("EndScene");
+
+    try {
+        TRACE_SCOPE("D3D9Hook::HookedEndScene", "frame", frameNumber);
+
+        // Page protections may have changed since the last frame
+        appContext->getMemoryReader().invalidate();
+
+        core::MessageProcessor processor(appContext);
+
+        // Process any pending commands using the message processor
+        {
+            std::lock_guard lk(appContext->getInboxMutex());
+            if (!appContext->getInboxQueue().empty()) {
+                auto entry = std::move(appContext->getInboxQueue().front());
+                appContext->getInboxQueue().pop();
+                entry.timeline.stamp(core::CommandStage::DEQUEUED);
+                appContext->getMetrics().recordInboxPop(entry.bytes);
+                processor.processCommand(entry);
+            }
         }
+
+        // Drive render-thread state that spans frames
+        processor.processFrame(frameNumber);
+    } catch (const std::exception& e) {
+        LOG_ERROR("D3D9Hook: Exception in MessageProcessor: {}", e.what());
+    } catch (...) {
+        LOG_ERROR("D3D9Hook: Unknown exception in MessageProcessor");
     }
 
-    return s_originalEndScene(pDevice);
+    appContext->getMetrics().recordFrame(core::CommandTimeline::nowMicros() - hookStartMicros);
+
+    timer.beginOriginal();
+    const long result = s_originalEndScene(pDevice);
+    timer.endOriginal();
+    return result;
 }
 
 } // namespace icecap::agent::hooks
\ No newline at end of file
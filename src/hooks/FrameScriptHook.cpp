@@ -0,0 +1,53 @@
+#include <windows.h>
+
+#include "MinHook.h"
+
+#include <icecap/agent/core/GameAddresses.hpp>
+#include <icecap/agent/hooks/FrameScriptHook.hpp>
+#include <icecap/agent/hooks/framescript_hooks.hpp>
+#include <icecap/agent/logging.hpp>
+
+namespace icecap::agent::hooks {
+
+FrameScriptHook::FrameScriptHook() : BaseHook("FrameScriptSignalEvent", g_FrameScriptSignalEventCounters) {}
+
+bool FrameScriptHook::doInstall() {
+    m_targetAddress = core::GameAddresses::get(core::GameAddress::SIGNAL_EVENT);
+    auto* target = reinterpret_cast<LPVOID>(m_targetAddress);
+
+    MH_STATUS status = MH_CreateHook(target, reinterpret_cast<LPVOID>(&HookedFrameScriptSignalEvent),
+                                     reinterpret_cast<LPVOID*>(&g_OriginalFrameScriptSignalEvent));
+    if (status != MH_OK) {
+        LOG_ERROR("FrameScriptHook: MH_CreateHook failed with status {}", static_cast<int>(status));
+        return false;
+    }
+
+    status = MH_EnableHook(target);
+    if (status != MH_OK) {
+        LOG_ERROR("FrameScriptHook: MH_EnableHook failed with status {}", static_cast<int>(status));
+        MH_RemoveHook(target);
+        return false;
+    }
+
+    return true;
+}
+
+bool FrameScriptHook::doUninstall() {
+    auto* target = reinterpret_cast<LPVOID>(m_targetAddress);
+
+    MH_STATUS status = MH_DisableHook(target);
+    if (status != MH_OK) {
+        LOG_ERROR("FrameScriptHook: MH_DisableHook failed with status {}", static_cast<int>(status));
+    }
+
+    status = MH_RemoveHook(target);
+    if (status != MH_OK) {
+        LOG_ERROR("FrameScriptHook: MH_RemoveHook failed with status {}", static_cast<int>(status));
+        return false;
+    }
+
+    g_OriginalFrameScriptSignalEvent = nullptr;
+    return true;
+}
+
+} // namespace icecap::agent::hooks
@@ -1,10 +1,26 @@
+#include <windows.h>
+
 #include <ranges>
 
+#include <icecap/agent/hooks/BaseHook.hpp>
 #include <icecap/agent/hooks/HookRegistry.hpp>
 #include <icecap/agent/logging.hpp>
 
 namespace icecap::agent::hooks {
 
+namespace {
+
+int64_t readPerformanceCounter() {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+} // namespace
+
+HookRegistry::HookRegistry()
+    : m_calibrationCycles(readCycleCounter()), m_calibrationTicks(readPerformanceCounter()) {}
+
 HookRegistry::~HookRegistry() {
     // Ensure all hooks are uninstalled during destruction
     HookRegistry::uninstallAllHooks();
@@ -20,33 +36,32 @@ void HookRegistry::registerHook(const std::shared_ptr<interfaces::IHook> hook) {
 
     // Check if a hook with this name already exists
     if (m_hooksByName.contains(name)) {
-        LOG_WARN("HookRegistry: Hook with name '" + name + "' is already registered");
+        LOG_WARN("HookRegistry: Hook with name '{}' is already registered", name);
         return;
     }
 
     m_hooks.push_back(hook);
     m_hooksByName[name] = hook;
 
-    LOG_DEBUG("HookRegistry: Registered hook '" + name + "'");
+    LOG_DEBUG("HookRegistry: Registered hook '{}'", name);
 }
 
 bool HookRegistry::installAllHooks() {
     bool allSuccessful = true;
     size_t successCount = 0;
 
-    LOG_INFO("HookRegistry: Installing " + std::to_string(m_hooks.size()) + " hooks");
+    LOG_INFO("HookRegistry: Installing {} hooks", m_hooks.size());
 
     for (const auto& hook : m_hooks) {
         if (hook->install()) {
             successCount++;
         } else {
-            LOG_ERROR("HookRegistry: Failed to install hook '" + hook->getName() + "'");
+            LOG_ERROR("HookRegistry: Failed to install hook '{}'", hook->getName());
             allSuccessful = false;
         }
     }
 
-    LOG_INFO("HookRegistry: Successfully installed " + std::to_string(successCount) + " out of " +
-             std::to_string(m_hooks.size()) + " hooks");
+    LOG_INFO("HookRegistry: Successfully installed {} out of {} hooks", successCount, m_hooks.size());
 
     return allSuccessful;
 }
@@ -55,20 +70,19 @@ bool HookRegistry::uninstallAllHooks() {
     bool allSuccessful = true;
     size_t successCount = 0;
 
-    LOG_INFO("HookRegistry: Uninstalling " + std::to_string(m_hooks.size()) + " hooks");
+    LOG_INFO("HookRegistry: Uninstalling {} hooks", m_hooks.size());
 
     // Uninstall in reverse order (LIFO)
     for (const auto& hook : std::ranges::reverse_view(m_hooks)) {
         if (hook->uninstall()) {
             successCount++;
         } else {
-            LOG_ERROR("HookRegistry: Failed to uninstall hook '" + hook->getName() + "'");
+            LOG_ERROR("HookRegistry: Failed to uninstall hook '{}'", hook->getName());
             allSuccessful = false;
         }
     }
 
-    LOG_INFO("HookRegistry: Successfully uninstalled " + std::to_string(successCount) + " out of " +
-             std::to_string(m_hooks.size()) + " hooks");
+    LOG_INFO("HookRegistry: Successfully uninstalled {} out of {} hooks", successCount, m_hooks.size());
 
     return allSuccessful;
 }
@@ -91,4 +105,24 @@ std::shared_ptr<interfaces::IHook> HookRegistry::getHook(const std::string& name
     return nullptr;
 }
 
+std::vector<interfaces::HookStats> HookRegistry::getHookStats() const {
+    std::vector<interfaces::HookStats> stats;
+    stats.reserve(m_hooks.size());
+    for (const auto& hook : m_hooks) {
+        stats.push_back(hook->getStats());
+    }
+    return stats;
+}
+
+double HookRegistry::getCyclesPerSecond() const {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    const int64_t ticks = readPerformanceCounter() - m_calibrationTicks;
+    const uint64_t cycles = readCycleCounter() - m_calibrationCycles;
+    if (ticks <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(cycles) * static_cast<double>(frequency.QuadPart) / static_cast<double>(ticks);
+}
+
 } // namespace icecap::agent::hooks
\ No newline at end of file
@@ -1,159 +1,121 @@
-#include <windows.h>
-
-#include <mutex>
 #include <string>
 #include <vector>
 
+#include <icecap/agent/core/GameEventStream.hpp>
+#include <icecap/agent/core/PageCachedMemoryReader.hpp>
 #include <icecap/agent/hooks/framescript_hooks.hpp>
+#include <icecap/agent/shared_state.hpp>
 
 namespace icecap::agent::hooks {
 
 // Original function pointer definition
 p_FrameScriptSignalEvent g_OriginalFrameScriptSignalEvent = nullptr;
+HookCounters g_FrameScriptSignalEventCounters;
 
-// Safe memory read helpers (use ReadProcessMemory to avoid AVs on bad pointers)
-static bool readMem(void* addr, void* out, SIZE_T size) {
-    SIZE_T bytesRead = 0;
-    return ReadProcessMemory(GetCurrentProcess(), addr, out, size, &bytesRead) && bytesRead == size;
-}
-
-template <typename T>
-static bool readVal(uintptr_t addr, T& out) {
-    return readMem(reinterpret_cast<void*>(addr), &out, sizeof(T));
-}
-
-static std::string readCStringBounded(uintptr_t addr, size_t maxLen = 1024) {
-    if (addr == 0)
-        return "(null)";
-    std::string result;
-    result.reserve(64);
-    const size_t chunk = 128;
-    std::vector<char> buf(chunk);
-
-    size_t total = 0;
-    for (;;) {
-        SIZE_T bytesRead = 0;
-        if (!ReadProcessMemory(GetCurrentProcess(), reinterpret_cast<void*>(addr + total), buf.data(), buf.size(),
-                               &bytesRead) ||
-            bytesRead == 0) {
-            break;
-        }
-        for (SIZE_T i = 0; i < bytesRead && total < maxLen; ++i, ++total) {
-            char c = buf[i];
-            if (c == '\0') {
-                return result;
-            }
-            result.push_back(c);
-        }
-        if (total >= maxLen) {
-            result.append("…");
-            break;
-        }
-        if (bytesRead < buf.size()) {
-            break;
-        }
-    }
-    return result;
-}
+// Longest string argument decoded from an event
+static constexpr size_t kMaxStringArgument = 1024;
 
-// Reconstruct a string by walking fmt and reading args from the custom stack layout.
-static std::string formatCustomArgs(const char* fmt, int argsBase) {
+// Decode typed arguments by walking fmt over the custom stack layout.
+static void decodeArguments(const interfaces::IMemoryReader& memory, const char* fmt, int argsBase,
+                            std::vector<core::GameEventArgument>& arguments) {
     if (!fmt)
-        return "";
+        return;
+
+    using Kind = core::GameEventArgument::Kind;
 
     uintptr_t i32 = static_cast<uintptr_t>(static_cast<uint32_t>(argsBase)) - 4;
     uintptr_t base = static_cast<uintptr_t>(static_cast<uint32_t>(argsBase)) - 8;
 
-    std::string out;
     for (const char* p = fmt; *p; ++p) {
         if (*p != '%') {
-            out.push_back(*p);
             continue;
         }
         ++p;
         if (!*p)
             break;
 
+        core::GameEventArgument argument;
         switch (*p) {
             case 'd': {
                 int v = 0;
-                if (readVal(i32 + 4, v)) {
-                    out += std::to_string(v);
-                } else {
-                    out += "<bad-int>";
-                }
+                argument.kind = memory.readValue(i32 + 4, v) ? Kind::INTEGER : Kind::UNREADABLE;
+                argument.integer = v;
                 i32 += 4;
                 base += 4;
                 break;
             }
             case 'u': {
                 uint32_t v = 0;
-                if (readVal(i32 + 4, v)) {
-                    out += std::to_string(v);
-                } else {
-                    out += "<bad-uint>";
-                }
+                argument.kind = memory.readValue(i32 + 4, v) ? Kind::INTEGER : Kind::UNREADABLE;
+                argument.integer = v;
                 i32 += 4;
                 base += 4;
                 break;
             }
             case 'b': {
                 int v = 0;
-                if (readVal(i32 + 4, v)) {
-                    out += (v ? "1" : "0");
-                } else {
-                    out += "<bad-bool>";
-                }
+                argument.kind = memory.readValue(i32 + 4, v) ? Kind::BOOLEAN : Kind::UNREADABLE;
+                argument.integer = v ? 1 : 0;
                 i32 += 4;
                 base += 4;
                 break;
             }
             case 'f': {
                 double dv = 0.0;
-                if (readVal(base + 8, dv)) {
-                    char buf[64];
-                    _snprintf_s(buf, _TRUNCATE, "%.6g", dv);
-                    out += buf;
-                } else {
-                    out += "<bad-double>";
-                }
+                argument.kind = memory.readValue(base + 8, dv) ? Kind::NUMBER : Kind::UNREADABLE;
+                argument.number = dv;
                 i32 += 8;
                 base += 8;
                 break;
             }
             case 's': {
+                // A null pointer is an empty string; a pointer or string that cannot be read is not
                 uint32_t pStr = 0;
-                if (readVal(i32 + 4, pStr)) {
-                    out += readCStringBounded(static_cast<uintptr_t>(pStr));
-                } else {
-                    out += "<bad-str*>";
+                argument.kind = Kind::STRING;
+                if (!memory.readValue(i32 + 4, pStr) ||
+                    (pStr != 0 &&
+                     !memory.readString(static_cast<uintptr_t>(pStr), argument.text, kMaxStringArgument))) {
+                    argument.kind = Kind::UNREADABLE;
+                    argument.text.clear();
                 }
                 i32 += 4;
                 base += 4;
                 break;
             }
-            case '%': {
-                out.push_back('%');
-                break;
-            }
             default: {
-                out.push_back('%');
-                out.push_back(*p);
-                break;
+                // Literal '%' and unknown specifiers consume no argument
+                continue;
             }
         }
+        arguments.push_back(std::move(argument));
     }
-    return out;
 }
 
 // Hooked FrameScript__SignalEvent function
 void __cdecl HookedFrameScriptSignalEvent(int eventid, const char* fmt, int argsBase) {
-    // Safely reconstruct the formatted text (currently unused)
-    (void)formatCustomArgs(fmt, argsBase);
+    HookTimer timer(g_FrameScriptSignalEventCounters);
+
+    // Unsubscribed events cost one bit test; decoding only happens for subscribed ids
+    auto* appContext = GetApplicationContext();
+    if (appContext && eventid >= 0) {
+        auto& stream = appContext->getGameEventStream();
+        if (stream.isSubscribed(static_cast<uint32_t>(eventid))) {
+            try {
+                core::GameEvent event;
+                event.eventId = static_cast<uint32_t>(eventid);
+                decodeArguments(appContext->getMemoryReader(), fmt, argsBase, event.arguments);
+                stream.push(std::move(event));
+            } catch (...) {
+                // Never let an exception unwind into the game's event dispatch
+            }
+        }
+    }
 
     // Forward to original with the untouched parameters
     if (g_OriginalFrameScriptSignalEvent) {
+        timer.beginOriginal();
         g_OriginalFrameScriptSignalEvent(eventid, fmt, argsBase);
+        timer.endOriginal();
     }
 }
 
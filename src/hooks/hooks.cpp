@@ -1,6 +1,7 @@
 #include "MinHook.h"
 
 #include <icecap/agent/hooks/D3D9Hook.hpp>
+#include <icecap/agent/hooks/FrameScriptHook.hpp>
 #include <icecap/agent/hooks/HookRegistry.hpp>
 #include <icecap/agent/hooks/hook_manager.hpp>
 #include <icecap/agent/logging.hpp>
@@ -19,7 +20,7 @@ void InstallHooks(const bool enableEvents) {
         // Initialize MinHook
         MH_STATUS mhStatus = MH_Initialize();
         if (mhStatus != MH_OK) {
-            LOG_ERROR("MinHook initialization failed with status " + std::to_string(mhStatus));
+            LOG_ERROR("MinHook initialization failed with status {}", static_cast<int>(mhStatus));
             throw std::runtime_error("MinHook initialization failed");
         }
         LOG_DEBUG("MinHook initialized successfully");
@@ -31,11 +32,11 @@ void InstallHooks(const bool enableEvents) {
         auto d3d9Hook = std::make_shared<D3D9Hook>();
         g_hookRegistry->registerHook(d3d9Hook);
 
-        // TODO: Add FrameScript hook when refactored
-        // if (enableEvents) {
-        //     auto frameScriptHook = std::make_shared<FrameScriptHook>();
-        //     g_hookRegistry->registerHook(frameScriptHook);
-        // }
+        // Register FrameScript__SignalEvent hook (game event streaming)
+        if (enableEvents) {
+            auto frameScriptHook = std::make_shared<FrameScriptHook>();
+            g_hookRegistry->registerHook(frameScriptHook);
+        }
 
         // Install all registered hooks
         if (!g_hookRegistry->installAllHooks()) {
@@ -43,11 +44,11 @@ void InstallHooks(const bool enableEvents) {
             throw std::runtime_error("Failed to install all hooks");
         }
 
-        LOG_INFO("Hook installation completed successfully. Installed " +
-                 std::to_string(g_hookRegistry->getInstalledHookCount()) + " hooks.");
+        LOG_INFO("Hook installation completed successfully. Installed {} hooks.",
+                 g_hookRegistry->getInstalledHookCount());
 
     } catch (const std::exception& e) {
-        LOG_ERROR("Exception during hook installation: " + std::string(e.what()));
+        LOG_ERROR("Exception during hook installation: {}", e.what());
         throw;
     } catch (...) {
         LOG_ERROR("Unknown exception during hook installation");
@@ -55,4 +56,8 @@ void InstallHooks(const bool enableEvents) {
     }
 }
 
+const interfaces::IHookRegistry* GetHookRegistry() {
+    return g_hookRegistry.get();
+}
+
 } // namespace icecap::agent::hooks
@@ -2,8 +2,10 @@
 
 #include <windows.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
 
 #include <spdlog/sinks/rotating_file_sink.h>
@@ -12,6 +14,97 @@
 
 namespace icecap::agent {
 
+/**
+ * Bounded multi-producer, multi-consumer ring of fixed-size log records
+ * (Vyukov's sequence-numbered queue). Each slot carries a sequence number
+ * that tells producers and consumers whose turn it is, so claiming a slot
+ * is one compare-exchange and a full or empty ring is detected without
+ * locks. Producers also pop when the overflow policy is DROP_OLDEST.
+ */
+class LogRing {
+public:
+    static constexpr size_t kCapacity = 2048;                      // Power of two
+    static constexpr size_t kMaxText = Logger::kMaxMessageLength; // Keeps a slot at eight cache lines
+
+    struct Record {
+        spdlog::log_clock::time_point time;
+        size_t threadId{0};
+        spdlog::level::level_enum level{spdlog::level::info};
+        uint32_t length{0};
+        char text[kMaxText];
+    };
+
+    LogRing() {
+        for (size_t i = 0; i < kCapacity; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Claim a slot and let `fill` write the record into it; false if the ring is full
+    template <typename Fill>
+    bool tryPush(Fill&& fill) {
+        uint64_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = m_slots[position & (kCapacity - 1)];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int64_t>(sequence - position);
+            if (difference == 0) {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    fill(slot.record);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Hand the oldest record to `consume` and free its slot; false if the ring is empty
+    template <typename Consume>
+    bool tryPop(Consume&& consume) {
+        uint64_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = m_slots[position & (kCapacity - 1)];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int64_t>(sequence - (position + 1));
+            if (difference == 0) {
+                if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    consume(static_cast<const Record&>(slot.record));
+                    slot.sequence.store(position + kCapacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0};
+        Record record;
+    };
+
+    std::unique_ptr<Slot[]> m_slots{new Slot[kCapacity]};
+    alignas(64) std::atomic<uint64_t> m_enqueuePosition{0};
+    alignas(64) std::atomic<uint64_t> m_dequeuePosition{0};
+};
+
+Logger::Logger() : m_ring(std::make_unique<LogRing>()) {}
+
+Logger::~Logger() {
+    // shutdown() normally joined the writer already; joining here could deadlock under the loader lock
+    m_writerRunning.store(false, std::memory_order_release);
+    if (m_writerThread.joinable()) {
+        m_writerThread.detach();
+    }
+}
+
 Logger& Logger::getInstance() {
     static Logger instance;
     return instance;
@@ -40,21 +133,22 @@ void Logger::initialize(const std::string& logFilePath) {
 
         // Set level based on build type
 #ifdef _DEBUG
-        m_logger->set_level(spdlog::level::debug);
+        setLevel(LogLevel::DEBUG);
 #else
-        m_logger->set_level(spdlog::level::info);
+        setLevel(LogLevel::INFO);
 #endif
 
-        // Enable automatic flushing for immediate log visibility
-        spdlog::flush_on(spdlog::level::trace);
-        spdlog::flush_every(std::chrono::seconds(1)); // Also flush every second
-
         // Register logger globally
         spdlog::register_logger(m_logger);
 
+        // Records are written and flushed in batches by the writer thread, never by the logging thread
+        m_writerRunning.store(true, std::memory_order_release);
+        m_writerThread = std::thread(&Logger::writerThreadMain, this);
+
         m_initialized = true;
 
         LOG_INFO("Logging system initialized");
+        readOverflowPolicy();
     } catch (const std::exception& ex) {
         // Fallback to MessageBox if logging initialization fails
         std::string error = "Failed to initialize logging system: " + std::string(ex.what()) +
@@ -74,6 +168,15 @@ void Logger::shutdown() {
     try {
         if (m_initialized && m_logger) {
             LOG_INFO("Shutting down logging system");
+
+            // Stop the writer, then write whatever it left behind from this thread
+            m_writerRunning.store(false, std::memory_order_release);
+            if (m_writerThread.joinable()) {
+                m_writerThread.join();
+            }
+            setLevel(LogLevel::OFF);
+            drain();
+
             m_logger->flush();
             spdlog::shutdown(); // Properly shutdown spdlog
             m_logger.reset();
@@ -101,41 +204,122 @@ std::string Logger::getDefaultLogPath() const {
     return logPath.string();
 }
 
-// Simple string message methods
-void Logger::trace(const std::string& message) {
-    if (m_initialized && m_logger) {
-        m_logger->trace(message);
+void Logger::readOverflowPolicy() {
+    char value[16] = {};
+    const DWORD length = GetEnvironmentVariableA(kOverflowPolicyVariable, value, sizeof(value));
+    if (length == 0 || length >= sizeof(value)) {
+        return;
     }
-}
 
-void Logger::debug(const std::string& message) {
-    if (m_initialized && m_logger) {
-        m_logger->debug(message);
+    const std::string policy(value);
+    if (policy == "drop_newest") {
+        setOverflowPolicy(LogOverflowPolicy::DROP_NEWEST);
+    } else if (policy == "drop_oldest") {
+        setOverflowPolicy(LogOverflowPolicy::DROP_OLDEST);
+    } else if (policy == "block") {
+        setOverflowPolicy(LogOverflowPolicy::BLOCK);
+    } else {
+        LOG_WARN("Ignoring invalid {} '{}'", kOverflowPolicyVariable, policy);
+        return;
     }
+    LOG_INFO("Log overflow policy: {}", policy);
 }
 
-void Logger::info(const std::string& message) {
-    if (m_initialized && m_logger) {
-        m_logger->info(message);
+void Logger::log(LogLevel level, std::string_view message) {
+    if (!isEnabled(level)) {
+        return;
     }
-}
 
-void Logger::warn(const std::string& message) {
-    if (m_initialized && m_logger) {
-        m_logger->warn(message);
+    // Neither the clock nor the thread id leaves user mode
+    const auto time = spdlog::log_clock::now();
+    const size_t threadId = GetCurrentThreadId();
+    const auto fill = [&](LogRing::Record& record) {
+        record.time = time;
+        record.threadId = threadId;
+        record.level = static_cast<spdlog::level::level_enum>(level);
+        record.length = static_cast<uint32_t>(std::min(message.size(), LogRing::kMaxText));
+        std::memcpy(record.text, message.data(), record.length);
+    };
+
+    if (m_ring->tryPush(fill)) {
+        return;
+    }
+
+    switch (m_overflowPolicy.load(std::memory_order_relaxed)) {
+        case LogOverflowPolicy::DROP_NEWEST:
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            break;
+
+        case LogOverflowPolicy::DROP_OLDEST:
+            do {
+                if (m_ring->tryPop([](const LogRing::Record&) {})) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            } while (!m_ring->tryPush(fill));
+            break;
+
+        case LogOverflowPolicy::BLOCK:
+            while (!m_ring->tryPush(fill)) {
+                std::this_thread::yield();
+            }
+            break;
     }
 }
 
-void Logger::error(const std::string& message) {
-    if (m_initialized && m_logger) {
-        m_logger->error(message);
+void Logger::writerThreadMain() {
+    while (m_writerRunning.load(std::memory_order_acquire)) {
+        size_t written = 0;
+        try {
+            written = drain();
+        } catch (...) {
+            // A failing sink must not take the writer down; the records are lost
+        }
+        if (written == 0) {
+            Sleep(kWriterIdleMillis);
+        }
     }
 }
 
-void Logger::critical(const std::string& message) {
-    if (m_initialized && m_logger) {
-        m_logger->critical(message);
+size_t Logger::drain() {
+    auto& sinks = m_logger->sinks();
+    const auto write = [&](spdlog::details::log_msg& message) {
+        for (auto& sink : sinks) {
+            if (sink->should_log(message.level)) {
+                sink->log(message);
+            }
+        }
+    };
+
+    const auto writeRecord = [&](const LogRing::Record& record) {
+        spdlog::details::log_msg message(record.time, spdlog::source_loc{}, m_logger->name(), record.level,
+                                         spdlog::string_view_t(record.text, record.length));
+        message.thread_id = record.threadId;
+        write(message);
+    };
+
+    // At most one ring's worth per batch, so a steady stream still gets flushed
+    size_t written = 0;
+    while (written < LogRing::kCapacity && m_ring->tryPop(writeRecord)) {
+        ++written;
+    }
+
+    // Losses are reported in the log itself, once per batch
+    const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDropped) {
+        const std::string text =
+            "Logger: Dropped " + std::to_string(dropped - m_reportedDropped) + " log records, the ring was full";
+        spdlog::details::log_msg message(m_logger->name(), spdlog::level::warn, text);
+        write(message);
+        m_reportedDropped = dropped;
+        ++written;
+    }
+
+    if (written != 0) {
+        for (auto& sink : sinks) {
+            sink->flush();
+        }
     }
+    return written;
 }
 
 } // namespace icecap::agent
\ No newline at end of file
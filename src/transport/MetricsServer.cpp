@@ -0,0 +1,139 @@
+#include <icecap/agent/logging.hpp>
+#include <icecap/agent/transport/MetricsServer.hpp>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace icecap::agent::transport {
+
+MetricsServer::MetricsServer(Renderer renderer) : m_renderer(std::move(renderer)) {}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(unsigned short port) {
+    if (m_running.load()) {
+        LOG_WARN("MetricsServer: Already running on port {}", m_port);
+        return false;
+    }
+
+    m_port = port;
+
+    WSADATA wsaData;
+    int result = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if (result != 0) {
+        LOG_ERROR("MetricsServer: WSAStartup failed: {}", result);
+        return false;
+    }
+
+    m_listenerSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (m_listenerSocket == INVALID_SOCKET) {
+        LOG_ERROR("MetricsServer: socket() failed: {}", WSAGetLastError());
+        WSACleanup();
+        return false;
+    }
+
+    int opt = 1;
+    setsockopt(m_listenerSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+
+    if (bind(m_listenerSocket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR ||
+        listen(m_listenerSocket, SOMAXCONN) == SOCKET_ERROR) {
+        LOG_ERROR("MetricsServer: Failed to listen on port {}: {}", port, WSAGetLastError());
+        closesocket(m_listenerSocket);
+        m_listenerSocket = INVALID_SOCKET;
+        WSACleanup();
+        return false;
+    }
+
+    m_running.store(true);
+    m_serverThread = CreateThread(nullptr, 0, ServerThreadProc, this, 0, nullptr);
+    if (m_serverThread == nullptr) {
+        LOG_ERROR("MetricsServer: CreateThread failed: {}", GetLastError());
+        m_running.store(false);
+        closesocket(m_listenerSocket);
+        m_listenerSocket = INVALID_SOCKET;
+        WSACleanup();
+        return false;
+    }
+
+    LOG_INFO("MetricsServer: Serving metrics on port {}", port);
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!m_running.load()) {
+        return;
+    }
+
+    m_running.store(false);
+
+    // Close listener socket to unblock accept()
+    if (m_listenerSocket != INVALID_SOCKET) {
+        closesocket(m_listenerSocket);
+        m_listenerSocket = INVALID_SOCKET;
+    }
+
+    if (m_serverThread != nullptr) {
+        WaitForSingleObject(m_serverThread, 5000); // 5 second timeout
+        CloseHandle(m_serverThread);
+        m_serverThread = nullptr;
+    }
+
+    WSACleanup();
+    LOG_INFO("MetricsServer: Stopped");
+}
+
+DWORD WINAPI MetricsServer::ServerThreadProc(LPVOID param) {
+    auto* server = static_cast<MetricsServer*>(param);
+    server->serverThreadMain();
+    return 0;
+}
+
+void MetricsServer::serverThreadMain() {
+    while (m_running.load()) {
+        SOCKET clientSocket = accept(m_listenerSocket, nullptr, nullptr);
+        if (clientSocket == INVALID_SOCKET) {
+            if (m_running.load()) {
+                LOG_ERROR("MetricsServer: accept() failed: {}", WSAGetLastError());
+            }
+            break;
+        }
+
+        serveClient(clientSocket);
+        closesocket(clientSocket);
+    }
+}
+
+void MetricsServer::serveClient(SOCKET clientSocket) {
+    // Consume the request; every path is answered with the same exposition
+    DWORD timeout = kRequestTimeoutMs;
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    char request[2048];
+    recv(clientSocket, request, sizeof(request), 0);
+
+    const std::string body = m_renderer ? m_renderer() : std::string();
+    std::string response = "HTTP/1.0 200 OK\r\n"
+                           "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                           "Connection: close\r\n"
+                           "Content-Length: " +
+                           std::to_string(body.size()) + "\r\n\r\n";
+    response += body;
+
+    size_t totalSent = 0;
+    while (totalSent < response.size()) {
+        int sent = send(clientSocket, response.data() + totalSent, static_cast<int>(response.size() - totalSent), 0);
+        if (sent == SOCKET_ERROR) {
+            LOG_DEBUG("MetricsServer: send() failed: {}", WSAGetLastError());
+            return;
+        }
+        totalSent += static_cast<size_t>(sent);
+    }
+    shutdown(clientSocket, SD_SEND);
+}
+
+} // namespace icecap::agent::transport
@@ -3,6 +3,7 @@
 
 #include <google/protobuf/util/json_util.h>
 
+#include <icecap/agent/core/Tracer.hpp>
 #include <icecap/agent/logging.hpp>
 #include <icecap/agent/transport/NetworkManager.hpp>
 
@@ -15,8 +16,8 @@ NetworkManager::~NetworkManager() {
     stopServer();
 }
 
-bool NetworkManager::startServer(std::queue<IncomingMessage>& inbox, std::queue<OutgoingMessage>& outbox,
-                                 unsigned short port, std::mutex& inboxMutex, std::mutex& outboxMutex) {
+bool NetworkManager::startServer(std::queue<QueuedCommand>& inbox, std::queue<QueuedEvent>& outbox, unsigned short port,
+                                 std::mutex& inboxMutex, std::mutex& outboxMutex) {
     if (m_running.load()) {
         LOG_WARN("NetworkManager: Server is already running");
         return false;
@@ -35,12 +36,17 @@ bool NetworkManager::startServer(std::queue<IncomingMessage>& inbox, std::queue<
     m_tcpServer->setErrorCallback([this](const std::string& error) { onNetworkError(error); });
 
     // Set up protocol handler callbacks
-    m_protocolHandler->setMessageCallback([this](const std::string& message) { onMessageReceived(message); });
+    m_protocolHandler->setMessageCallback([this](const std::string& message) {
+        core::CommandTimeline timeline;
+        timeline.stamp(core::CommandStage::RECEIVED);
+        timeline.stamp(core::CommandStage::FRAMED);
+        onMessageReceived(message, timeline);
+    });
     m_protocolHandler->setErrorCallback([this](const std::string& error) { onProtocolError(error); });
 
     // Start TCP server
     if (!m_tcpServer->start(port)) {
-        LOG_ERROR("NetworkManager: Failed to start TCP server on port " + std::to_string(port));
+        LOG_ERROR("NetworkManager: Failed to start TCP server on port {}", port);
         return false;
     }
 
@@ -51,13 +57,13 @@ bool NetworkManager::startServer(std::queue<IncomingMessage>& inbox, std::queue<
         m_outgoingMessageThread = std::thread(&NetworkManager::outgoingMessageThreadMain, this);
         LOG_DEBUG("NetworkManager: Started outgoing message processing thread");
     } catch (const std::exception& e) {
-        LOG_ERROR("NetworkManager: Failed to start outgoing message thread: " + std::string(e.what()));
+        LOG_ERROR("NetworkManager: Failed to start outgoing message thread: {}", e.what());
         m_running.store(false);
         m_tcpServer->stop();
         return false;
     }
 
-    LOG_INFO("NetworkManager: Started on port " + std::to_string(port));
+    LOG_INFO("NetworkManager: Started on port {}", port);
     return true;
 }
 
@@ -99,6 +105,18 @@ void NetworkManager::stopServer() {
     LOG_INFO("NetworkManager: Stopped");
 }
 
+void NetworkManager::setQueryHandler(QueryHandler handler) {
+    m_queryHandler = std::move(handler);
+}
+
+void NetworkManager::setLatencyRecorder(core::CommandLatencyRecorder* recorder) {
+    m_latencyRecorder = recorder;
+}
+
+void NetworkManager::setMetrics(core::AgentMetrics* metrics) {
+    m_metrics = metrics;
+}
+
 bool NetworkManager::isRunning() const {
     return m_running.load() && m_tcpServer && m_tcpServer->isRunning();
 }
@@ -108,13 +126,22 @@ void NetworkManager::onDataReceived(const char* data, size_t length) {
         return;
     }
 
+    // Every frame completed by this read shares its receive time
+    const int64_t receivedMicros = core::CommandTimeline::nowMicros();
+    if (m_metrics) {
+        m_metrics->recordBytesIn(length);
+    }
+
     // Append to receive buffer
     m_receiveBuffer.append(data, length);
 
     // Try to extract complete frames
     std::string frame;
     while (m_protocolHandler->extractFrame(m_receiveBuffer, frame)) {
-        onMessageReceived(frame);
+        core::CommandTimeline timeline;
+        timeline.micros[static_cast<size_t>(core::CommandStage::RECEIVED)] = receivedMicros;
+        timeline.stamp(core::CommandStage::FRAMED);
+        onMessageReceived(frame, timeline);
     }
 }
 
@@ -122,6 +149,9 @@ void NetworkManager::onClientConnected(SOCKET clientSocket) {
     LOG_INFO("NetworkManager: Client connected");
     m_currentClient = clientSocket;
     m_receiveBuffer.clear();
+    if (m_metrics) {
+        m_metrics->recordConnection();
+    }
 }
 
 void NetworkManager::onClientDisconnected(SOCKET clientSocket) {
@@ -133,14 +163,16 @@ void NetworkManager::onClientDisconnected(SOCKET clientSocket) {
 }
 
 void NetworkManager::onNetworkError(const std::string& error) {
-    LOG_ERROR("NetworkManager: Network error: " + error);
+    LOG_ERROR("NetworkManager: Network error: {}", error);
 }
 
-void NetworkManager::onMessageReceived(const std::string& message) {
+void NetworkManager::onMessageReceived(const std::string& message, core::CommandTimeline& timeline) {
     if (!m_running.load() || !m_inboxQueue || !m_inboxMutex) {
         return;
     }
 
+    TRACE_SCOPE("NetworkManager::onMessageReceived", "bytes", message.size());
+
     // Parse protobuf message
     IncomingMessage command;
     if (!command.ParseFromString(message)) {
@@ -148,17 +180,38 @@ void NetworkManager::onMessageReceived(const std::string& message) {
         return;
     }
 
-    LOG_DEBUG("NetworkManager: Received command with ID '" + command.id() + "'");
+    timeline.stamp(core::CommandStage::PARSED);
+    timeline.commandType = static_cast<uint32_t>(command.type());
+
+    LOG_DEBUG("NetworkManager: Received command with ID '{}'", command.id());
+
+    // Read-only queries are answered from the published game state, skipping the frame wait
+    if (m_queryHandler) {
+        OutgoingMessage response;
+        if (m_queryHandler(command, timeline, response)) {
+            timeline.stamp(core::CommandStage::EXECUTED);
+            if (m_metrics) {
+                m_metrics->recordCommand(timeline.commandType,
+                                         response.type() == icecap::agent::v1::EVENT_TYPE_OPERATION_FAILED);
+            }
+            sendEvent(response, timeline);
+            return;
+        }
+    }
 
     // Add to inbox queue
     {
         std::lock_guard<std::mutex> lock(*m_inboxMutex);
-        m_inboxQueue->push(std::move(command));
+        timeline.stamp(core::CommandStage::ENQUEUED);
+        m_inboxQueue->push({std::move(command), timeline, message.size()});
+    }
+    if (m_metrics) {
+        m_metrics->recordInboxPush(message.size());
     }
 }
 
 void NetworkManager::onProtocolError(const std::string& error) {
-    LOG_ERROR("NetworkManager: Protocol error: " + error);
+    LOG_ERROR("NetworkManager: Protocol error: {}", error);
 }
 
 void NetworkManager::processOutgoingMessages() {
@@ -167,39 +220,62 @@ void NetworkManager::processOutgoingMessages() {
     }
 
     // Process all pending outgoing messages
-    std::queue<OutgoingMessage> localQueue;
+    std::queue<QueuedEvent> localQueue;
     {
         std::lock_guard<std::mutex> lock(*m_outboxMutex);
         localQueue.swap(*m_outboxQueue);
     }
 
     while (!localQueue.empty()) {
-        const auto& event = localQueue.front();
-
-        // Serialize to protobuf
-        std::string serialized;
-        if (!event.SerializeToString(&serialized)) {
-            LOG_ERROR("NetworkManager: Failed to serialize outgoing event with ID '" + event.id() + "'");
-            localQueue.pop();
-            continue;
+        auto& entry = localQueue.front();
+        if (m_metrics) {
+            m_metrics->recordOutboxPop(entry.bytes);
         }
+        sendEvent(entry.event, entry.timeline);
+        localQueue.pop();
+    }
+}
 
-        // Encode with protocol handler
-        std::string encoded = m_protocolHandler->encodeMessage(serialized);
+bool NetworkManager::sendEvent(const OutgoingMessage& event, core::CommandTimeline& timeline) {
+    TRACE_SCOPE("NetworkManager::sendEvent", "type", static_cast<uint64_t>(event.type()));
 
-        // Send via TCP
-        if (!m_tcpServer->sendData(m_currentClient, encoded.data(), encoded.size())) {
-            LOG_ERROR("NetworkManager: Failed to send event with ID '" + event.id() + "'");
-        } else {
-            LOG_DEBUG("NetworkManager: Sent event with ID '" + event.id() + "'");
-        }
+    // Serialize to protobuf
+    std::string serialized;
+    if (!event.SerializeToString(&serialized)) {
+        LOG_ERROR("NetworkManager: Failed to serialize outgoing event with ID '{}'", event.id());
+        return false;
+    }
 
-        localQueue.pop();
+    // Encode with protocol handler
+    std::string encoded = m_protocolHandler->encodeMessage(serialized);
+
+    // Send via TCP; frames from different threads must not interleave
+    bool sent = false;
+    {
+        std::lock_guard<std::mutex> lock(m_sendMutex);
+        sent = m_tcpServer->sendData(m_currentClient, encoded.data(), encoded.size());
     }
+
+    if (!sent) {
+        LOG_ERROR("NetworkManager: Failed to send event with ID '{}'", event.id());
+        return false;
+    }
+
+    if (m_metrics) {
+        m_metrics->recordBytesOut(encoded.size());
+    }
+    if (timeline.isActive() && m_latencyRecorder) {
+        timeline.stamp(core::CommandStage::SENT);
+        m_latencyRecorder->record(timeline);
+    }
+
+    LOG_DEBUG("NetworkManager: Sent event with ID '{}'", event.id());
+    return true;
 }
 
 void NetworkManager::outgoingMessageThreadMain() {
     LOG_DEBUG("NetworkManager: Outgoing message thread started");
+    core::Tracer::nameThread("NetworkManager outbox");
 
     while (m_running.load()) {
         try {
@@ -212,7 +288,7 @@ void NetworkManager::outgoingMessageThreadMain() {
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
 
         } catch (const std::exception& e) {
-            LOG_ERROR("NetworkManager: Exception in outgoing message thread: " + std::string(e.what()));
+            LOG_ERROR("NetworkManager: Exception in outgoing message thread: {}", e.what());
             // Continue running even if there's an error
         } catch (...) {
             LOG_ERROR("NetworkManager: Unknown exception in outgoing message thread");
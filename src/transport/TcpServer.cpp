@@ -1,5 +1,6 @@
 #include <vector>
 
+#include <icecap/agent/core/Tracer.hpp>
 #include <icecap/agent/logging.hpp>
 #include <icecap/agent/transport/TcpServer.hpp>
 
@@ -85,7 +86,7 @@ bool TcpServer::start(unsigned short port) {
         return false;
     }
 
-    LOG_INFO("TCP Server started on port " + std::to_string(port));
+    LOG_INFO("TCP Server started on port {}", port);
     return true;
 }
 
@@ -94,7 +95,7 @@ void TcpServer::stop() {
         return;
     }
 
-    LOG_INFO("Stopping TCP Server on port " + std::to_string(m_port));
+    LOG_INFO("Stopping TCP Server on port {}", m_port);
     m_running.store(false);
 
     // Shutdown client socket to unblock recv() in handleClient()
@@ -159,6 +160,7 @@ DWORD WINAPI TcpServer::ServerThreadProc(LPVOID param) {
 
 void TcpServer::serverThreadMain() {
     LOG_INFO("TCP Server thread started");
+    core::Tracer::nameThread("TcpServer");
 
     while (m_running.load()) {
         SOCKET clientSocket = accept(m_listenerSocket, nullptr, nullptr);
@@ -210,13 +212,14 @@ void TcpServer::handleClient(SOCKET clientSocket) {
             if (received == 0) {
                 LOG_DEBUG("Client closed connection");
             } else {
-                LOG_ERROR("recv() failed: " + std::to_string(WSAGetLastError()));
+                LOG_ERROR("recv() failed: {}", WSAGetLastError());
             }
             break;
         }
 
         // Notify callback about received data
         if (m_dataCallback) {
+            TRACE_SCOPE("TcpServer::onData", "bytes", static_cast<uint64_t>(received));
             m_dataCallback(buffer.data(), static_cast<size_t>(received));
         }
     }
@@ -0,0 +1,38 @@
+#ifndef ICECAP_AGENT_TESTS_BENCH_UTIL_HPP
+#define ICECAP_AGENT_TESTS_BENCH_UTIL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+namespace icecap::agent::tests {
+
+// Mean wall time of one `body()` call over `iterations` calls, in microseconds
+template <typename Body>
+double measureMicros(size_t iterations, Body&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        body(i);
+    }
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+// Abort the benchmark when an optimized path disagrees with its reference
+inline void require(bool condition, const char* what) {
+    if (!condition) {
+        std::fprintf(stderr, "MISMATCH: %s\n", what);
+        std::exit(1);
+    }
+}
+
+// Keep the optimizer from discarding a result
+template <typename T>
+void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace icecap::agent::tests
+
+#endif // ICECAP_AGENT_TESTS_BENCH_UTIL_HPP
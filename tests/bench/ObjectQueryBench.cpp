@@ -0,0 +1,120 @@
+// Columnar ObjectQuery evaluation against the same filter hand-written as a row-at-a-time loop, i.e. the cost of
+// interpreting a query instead of compiling it in. Every query's rows are checked against its loop before timing.
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <icecap/agent/core/ObjectQuery.hpp>
+
+#include "BenchUtil.hpp"
+
+using icecap::agent::core::ObjectQuery;
+using icecap::agent::core::ObjectTable;
+using icecap::agent::core::ObjectType;
+using icecap::agent::tests::doNotOptimize;
+using icecap::agent::tests::measureMicros;
+using icecap::agent::tests::require;
+
+namespace {
+
+constexpr float kZoneSize = 400.0f;
+constexpr size_t kIterations = 2000;
+
+ObjectTable makeTable(size_t count, std::mt19937& random) {
+    std::uniform_real_distribution<float> horizontal(0.0f, kZoneSize);
+    std::uniform_int_distribution<uint32_t> health(0, 5000);
+    const ObjectType types[] = {ObjectType::UNIT, ObjectType::UNIT, ObjectType::PLAYER, ObjectType::GAMEOBJECT};
+
+    ObjectTable table;
+    table.resize(count);
+    for (size_t row = 0; row < count; ++row) {
+        table.guid[row] = row + 1;
+        table.type[row] = types[row % std::size(types)];
+        table.x[row] = horizontal(random);
+        table.y[row] = horizontal(random);
+        table.z[row] = 0.0f;
+        if (table.type[row] != ObjectType::GAMEOBJECT) {
+            table.maxHealth[row] = 5000;
+            table.health[row] = health(random);
+            table.level[row] = 1 + static_cast<uint32_t>(row % 80);
+            table.targetGuid[row] = row % 7 == 0 ? 1 : 0;
+        }
+    }
+    table.localPlayerGuid = count / 2;
+    return table;
+}
+
+float distance(const ObjectTable& table, size_t row, size_t self) {
+    const float dx = table.x[row] - table.x[self];
+    const float dy = table.y[row] - table.y[self];
+    const float dz = table.z[row] - table.z[self];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Time one query against `matches(table, row, localPlayerRow)`, written as the equivalent loop over rows
+template <typename Match>
+void runCase(const ObjectTable& table, const char* text, Match matches) {
+    const size_t self = *table.find(table.localPlayerGuid);
+    const auto reference = [&](std::vector<size_t>& rows) {
+        rows.clear();
+        for (size_t row = 0; row < table.size(); ++row) {
+            if (matches(table, row, self)) {
+                rows.push_back(row);
+            }
+        }
+    };
+
+    std::string error;
+    const auto query = ObjectQuery::compile(text, error);
+    require(query.has_value(), text);
+
+    std::vector<size_t> rows;
+    std::vector<size_t> expected;
+    query->select(table, rows);
+    reference(expected);
+    require(rows == expected, text);
+
+    const double compileUs = measureMicros(kIterations, [&](size_t) {
+        doNotOptimize(ObjectQuery::compile(text, error).has_value());
+    });
+    const double queryUs = measureMicros(kIterations, [&](size_t) {
+        query->select(table, rows);
+        doNotOptimize(rows.data());
+    });
+    const double referenceUs = measureMicros(kIterations, [&](size_t) {
+        reference(expected);
+        doNotOptimize(expected.data());
+    });
+    std::printf("%5zu entities  %4zu rows  compile %5.2f us  query %7.2f us  row loop %7.2f us  (%.1fx)  %s\n",
+                table.size(), rows.size(), compileUs, queryUs, referenceUs, referenceUs / queryUs, text);
+}
+
+void run(size_t entities, std::mt19937& random) {
+    const ObjectTable table = makeTable(entities, random);
+
+    runCase(table, "type == UNIT && hp_pct < 35 && dist < 40 -> guid, hp, pos",
+            [](const ObjectTable& t, size_t row, size_t self) {
+                return t.type[row] == ObjectType::UNIT && t.maxHealth[row] != 0 &&
+                       100.0f * static_cast<float>(t.health[row]) / t.maxHealth[row] < 35.0f &&
+                       distance(t, row, self) < 40.0f;
+            });
+    runCase(table, "target == 1 || (level >= 70 && !(type == PLAYER))", [](const ObjectTable& t, size_t row, size_t) {
+        return t.targetGuid[row] == 1 || (t.level[row] >= 70 && t.type[row] != ObjectType::PLAYER);
+    });
+    runCase(table, "x > 100 && x < 300 && y > 100 && y < 300", [](const ObjectTable& t, size_t row, size_t) {
+        return t.x[row] > 100.0f && t.x[row] < 300.0f && t.y[row] > 100.0f && t.y[row] < 300.0f;
+    });
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 random(12340);
+    for (const size_t entities : {1000u, 5000u}) {
+        run(entities, random);
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+// PageCachedMemoryReader against the per-read system call it replaces, over real host memory.
+// The region source validates with mincore (standing in for VirtualQuery) and copies with memcpy; the baseline
+// reader issues one process_vm_readv per value or string chunk, like the former ReadProcessMemory path. Every
+// value and string is checked against the buffer before anything is timed.
+
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <icecap/agent/core/PageCachedMemoryReader.hpp>
+
+#include "BenchUtil.hpp"
+
+using icecap::agent::core::PageCachedMemoryReader;
+using icecap::agent::tests::doNotOptimize;
+using icecap::agent::tests::measureMicros;
+using icecap::agent::tests::require;
+
+namespace {
+
+constexpr size_t kBufferSize = 1 << 20;
+constexpr size_t kReads = 4096;
+constexpr size_t kMaxString = 1024;
+
+// One mapped buffer; every query costs a mincore call over the page holding the address
+class HostRegionSource : public icecap::agent::interfaces::IMemoryRegionSource {
+public:
+    HostRegionSource(const uint8_t* buffer, size_t size)
+        : m_begin(reinterpret_cast<uintptr_t>(buffer)), m_end(m_begin + size) {}
+
+    bool queryReadableRegion(uintptr_t address, uintptr_t& begin, uintptr_t& end) const override {
+        const uintptr_t page = address & ~uintptr_t{4095};
+        unsigned char resident = 0;
+        if (address < m_begin || address >= m_end || mincore(reinterpret_cast<void*>(page), 1, &resident) != 0) {
+            return false;
+        }
+        begin = m_begin;
+        end = m_end;
+        return true;
+    }
+
+    bool copy(uintptr_t address, void* out, size_t size) const override {
+        std::memcpy(out, reinterpret_cast<const void*>(address), size);
+        return true;
+    }
+
+private:
+    uintptr_t m_begin;
+    uintptr_t m_end;
+};
+
+// A system call per read, with the IMemoryReader default (byte-scanning) string reader on top
+class SyscallMemoryReader : public icecap::agent::interfaces::IMemoryReader {
+public:
+    bool read(uintptr_t address, void* out, size_t size) const override {
+        iovec local{out, size};
+        iovec remote{reinterpret_cast<void*>(address), size};
+        return process_vm_readv(getpid(), &local, 1, &remote, 1, 0) == static_cast<ssize_t>(size);
+    }
+};
+
+} // namespace
+
+int main() {
+    // Page-aligned so mincore sees whole pages of the buffer
+    auto* buffer = static_cast<uint8_t*>(
+        mmap(nullptr, kBufferSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    require(buffer != MAP_FAILED, "mmap");
+
+    std::mt19937 random(12340);
+    for (size_t i = 0; i < kBufferSize; ++i) {
+        buffer[i] = static_cast<uint8_t>('a' + random() % 26);
+    }
+    const auto base = reinterpret_cast<uintptr_t>(buffer);
+
+    HostRegionSource source(buffer, kBufferSize);
+    PageCachedMemoryReader cached(source);
+    SyscallMemoryReader syscall;
+
+    // Values at random offsets, as an event's arguments or an object walk would touch them
+    std::vector<uintptr_t> addresses(kReads);
+    for (auto& address : addresses) {
+        address = base + (random() % (kBufferSize / 8)) * 8;
+    }
+    for (const uintptr_t address : addresses) {
+        uint32_t fast = 0;
+        uint32_t slow = 0;
+        require(cached.readValue(address, fast) && syscall.readValue(address, slow) && fast == slow &&
+                    std::memcmp(&fast, reinterpret_cast<const void*>(address), sizeof(fast)) == 0,
+                "value read");
+    }
+
+    uint32_t value = 0;
+    const double cachedUs = measureMicros(kReads, [&](size_t i) {
+        cached.readValue(addresses[i], value);
+        doNotOptimize(value);
+    });
+    const double validatedUs = measureMicros(kReads, [&](size_t i) {
+        cached.invalidate();
+        cached.readValue(addresses[i], value);
+        doNotOptimize(value);
+    });
+    const double syscallUs = measureMicros(kReads, [&](size_t i) {
+        syscall.readValue(addresses[i], value);
+        doNotOptimize(value);
+    });
+    std::printf("uint32      cached %8.1f ns  query per read %8.1f ns  syscall per read %8.1f ns  (%.0fx)\n",
+                cachedUs * 1000.0, validatedUs * 1000.0, syscallUs * 1000.0, syscallUs / cachedUs);
+
+    for (const size_t length : {8u, 63u, 300u, 1000u}) {
+        // NUL-terminate strings of `length` characters at random offsets
+        std::vector<uintptr_t> strings(256);
+        for (auto& address : strings) {
+            address = base + random() % (kBufferSize - kMaxString - 1);
+            buffer[address - base + length] = '\0';
+        }
+
+        std::string fast;
+        std::string slow;
+        for (const uintptr_t address : strings) {
+            require(cached.readString(address, fast, kMaxString) && syscall.readString(address, slow, kMaxString) &&
+                        fast == slow && fast == std::string(reinterpret_cast<const char*>(address)),
+                    "string read");
+        }
+
+        const double cachedStringUs = measureMicros(kReads, [&](size_t i) {
+            cached.readString(strings[i % strings.size()], fast, kMaxString);
+            doNotOptimize(fast.data());
+        });
+        const double syscallStringUs = measureMicros(kReads, [&](size_t i) {
+            syscall.readString(strings[i % strings.size()], slow, kMaxString);
+            doNotOptimize(slow.data());
+        });
+        std::printf("string %4zu  cached %8.1f ns  syscall per chunk %8.1f ns  (%.0fx)\n", length,
+                    cachedStringUs * 1000.0, syscallStringUs * 1000.0, syscallStringUs / cachedStringUs);
+
+        // Lift the terminators so they do not shorten the next round's strings
+        for (const uintptr_t address : strings) {
+            buffer[address - base + length] = 'a';
+        }
+    }
+
+    const auto& stats = cached.getStats();
+    std::printf("cache       %llu hits  %llu misses  %llu invalidations\n",
+                static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+                static_cast<unsigned long long>(stats.invalidations));
+
+    munmap(buffer, kBufferSize);
+    return 0;
+}
@@ -0,0 +1,118 @@
+// SignatureScanner against a brute-force masked comparison at every offset, over a synthetic code section
+// with the byte distribution of x86 code. Every match list is checked against the brute-force one before timing.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <icecap/agent/core/SignatureScanner.hpp>
+
+#include "BenchUtil.hpp"
+
+using icecap::agent::core::Signature;
+using icecap::agent::core::SignatureScanner;
+using icecap::agent::tests::doNotOptimize;
+using icecap::agent::tests::measureMicros;
+using icecap::agent::tests::require;
+
+namespace {
+
+constexpr size_t kImageSize = 8 << 20; // About the size of the build 12340 .text section
+constexpr size_t kIterations = 5;
+
+// The build 12340 signatures from GameAddresses.cpp, and how often each is planted
+struct Pattern {
+    const char* name;
+    const char* text;
+    size_t copies;
+};
+
+constexpr Pattern kPatterns[] = {
+    {"FrameScript_Execute", "55 8B EC 51 83 05 ?? ?? ?? ?? 01 A1 ?? ?? ?? ?? 89 45 FC 74 ?? 83 3D ?? ?? ?? ?? 00", 1},
+    {"FrameScript_GetText", "55 8B EC 81 EC ?? ?? ?? ?? 8B 0D ?? ?? ?? ?? 53 56 57 6A 00", 1},
+    {"CGPlayer_C__ClickToMove", "55 8B EC 83 EC ?? 53 56 8B F1 8B 46 ?? 57 8B 7D 08", 1},
+    {"FrameScript__SignalEvent", "55 8B EC 81 EC ?? ?? ?? ?? 53 56 57 8B 7D 08 81 FF", 1},
+    {"g_theGxDevicePtr", "8B 0D ?? ?? ?? ?? 8B 81 7C 39 00 00", 3},
+};
+
+// Mostly the opcodes and operands that dominate compiled x86, the rest uniform
+std::vector<uint8_t> makeImage(std::mt19937& random) {
+    static constexpr uint8_t kCommon[] = {0x00, 0x00, 0x00, 0x8B, 0x8B, 0x89, 0x55, 0xE8, 0xFF, 0xCC,
+                                          0x83, 0xEC, 0x45, 0x08, 0x0D, 0x56, 0x57, 0x53, 0x5D, 0xC3};
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::uniform_int_distribution<int> any(0, 255);
+
+    std::vector<uint8_t> image(kImageSize);
+    for (auto& byte : image) {
+        byte = pick(random) < 60 ? kCommon[static_cast<size_t>(pick(random)) % std::size(kCommon)]
+                                 : static_cast<uint8_t>(any(random));
+    }
+    return image;
+}
+
+// Write `signature` at `offset`, filling wildcards with random bytes
+void plant(std::vector<uint8_t>& image, const Signature& signature, size_t offset, std::mt19937& random) {
+    for (size_t i = 0; i < signature.size(); ++i) {
+        image[offset + i] = signature.mask[i] != 0 ? signature.bytes[i] : static_cast<uint8_t>(random());
+    }
+}
+
+std::vector<size_t> bruteForce(const std::vector<uint8_t>& image, const Signature& signature) {
+    std::vector<size_t> matches;
+    for (size_t offset = 0; offset + signature.size() <= image.size(); ++offset) {
+        bool match = true;
+        for (size_t i = 0; i < signature.size() && match; ++i) {
+            match = (image[offset + i] & signature.mask[i]) == signature.bytes[i];
+        }
+        if (match) {
+            matches.push_back(offset);
+        }
+    }
+    return matches;
+}
+
+std::vector<size_t> scanAll(const std::vector<uint8_t>& image, const Signature& signature) {
+    std::vector<size_t> matches;
+    for (size_t position = SignatureScanner::find(image.data(), image.size(), signature);
+         position != SignatureScanner::kNotFound;
+         position = SignatureScanner::find(image.data(), image.size(), signature, position + 1)) {
+        matches.push_back(position);
+    }
+    return matches;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 random(12340);
+    std::vector<uint8_t> image = makeImage(random);
+
+    std::vector<Signature> signatures;
+    std::uniform_int_distribution<size_t> offset(0, kImageSize - 64);
+    for (const auto& pattern : kPatterns) {
+        const auto signature = Signature::parse(pattern.text);
+        require(signature.has_value(), pattern.name);
+        for (size_t copy = 0; copy < pattern.copies; ++copy) {
+            plant(image, *signature, offset(random), random);
+        }
+        signatures.push_back(*signature);
+    }
+
+    const double megabytes = static_cast<double>(kImageSize) / (1 << 20);
+    for (size_t i = 0; i < signatures.size(); ++i) {
+        const auto expected = bruteForce(image, signatures[i]);
+        require(scanAll(image, signatures[i]) == expected, kPatterns[i].name);
+        require(expected.size() >= kPatterns[i].copies, kPatterns[i].name);
+
+        const double scanUs = measureMicros(kIterations, [&](size_t) {
+            doNotOptimize(scanAll(image, signatures[i]).size());
+        });
+        const double bruteUs = measureMicros(kIterations, [&](size_t) {
+            doNotOptimize(bruteForce(image, signatures[i]).size());
+        });
+        std::printf("%-26s %zu matches  scanner %7.2f ms (%6.0f MB/s)  brute force %7.2f ms  (%.1fx)\n",
+                    kPatterns[i].name, expected.size(), scanUs / 1000.0, megabytes / (scanUs / 1e6),
+                    bruteUs / 1000.0, bruteUs / scanUs);
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Radius and nearest-neighbour queries through SpatialIndex against a brute-force scan of the same table.
+// Every index answer is checked against the reference before anything is timed.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <icecap/agent/core/SpatialIndex.hpp>
+
+#include "BenchUtil.hpp"
+
+using icecap::agent::core::ObjectTable;
+using icecap::agent::core::ObjectType;
+using icecap::agent::core::SpatialIndex;
+using icecap::agent::tests::doNotOptimize;
+using icecap::agent::tests::measureMicros;
+using icecap::agent::tests::require;
+
+namespace {
+
+constexpr float kZoneSize = 1600.0f; // Objects spread over about three map tiles
+constexpr size_t kQueries = 2000;
+constexpr size_t kNearestCount = 10;
+
+struct Query {
+    float x;
+    float y;
+    float z;
+};
+
+ObjectTable makeTable(size_t count, std::mt19937& random) {
+    std::uniform_real_distribution<float> horizontal(0.0f, kZoneSize);
+    std::uniform_real_distribution<float> vertical(0.0f, 50.0f);
+    const ObjectType types[] = {ObjectType::UNIT, ObjectType::PLAYER, ObjectType::GAMEOBJECT};
+
+    ObjectTable table;
+    table.resize(count);
+    for (size_t row = 0; row < count; ++row) {
+        table.guid[row] = row + 1;
+        table.type[row] = types[row % std::size(types)];
+        table.x[row] = horizontal(random);
+        table.y[row] = horizontal(random);
+        table.z[row] = vertical(random);
+    }
+    return table;
+}
+
+std::vector<SpatialIndex::Neighbor> bruteForce(const ObjectTable& table, const Query& query, float radius,
+                                               size_t nearest) {
+    std::vector<SpatialIndex::Neighbor> results;
+    for (size_t row = 0; row < table.size(); ++row) {
+        const float dx = table.x[row] - query.x;
+        const float dy = table.y[row] - query.y;
+        const float dz = table.z[row] - query.z;
+        const float distanceSquared = dx * dx + dy * dy + dz * dz;
+        if (radius == 0.0f || distanceSquared <= radius * radius) {
+            results.push_back({row, distanceSquared});
+        }
+    }
+
+    const auto closer = [](const auto& a, const auto& b) { return a.distanceSquared < b.distanceSquared; };
+    if (nearest != 0 && results.size() > nearest) {
+        std::partial_sort(results.begin(), results.begin() + static_cast<std::ptrdiff_t>(nearest), results.end(),
+                          closer);
+        results.resize(nearest);
+    } else {
+        std::sort(results.begin(), results.end(), closer);
+    }
+    return results;
+}
+
+// Same rows in the same distance order; rows at exactly the same distance may come in either order
+bool sameRows(std::vector<SpatialIndex::Neighbor> a, std::vector<SpatialIndex::Neighbor> b) {
+    const auto byDistanceThenRow = [](const auto& left, const auto& right) {
+        return left.distanceSquared != right.distanceSquared ? left.distanceSquared < right.distanceSquared
+                                                             : left.row < right.row;
+    };
+    std::sort(a.begin(), a.end(), byDistanceThenRow);
+    std::sort(b.begin(), b.end(), byDistanceThenRow);
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const auto& left, const auto& right) { return left.row == right.row; });
+}
+
+void run(size_t entities, std::mt19937& random) {
+    const ObjectTable table = makeTable(entities, random);
+
+    std::uniform_real_distribution<float> horizontal(0.0f, kZoneSize);
+    std::vector<Query> queries(kQueries);
+    for (auto& query : queries) {
+        query = {horizontal(random), horizontal(random), 25.0f};
+    }
+
+    SpatialIndex index;
+    uint64_t version = 0;
+    const double buildUs = measureMicros(200, [&](size_t) { index.build(table, ++version); });
+
+    std::vector<SpatialIndex::Neighbor> results;
+    for (const float radius : {30.0f, 100.0f}) {
+        for (const auto& query : queries) {
+            index.queryRadius(query.x, query.y, query.z, radius, 0, results);
+            require(sameRows(results, bruteForce(table, query, radius, 0)), "radius query");
+        }
+
+        const double indexUs = measureMicros(kQueries, [&](size_t i) {
+            index.queryRadius(queries[i].x, queries[i].y, queries[i].z, radius, 0, results);
+            doNotOptimize(results.data());
+        });
+        const double bruteUs = measureMicros(kQueries, [&](size_t i) {
+            doNotOptimize(bruteForce(table, queries[i], radius, 0).size());
+        });
+        std::printf("%5zu entities  radius %5.0f  index %8.2f us  brute force %8.2f us  (%.1fx)\n", entities, radius,
+                    indexUs, bruteUs, bruteUs / indexUs);
+    }
+
+    for (const auto& query : queries) {
+        index.queryNearest(query.x, query.y, query.z, kNearestCount, 0.0f, 0, results);
+        require(sameRows(results, bruteForce(table, query, 0.0f, kNearestCount)), "nearest query");
+    }
+
+    const double indexUs = measureMicros(kQueries, [&](size_t i) {
+        index.queryNearest(queries[i].x, queries[i].y, queries[i].z, kNearestCount, 0.0f, 0, results);
+        doNotOptimize(results.data());
+    });
+    const double bruteUs = measureMicros(kQueries, [&](size_t i) {
+        doNotOptimize(bruteForce(table, queries[i], 0.0f, kNearestCount).size());
+    });
+    std::printf("%5zu entities  %zu nearest    index %8.2f us  brute force %8.2f us  (%.1fx)\n", entities,
+                kNearestCount, indexUs, bruteUs, bruteUs / indexUs);
+    std::printf("%5zu entities  build        %8.2f us\n", entities, buildUs);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 random(12340);
+    for (const size_t entities : {1000u, 5000u}) {
+        run(entities, random);
+    }
+    return 0;
+}
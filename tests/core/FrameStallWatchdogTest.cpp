@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <icecap/agent/core/FrameStallWatchdog.hpp>
+
+using icecap::agent::core::FrameStallWatchdog;
+using icecap::agent::core::SlowFrame;
+
+namespace {
+
+constexpr size_t kRealNames = FrameStallWatchdog::kMaxScriptsPerFrame - 1;
+
+std::string scriptName(size_t index) {
+    return "script" + std::to_string(index);
+}
+
+} // namespace
+
+TEST(FrameStallWatchdogTest, FastFramesAreNotRecorded) {
+    FrameStallWatchdog watchdog;
+    watchdog.setThreshold(100);
+
+    SlowFrame slowFrame;
+    watchdog.beginFrame(1, 0);
+    watchdog.onScriptExecuted("fast", 10);
+    EXPECT_FALSE(watchdog.endFrame(100, slowFrame));
+    EXPECT_TRUE(watchdog.getHistory().empty());
+}
+
+TEST(FrameStallWatchdogTest, RepeatedNamesShareAnEntry) {
+    FrameStallWatchdog watchdog;
+    watchdog.setThreshold(100);
+
+    SlowFrame slowFrame;
+    watchdog.beginFrame(7, 0);
+    watchdog.onScriptExecuted("a", 10);
+    watchdog.onScriptExecuted("b", 20);
+    watchdog.onScriptExecuted("a", 30);
+    ASSERT_TRUE(watchdog.endFrame(500, slowFrame));
+
+    EXPECT_EQ(slowFrame.frameNumber, 7u);
+    EXPECT_EQ(slowFrame.agentMicros, 500);
+    ASSERT_EQ(slowFrame.scripts.size(), 2u);
+    EXPECT_EQ(slowFrame.scripts[0].name, "a");
+    EXPECT_EQ(slowFrame.scripts[0].count, 2u);
+    EXPECT_EQ(slowFrame.scripts[0].elapsedMicros, 40);
+    EXPECT_EQ(slowFrame.scripts[1].name, "b");
+    EXPECT_EQ(slowFrame.scripts[1].count, 1u);
+}
+
+TEST(FrameStallWatchdogTest, OverflowNamesGoToTheReservedSlot) {
+    FrameStallWatchdog watchdog;
+    watchdog.setThreshold(100);
+
+    SlowFrame slowFrame;
+    watchdog.beginFrame(1, 0);
+    for (size_t i = 0; i < kRealNames + 3; ++i) {
+        watchdog.onScriptExecuted(scriptName(i), 10);
+    }
+    // A real name that was kept still gets its own entry after the overflow starts
+    watchdog.onScriptExecuted(scriptName(kRealNames - 1), 5);
+    watchdog.onScriptExecuted(scriptName(kRealNames + 5), 1);
+    ASSERT_TRUE(watchdog.endFrame(500, slowFrame));
+
+    ASSERT_EQ(slowFrame.scripts.size(), FrameStallWatchdog::kMaxScriptsPerFrame);
+    for (size_t i = 0; i < kRealNames; ++i) {
+        EXPECT_EQ(slowFrame.scripts[i].name, scriptName(i));
+    }
+    const auto& last = slowFrame.scripts[kRealNames - 1];
+    EXPECT_EQ(last.count, 2u);
+    EXPECT_EQ(last.elapsedMicros, 15);
+
+    const auto& other = slowFrame.scripts.back();
+    EXPECT_EQ(other.name, FrameStallWatchdog::kOtherScripts);
+    EXPECT_EQ(other.count, 4u);
+    EXPECT_EQ(other.elapsedMicros, 31);
+}
+
+TEST(FrameStallWatchdogTest, ReservedSlotIsReusedCleanlyNextFrame) {
+    FrameStallWatchdog watchdog;
+    watchdog.setThreshold(100);
+
+    SlowFrame slowFrame;
+    watchdog.beginFrame(1, 0);
+    for (size_t i = 0; i < kRealNames + 1; ++i) {
+        watchdog.onScriptExecuted(scriptName(i), 10);
+    }
+    ASSERT_TRUE(watchdog.endFrame(500, slowFrame));
+
+    watchdog.beginFrame(2, 1000);
+    for (size_t i = 0; i < kRealNames + 1; ++i) {
+        watchdog.onScriptExecuted("next" + std::to_string(i), 1);
+    }
+    ASSERT_TRUE(watchdog.endFrame(1500, slowFrame));
+
+    ASSERT_EQ(slowFrame.scripts.size(), FrameStallWatchdog::kMaxScriptsPerFrame);
+    EXPECT_EQ(slowFrame.scripts[kRealNames - 1].name, "next" + std::to_string(kRealNames - 1));
+    EXPECT_EQ(slowFrame.scripts.back().name, FrameStallWatchdog::kOtherScripts);
+    EXPECT_EQ(slowFrame.scripts.back().count, 1u);
+    EXPECT_EQ(watchdog.getHistory().size(), 2u);
+}
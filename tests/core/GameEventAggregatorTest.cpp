@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <icecap/agent/core/GameEventAggregator.hpp>
+
+using icecap::agent::core::GameEvent;
+using icecap::agent::core::GameEventAggregate;
+using icecap::agent::core::GameEventAggregator;
+using icecap::agent::core::GameEventArgument;
+
+namespace {
+
+constexpr uint32_t kCombatEvent = 10;
+constexpr uint32_t kChatEvent = 20;
+
+GameEvent event(uint32_t eventId, int64_t key, double value) {
+    GameEvent result;
+    result.eventId = eventId;
+    GameEventArgument keyArgument;
+    keyArgument.integer = key;
+    GameEventArgument valueArgument;
+    valueArgument.kind = GameEventArgument::Kind::NUMBER;
+    valueArgument.number = value;
+    result.arguments = {keyArgument, valueArgument};
+    return result;
+}
+
+class GameEventAggregatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        GameEventAggregator::Policy policy;
+        policy.mode = GameEventAggregator::Mode::SUM;
+        policy.keyArgument = 1;
+        policy.valueArgument = 2;
+        policy.windowFrames = 10;
+        ASSERT_TRUE(aggregator.setPolicy(kCombatEvent, policy));
+    }
+
+    std::vector<GameEventAggregate> frame(uint64_t frameNumber, std::vector<GameEvent> events) {
+        std::vector<GameEventAggregate> output;
+        aggregator.process(frameNumber, frameNumber * 16, events, output);
+        return output;
+    }
+
+    GameEventAggregator aggregator;
+};
+
+} // namespace
+
+TEST_F(GameEventAggregatorTest, SumsPerKeyUntilTheWindowCloses) {
+    EXPECT_TRUE(frame(1, {event(kCombatEvent, 1, 5.0), event(kCombatEvent, 2, 1.0)}).empty());
+    EXPECT_EQ(frame(2, {event(kCombatEvent, 1, 7.0), event(kChatEvent, 0, 0.0)}).size(), 1u);
+
+    const auto output = frame(10, {});
+    ASSERT_EQ(output.size(), 2u);
+    EXPECT_EQ(output[0].count, 2u);
+    EXPECT_DOUBLE_EQ(output[0].sum, 12.0);
+    EXPECT_EQ(output[0].windowStartFrame, 1u);
+    EXPECT_EQ(output[1].count, 1u);
+    EXPECT_DOUBLE_EQ(output[1].sum, 1.0);
+}
+
+TEST_F(GameEventAggregatorTest, RemovingAPolicyDeliversItsOpenWindow) {
+    frame(1, {event(kCombatEvent, 1, 5.0), event(kCombatEvent, 1, 2.0)});
+
+    EXPECT_TRUE(aggregator.removePolicy(kCombatEvent));
+    EXPECT_FALSE(aggregator.removePolicy(kCombatEvent));
+    EXPECT_EQ(aggregator.getPolicyCount(), 0u);
+
+    // The cut-short window comes first, then the event that now passes straight through
+    const auto output = frame(2, {event(kCombatEvent, 1, 4.0)});
+    ASSERT_EQ(output.size(), 2u);
+    EXPECT_EQ(output[0].count, 2u);
+    EXPECT_DOUBLE_EQ(output[0].sum, 7.0);
+    EXPECT_EQ(output[0].windowStartFrame, 1u);
+    EXPECT_EQ(output[1].count, 1u);
+    EXPECT_EQ(output[1].windowStartFrame, 2u);
+
+    EXPECT_TRUE(frame(3, {}).empty());
+}
+
+TEST_F(GameEventAggregatorTest, DiscardPendingDropsWindowsOfRemovedPolicies) {
+    frame(1, {event(kCombatEvent, 1, 5.0)});
+    aggregator.removePolicy(kCombatEvent);
+    aggregator.discardPending();
+
+    EXPECT_TRUE(frame(2, {}).empty());
+}
+
+TEST_F(GameEventAggregatorTest, UnreadableArgumentsGetTheirOwnGroupAndAddNothing) {
+    auto unreadableKey = event(kCombatEvent, 0, 3.0);
+    unreadableKey.arguments[0].kind = GameEventArgument::Kind::UNREADABLE;
+    auto unreadableValue = event(kCombatEvent, 0, 9.0);
+    unreadableValue.arguments[1].kind = GameEventArgument::Kind::UNREADABLE;
+
+    frame(1, {unreadableKey, unreadableValue});
+
+    // Same key column value 0, but only the readable one groups under it
+    const auto output = frame(10, {});
+    ASSERT_EQ(output.size(), 2u);
+    EXPECT_EQ(output[0].count + output[1].count, 2u);
+    EXPECT_DOUBLE_EQ(output[0].sum + output[1].sum, 3.0);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <icecap/agent/core/GameStatePublisher.hpp>
+#include <icecap/agent/core/ObjectSnapshot.hpp>
+
+#include "support/FakeMemory.hpp"
+#include "support/FakeObjectManager.hpp"
+
+using icecap::agent::core::GameStatePublisher;
+using icecap::agent::core::ObjectDelta;
+using icecap::agent::core::ObjectSnapshotEngine;
+using icecap::agent::tests::FakeMemory;
+using icecap::agent::tests::FakeObjectManager;
+
+namespace {
+
+class GameStatePublisherTest : public ::testing::Test {
+protected:
+    void frame(uint64_t frameNumber) {
+        engine.update(frameNumber, memory, delta);
+        publisher.publish(frameNumber, engine);
+    }
+
+    FakeMemory memory;
+    FakeObjectManager objects{memory};
+    ObjectSnapshotEngine engine;
+    ObjectDelta delta;
+    GameStatePublisher publisher;
+};
+
+FakeObjectManager::Object unit(uint64_t guid, float x) {
+    FakeObjectManager::Object object;
+    object.guid = guid;
+    object.x = x;
+    return object;
+}
+
+} // namespace
+
+TEST_F(GameStatePublisherTest, NothingIsPublishedBeforeTheFirstFrame) {
+    EXPECT_EQ(publisher.acquire(), nullptr);
+}
+
+TEST_F(GameStatePublisherTest, PublishesObjectsWithoutADeltaSubscription) {
+    objects.setLocalPlayer(7);
+    objects.spawn(unit(7, 1.0f));
+
+    frame(1);
+
+    const auto state = publisher.acquire();
+    ASSERT_NE(state, nullptr);
+    ASSERT_NE(state->objects, nullptr);
+    EXPECT_EQ(state->frameNumber, 1u);
+    EXPECT_EQ(state->objects->size(), 1u);
+    EXPECT_EQ(state->objects->localPlayerGuid, 7u);
+}
+
+TEST_F(GameStatePublisherTest, UnchangedFramesConfirmInsteadOfRepublishing) {
+    const uint32_t address = objects.spawn(unit(1, 1.0f));
+    frame(1);
+    const auto first = publisher.acquire();
+
+    frame(2);
+    frame(3);
+    EXPECT_EQ(publisher.acquire(), first);
+    EXPECT_EQ(publisher.getFreshness().frameNumber, 3u);
+
+    objects.update(address, unit(1, 2.0f));
+    frame(4);
+    const auto second = publisher.acquire();
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second->frameNumber, 4u);
+    EXPECT_FLOAT_EQ(second->objects->x[0], 2.0f);
+
+    // Readers keep the state they acquired
+    EXPECT_FLOAT_EQ(first->objects->x[0], 1.0f);
+}
+
+TEST_F(GameStatePublisherTest, FramesWithoutACaptureAreNotConfirmed) {
+    objects.spawn(unit(1, 1.0f));
+    frame(1);
+
+    publisher.publish(2, engine);
+    EXPECT_EQ(publisher.getFreshness().frameNumber, 1u);
+}
+
+TEST_F(GameStatePublisherTest, DeltaIntervalDoesNotDelayTheState) {
+    const uint32_t address = objects.spawn(unit(1, 1.0f));
+    engine.enable(5, 0, 3.0f);
+    frame(1);
+
+    objects.update(address, unit(1, 2.0f));
+    frame(2);
+    EXPECT_EQ(publisher.getFreshness().frameNumber, 2u);
+    EXPECT_FLOAT_EQ(publisher.acquire()->objects->x[0], 2.0f);
+}
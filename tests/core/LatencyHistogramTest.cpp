@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <icecap/agent/core/CommandLatency.hpp>
+
+using icecap::agent::core::LatencyHistogram;
+
+TEST(LatencyHistogramTest, ValuesBelowEightAreExact) {
+    for (uint64_t value = 0; value < LatencyHistogram::kSubBuckets; ++value) {
+        EXPECT_EQ(LatencyHistogram::bucketOf(value), value);
+        EXPECT_EQ(LatencyHistogram::upperBoundOf(value), value);
+    }
+
+    LatencyHistogram histogram;
+    for (uint64_t value = 0; value < 8; ++value) {
+        histogram.record(value);
+    }
+    const auto summary = histogram.summarize();
+    EXPECT_EQ(summary.count, 8u);
+    EXPECT_EQ(summary.sumMicros, 28u);
+    EXPECT_EQ(summary.p50Micros, 3u);
+    EXPECT_EQ(summary.p99Micros, 7u);
+}
+
+TEST(LatencyHistogramTest, PowersOfTwoStartANewGroup) {
+    for (uint32_t power = 3; power < 32; ++power) {
+        const uint64_t edge = 1ull << power;
+        const size_t bucket = LatencyHistogram::bucketOf(edge);
+        EXPECT_EQ(bucket, (power - 2) * LatencyHistogram::kSubBuckets) << "2^" << power;
+        EXPECT_EQ(LatencyHistogram::bucketOf(edge - 1), bucket - 1) << "2^" << power;
+        EXPECT_EQ(LatencyHistogram::upperBoundOf(bucket - 1), edge - 1) << "2^" << power;
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValueWithinAnEighth) {
+    size_t previous = 0;
+    for (uint64_t value = 1; value < (1u << 20); ++value) {
+        const size_t bucket = LatencyHistogram::bucketOf(value);
+        ASSERT_GE(bucket, previous) << value;
+        ASSERT_LT(bucket, LatencyHistogram::kBucketCount) << value;
+
+        const uint64_t bound = LatencyHistogram::upperBoundOf(bucket);
+        ASSERT_GE(bound, value) << value;
+        ASSERT_LE(bound - value, value / LatencyHistogram::kSubBuckets) << value;
+        previous = bucket;
+    }
+}
+
+TEST(LatencyHistogramTest, LargeValuesAreClampedToTheLastBucket) {
+    EXPECT_EQ(LatencyHistogram::bucketOf(UINT32_MAX), LatencyHistogram::kBucketCount - 1);
+    EXPECT_EQ(LatencyHistogram::upperBoundOf(LatencyHistogram::kBucketCount - 1), UINT32_MAX);
+
+    LatencyHistogram histogram;
+    histogram.record(1ull << 40);
+    const auto summary = histogram.summarize();
+    EXPECT_EQ(summary.maxMicros, UINT32_MAX);
+    EXPECT_EQ(summary.sumMicros, UINT32_MAX);
+    EXPECT_EQ(summary.p99Micros, UINT32_MAX);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfAUniformDistribution) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value) {
+        histogram.record(value);
+    }
+
+    // Bucket bounds: 50 falls into [48, 51] and 90 into [88, 95]; 99 is capped by the maximum
+    const auto summary = histogram.summarize();
+    EXPECT_EQ(summary.p50Micros, 51u);
+    EXPECT_EQ(summary.p90Micros, 95u);
+    EXPECT_EQ(summary.p99Micros, 100u);
+    EXPECT_EQ(summary.maxMicros, 100u);
+}
+
+TEST(LatencyHistogramTest, P99RankRoundsUp) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 990; ++i) {
+        histogram.record(10);
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(5000);
+    }
+    EXPECT_EQ(histogram.summarize().p50Micros, 10u);
+    EXPECT_EQ(histogram.summarize().p99Micros, 10u);
+
+    // With 1001 samples the p99 rank rounds up to 991, which lands in the slow tail
+    histogram.record(5000);
+    EXPECT_EQ(histogram.summarize().p99Micros, 5000u);
+}
+
+TEST(LatencyHistogramTest, ResetClearsEverything) {
+    LatencyHistogram histogram;
+    histogram.record(1000);
+    histogram.record(3);
+    histogram.reset();
+
+    const auto empty = histogram.summarize();
+    EXPECT_EQ(empty.count, 0u);
+    EXPECT_EQ(empty.sumMicros, 0u);
+    EXPECT_EQ(empty.maxMicros, 0u);
+    EXPECT_EQ(empty.p50Micros, 0u);
+    EXPECT_EQ(empty.p99Micros, 0u);
+
+    histogram.record(5);
+    const auto after = histogram.summarize();
+    EXPECT_EQ(after.count, 1u);
+    EXPECT_EQ(after.p50Micros, 5u);
+    EXPECT_EQ(after.maxMicros, 5u);
+}
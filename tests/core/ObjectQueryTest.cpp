@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <icecap/agent/core/ObjectQuery.hpp>
+
+using icecap::agent::core::OBJECT_FIELD_HEALTH;
+using icecap::agent::core::OBJECT_FIELD_POSITION;
+using icecap::agent::core::ObjectQuery;
+using icecap::agent::core::ObjectTable;
+using icecap::agent::core::ObjectType;
+
+namespace {
+
+struct Row {
+    uint64_t guid;
+    ObjectType type;
+    float x;
+    uint32_t health;
+    uint32_t maxHealth;
+    uint64_t target;
+};
+
+ObjectTable makeTable(const std::vector<Row>& rows) {
+    ObjectTable table;
+    table.resize(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        table.guid[i] = rows[i].guid;
+        table.type[i] = rows[i].type;
+        table.x[i] = rows[i].x;
+        table.health[i] = rows[i].health;
+        table.maxHealth[i] = rows[i].maxHealth;
+        table.targetGuid[i] = rows[i].target;
+    }
+    return table;
+}
+
+// GUIDs of the rows matching `text`; fails the test if it does not compile
+std::vector<uint64_t> select(const ObjectTable& table, const std::string& text) {
+    std::string error;
+    const auto query = ObjectQuery::compile(text, error);
+    EXPECT_TRUE(query.has_value()) << text << ": " << error;
+    std::vector<uint64_t> guids;
+    if (query) {
+        std::vector<size_t> rows;
+        query->select(table, rows);
+        for (const size_t row : rows) {
+            guids.push_back(table.guid[row]);
+        }
+    }
+    return guids;
+}
+
+std::string compileError(const std::string& text) {
+    std::string error;
+    EXPECT_FALSE(ObjectQuery::compile(text, error).has_value()) << text;
+    return error;
+}
+
+const uint64_t kLargeGuid = 0xF130000000001234ull;
+
+const ObjectTable kTable = makeTable({
+    {1, ObjectType::UNIT, 0.5f, 30, 100, 0},
+    {2, ObjectType::UNIT, 2.0f, 90, 100, kLargeGuid},
+    {3, ObjectType::GAMEOBJECT, 1e-6f, 0, 0, 0},
+    {kLargeGuid, ObjectType::PLAYER, 3.0f, 1000, 1000, 1},
+});
+
+} // namespace
+
+TEST(ObjectQueryTest, FiltersAndProjects) {
+    std::string error;
+    const auto query = ObjectQuery::compile("type == UNIT && hp_pct < 35 -> guid, hp, pos", error);
+    ASSERT_TRUE(query.has_value()) << error;
+    EXPECT_EQ(query->getProjection(), OBJECT_FIELD_HEALTH | OBJECT_FIELD_POSITION);
+
+    std::vector<size_t> rows;
+    query->select(kTable, rows);
+    EXPECT_EQ(rows, std::vector<size_t>{0});
+}
+
+TEST(ObjectQueryTest, EmptyFilterMatchesEveryRow) {
+    EXPECT_EQ(select(kTable, "").size(), kTable.size());
+    EXPECT_EQ(select(kTable, "-> guid").size(), kTable.size());
+}
+
+TEST(ObjectQueryTest, ObjectsWithoutHealthMatchNoHealthPercentComparison) {
+    EXPECT_EQ(select(kTable, "hp_pct < 35"), std::vector<uint64_t>{1});
+    EXPECT_EQ(select(kTable, "hp_pct >= 0").size(), 3u);
+    EXPECT_EQ(select(kTable, "hp_pct != 30"), (std::vector<uint64_t>{2, kLargeGuid}));
+}
+
+TEST(ObjectQueryTest, GuidsCompareExactlyAtFullWidth) {
+    EXPECT_EQ(select(kTable, "guid == 0xF130000000001234"), std::vector<uint64_t>{kLargeGuid});
+    EXPECT_EQ(select(kTable, "guid == " + std::to_string(kLargeGuid)), std::vector<uint64_t>{kLargeGuid});
+    EXPECT_TRUE(select(kTable, "guid == " + std::to_string(kLargeGuid - 1)).empty());
+    EXPECT_EQ(select(kTable, "target == 0xF130000000001234"), std::vector<uint64_t>{2});
+    EXPECT_EQ(select(kTable, "guid > 2 && guid < 0xF130000000001234"), std::vector<uint64_t>{3});
+}
+
+TEST(ObjectQueryTest, RejectsGuidLiteralsThatAreNotWholeNonNegativeNumbers) {
+    EXPECT_NE(compileError("guid < 1.5").find("64-bit integer"), std::string::npos);
+    EXPECT_NE(compileError("guid == -1").find("'-1'"), std::string::npos);
+    EXPECT_FALSE(compileError("target == 1e3").empty());
+    EXPECT_FALSE(compileError("guid == 18446744073709551616").empty());
+}
+
+TEST(ObjectQueryTest, IntegerColumnsCompareExactlyAgainstFractionalAndOutOfRangeLiterals) {
+    EXPECT_EQ(select(kTable, "hp < 30.5"), (std::vector<uint64_t>{1, 3}));
+    EXPECT_EQ(select(kTable, "hp > 30.5"), (std::vector<uint64_t>{2, kLargeGuid}));
+    EXPECT_EQ(select(kTable, "hp <= 30"), (std::vector<uint64_t>{1, 3}));
+    EXPECT_EQ(select(kTable, "hp >= 90"), (std::vector<uint64_t>{2, kLargeGuid}));
+    EXPECT_TRUE(select(kTable, "hp == 30.5").empty());
+    EXPECT_EQ(select(kTable, "hp != 30.5").size(), kTable.size());
+    EXPECT_EQ(select(kTable, "hp > -3").size(), kTable.size());
+    EXPECT_TRUE(select(kTable, "hp < 0").empty());
+    EXPECT_EQ(select(kTable, "max_hp < 1e12").size(), kTable.size());
+    EXPECT_TRUE(select(kTable, "max_hp >= 1e12").empty());
+    EXPECT_EQ(select(kTable, "type == GAMEOBJECT || type > 4.5"), (std::vector<uint64_t>{3}));
+}
+
+TEST(ObjectQueryTest, AcceptsSignedExponents) {
+    EXPECT_EQ(select(kTable, "x < 1e-5"), std::vector<uint64_t>{3});
+    EXPECT_EQ(select(kTable, "x > 2.5E+0"), std::vector<uint64_t>{kLargeGuid});
+    EXPECT_EQ(select(kTable, "x > -1e-5 && x < 1"), (std::vector<uint64_t>{1, 3}));
+    EXPECT_NE(compileError("x < 1e-").find("Invalid number"), std::string::npos);
+}
+
+TEST(ObjectQueryTest, ReportsSyntaxErrors) {
+    EXPECT_NE(compileError("type == UNIT &&").find("column name"), std::string::npos);
+    EXPECT_NE(compileError("(hp < 3").find("')'"), std::string::npos);
+    EXPECT_NE(compileError("hp < 3 -> name").find("cannot be projected"), std::string::npos);
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <icecap/agent/core/ObjectSnapshot.hpp>
+
+#include "support/FakeMemory.hpp"
+#include "support/FakeObjectManager.hpp"
+
+using icecap::agent::core::ObjectDelta;
+using icecap::agent::core::ObjectSnapshotEngine;
+using icecap::agent::core::ObjectType;
+using icecap::agent::tests::FakeMemory;
+using icecap::agent::tests::FakeObjectManager;
+namespace core = icecap::agent::core;
+
+namespace {
+
+FakeObjectManager::Object unit(uint64_t guid, float x, float y, float z) {
+    FakeObjectManager::Object object;
+    object.guid = guid;
+    object.x = x;
+    object.y = y;
+    object.z = z;
+    object.health = 100;
+    object.maxHealth = 100;
+    object.level = 80;
+    return object;
+}
+
+class ObjectSnapshotTest : public ::testing::Test {
+protected:
+    FakeMemory memory;
+    FakeObjectManager objects{memory};
+    ObjectSnapshotEngine engine;
+    ObjectDelta delta;
+};
+
+} // namespace
+
+TEST_F(ObjectSnapshotTest, WalkReadsEveryObjectOfTheMaskSortedByGuid) {
+    objects.setLocalPlayer(20);
+
+    auto player = unit(20, 1.0f, 2.0f, 3.0f);
+    player.type = ObjectType::PLAYER;
+    player.facing = 1.5f;
+    player.targetGuid = 30;
+
+    auto chest = unit(5, 7.0f, 8.0f, 9.0f);
+    chest.type = ObjectType::GAMEOBJECT;
+
+    auto item = unit(1, 0.0f, 0.0f, 0.0f);
+    item.type = ObjectType::ITEM;
+
+    objects.spawn(unit(30, -4.0f, 5.5f, 6.25f));
+    const uint32_t playerAddress = objects.spawn(player);
+    objects.spawn(chest);
+    objects.spawn(item);
+
+    engine.capture(memory, delta);
+    const auto& table = engine.getTable();
+
+    ASSERT_EQ(table.size(), 3u);
+    EXPECT_EQ(table.guid, (std::vector<uint64_t>{5, 20, 30}));
+    EXPECT_EQ(table.localPlayerGuid, 20u);
+
+    const size_t row = *table.find(20);
+    EXPECT_EQ(table.type[row], ObjectType::PLAYER);
+    EXPECT_EQ(table.baseAddress[row], playerAddress);
+    EXPECT_FLOAT_EQ(table.x[row], 1.0f);
+    EXPECT_FLOAT_EQ(table.y[row], 2.0f);
+    EXPECT_FLOAT_EQ(table.z[row], 3.0f);
+    EXPECT_FLOAT_EQ(table.facing[row], 1.5f);
+    EXPECT_EQ(table.health[row], 100u);
+    EXPECT_EQ(table.maxHealth[row], 100u);
+    EXPECT_EQ(table.level[row], 80u);
+    EXPECT_EQ(table.targetGuid[row], 30u);
+
+    // Game objects have a position but no unit fields
+    const size_t chestRow = *table.find(5);
+    EXPECT_FLOAT_EQ(table.x[chestRow], 7.0f);
+    EXPECT_FLOAT_EQ(table.y[chestRow], 8.0f);
+    EXPECT_FLOAT_EQ(table.z[chestRow], 9.0f);
+    EXPECT_EQ(table.health[chestRow], 0u);
+
+    EXPECT_FALSE(table.find(1).has_value());
+    EXPECT_EQ(delta.spawned.size(), 3u);
+    EXPECT_TRUE(delta.despawned.empty());
+    EXPECT_TRUE(delta.updated.empty());
+}
+
+TEST_F(ObjectSnapshotTest, ExplicitTypeMaskSelectsReportedTypes) {
+    auto item = unit(1, 0.0f, 0.0f, 0.0f);
+    item.type = ObjectType::ITEM;
+    objects.spawn(item);
+    objects.spawn(unit(2, 0.0f, 0.0f, 0.0f));
+
+    engine.enable(1, 1u << static_cast<uint32_t>(ObjectType::ITEM), 0.0f);
+    engine.capture(memory, delta);
+
+    // The mask adds items to the table but only they are reported; the unit stays in the table
+    const auto& table = engine.getTable();
+    EXPECT_EQ(table.guid, (std::vector<uint64_t>{1, 2}));
+    ASSERT_EQ(delta.spawned.size(), 1u);
+    EXPECT_EQ(table.guid[delta.spawned[0]], 1u);
+}
+
+TEST_F(ObjectSnapshotTest, OutsideTheWorldTheSnapshotIsEmpty) {
+    objects.spawn(unit(1, 0.0f, 0.0f, 0.0f));
+    engine.capture(memory, delta);
+    ASSERT_EQ(engine.getTable().size(), 1u);
+
+    objects.leaveWorld();
+    engine.capture(memory, delta);
+
+    EXPECT_EQ(engine.getTable().size(), 0u);
+    EXPECT_EQ(delta.despawned, (std::vector<uint64_t>{1}));
+    EXPECT_EQ(ObjectSnapshotEngine::readLocalPlayerGuid(memory), 0u);
+}
+
+TEST_F(ObjectSnapshotTest, WalkStopsOnATaggedPointer) {
+    objects.spawn(unit(1, 0.0f, 0.0f, 0.0f));
+    objects.spawn(unit(2, 0.0f, 0.0f, 0.0f));
+    objects.setListTerminator(0x1c);
+
+    engine.capture(memory, delta);
+
+    EXPECT_EQ(engine.getTable().size(), 2u);
+}
+
+TEST_F(ObjectSnapshotTest, DeltaReportsSpawnsDespawnsAndChangedFields) {
+    const uint32_t first = objects.spawn(unit(10, 0.0f, 0.0f, 0.0f));
+    const uint32_t second = objects.spawn(unit(20, 0.0f, 0.0f, 0.0f));
+    objects.spawn(unit(30, 0.0f, 0.0f, 0.0f));
+    engine.capture(memory, delta);
+
+    objects.despawn(first);
+    objects.spawn(unit(15, 1.0f, 1.0f, 1.0f));
+    auto wounded = unit(20, 0.0f, 0.0f, 0.0f);
+    wounded.health = 40;
+    wounded.targetGuid = 30;
+    objects.update(second, wounded);
+
+    engine.capture(memory, delta);
+    const auto& table = engine.getTable();
+
+    EXPECT_EQ(delta.despawned, (std::vector<uint64_t>{10}));
+    ASSERT_EQ(delta.spawned.size(), 1u);
+    EXPECT_EQ(table.guid[delta.spawned[0]], 15u);
+    ASSERT_EQ(delta.updated.size(), 1u);
+    EXPECT_EQ(table.guid[delta.updated[0].row], 20u);
+    EXPECT_EQ(delta.updated[0].changedFields, core::OBJECT_FIELD_HEALTH | core::OBJECT_FIELD_TARGET);
+
+    // Nothing changed since
+    engine.capture(memory, delta);
+    EXPECT_TRUE(delta.empty());
+}
+
+TEST_F(ObjectSnapshotTest, PositionEpsilonSuppressesSmallMovesUntilTheyAddUp) {
+    engine.enable(1, 0, 0.5f);
+    const uint32_t address = objects.spawn(unit(1, 10.0f, 0.0f, 0.0f));
+    engine.capture(memory, delta);
+    ASSERT_EQ(delta.spawned.size(), 1u);
+
+    // Below the epsilon: no update, while the table still holds the exact position
+    objects.update(address, unit(1, 10.3f, 0.0f, 0.0f));
+    engine.capture(memory, delta);
+    EXPECT_TRUE(delta.empty());
+    EXPECT_FLOAT_EQ(engine.getTable().x[0], 10.3f);
+
+    // Another small step crosses the epsilon relative to the last reported position
+    objects.update(address, unit(1, 10.6f, 0.0f, 0.0f));
+    engine.capture(memory, delta);
+    ASSERT_EQ(delta.updated.size(), 1u);
+    EXPECT_EQ(delta.updated[0].changedFields, core::OBJECT_FIELD_POSITION);
+    EXPECT_FLOAT_EQ(engine.getTable().x[0], 10.6f);
+}
+
+TEST_F(ObjectSnapshotTest, UpdateHonoursTheIntervalAndEnableResetsTheBaseline) {
+    objects.spawn(unit(1, 0.0f, 0.0f, 0.0f));
+
+    EXPECT_FALSE(engine.update(1, memory, delta));
+
+    engine.enable(3, 0, 0.0f);
+    EXPECT_TRUE(engine.update(10, memory, delta));
+    EXPECT_EQ(delta.spawned.size(), 1u);
+    EXPECT_FALSE(engine.update(11, memory, delta));
+    EXPECT_FALSE(engine.update(12, memory, delta));
+    EXPECT_TRUE(engine.update(13, memory, delta));
+    EXPECT_TRUE(delta.empty());
+
+    engine.enable(3, 0, 0.0f);
+    EXPECT_TRUE(engine.update(14, memory, delta));
+    EXPECT_EQ(delta.spawned.size(), 1u);
+}
+
+TEST_F(ObjectSnapshotTest, FindObjectAddressWalksTheList) {
+    objects.spawn(unit(1, 0.0f, 0.0f, 0.0f));
+    const uint32_t address = objects.spawn(unit(2, 0.0f, 0.0f, 0.0f));
+    objects.setLocalPlayer(2);
+
+    EXPECT_EQ(ObjectSnapshotEngine::findObjectAddress(memory, 2), address);
+    EXPECT_EQ(ObjectSnapshotEngine::findObjectAddress(memory, 3), 0u);
+    EXPECT_EQ(ObjectSnapshotEngine::readLocalPlayerGuid(memory), 2u);
+}
+
+TEST_F(ObjectSnapshotTest, TableStaysCurrentWithoutDeltaStreaming) {
+    objects.spawn(unit(1, 0.0f, 0.0f, 0.0f));
+
+    EXPECT_FALSE(engine.update(1, memory, delta));
+    EXPECT_EQ(engine.getTable().size(), 1u);
+    EXPECT_EQ(engine.getCaptureFrame(), 1u);
+
+    objects.spawn(unit(2, 0.0f, 0.0f, 0.0f));
+    EXPECT_FALSE(engine.update(2, memory, delta));
+    EXPECT_EQ(engine.getTable().size(), 2u);
+}
+
+TEST_F(ObjectSnapshotTest, VersionOnlyChangesWithTheTable) {
+    const uint32_t address = objects.spawn(unit(1, 0.0f, 0.0f, 0.0f));
+    engine.capture(memory, delta);
+    const uint64_t first = engine.getVersion();
+
+    engine.capture(memory, delta);
+    EXPECT_EQ(engine.getVersion(), first);
+
+    objects.update(address, unit(1, 5.0f, 0.0f, 0.0f));
+    engine.capture(memory, delta);
+    EXPECT_EQ(engine.getVersion(), first + 1);
+
+    objects.setLocalPlayer(1);
+    engine.capture(memory, delta);
+    EXPECT_EQ(engine.getVersion(), first + 2);
+}
+
+TEST_F(ObjectSnapshotTest, CoarseSubscriptionKeepsTheTableExact) {
+    const uint32_t address = objects.spawn(unit(1, 10.0f, 0.0f, 0.0f));
+    auto chest = unit(2, 7.0f, 8.0f, 9.0f);
+    chest.type = ObjectType::GAMEOBJECT;
+    objects.spawn(chest);
+
+    // Units only, 5 yards, every 30 frames
+    engine.enable(30, 1u << static_cast<uint32_t>(ObjectType::UNIT), 5.0f);
+    ASSERT_TRUE(engine.update(1, memory, delta));
+    EXPECT_EQ(delta.spawned.size(), 1u);
+
+    for (uint64_t frame = 2; frame < 31; ++frame) {
+        objects.update(address, unit(1, 10.0f + 0.1f * static_cast<float>(frame), 0.0f, 0.0f));
+        EXPECT_FALSE(engine.update(frame, memory, delta));
+
+        const auto& table = engine.getTable();
+        ASSERT_EQ(table.guid, (std::vector<uint64_t>{1, 2}));
+        EXPECT_FLOAT_EQ(table.x[0], 10.0f + 0.1f * static_cast<float>(frame));
+        EXPECT_EQ(engine.getCaptureFrame(), frame);
+    }
+
+    // Moved 3 yards since the last report: due, but below the epsilon
+    ASSERT_TRUE(engine.update(31, memory, delta));
+    EXPECT_TRUE(delta.empty());
+    EXPECT_FLOAT_EQ(engine.getTable().x[0], 13.0f);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <icecap/agent/core/PageCachedMemoryReader.hpp>
+
+#include "support/FakeRegionSource.hpp"
+
+using icecap::agent::core::PageCachedMemoryReader;
+using icecap::agent::tests::FakeRegionSource;
+
+namespace {
+
+constexpr uintptr_t kRegion = 0x10000;
+constexpr size_t kRegionSize = 0x1000;
+constexpr size_t kChunk = PageCachedMemoryReader::kStringChunk;
+
+class PageCachedMemoryReaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        source.map(kRegion, kRegionSize);
+    }
+
+    void writeString(uintptr_t address, const std::string& text) {
+        source.write(address, text.c_str(), text.size() + 1);
+    }
+
+    FakeRegionSource source;
+    PageCachedMemoryReader reader{source};
+};
+
+} // namespace
+
+TEST_F(PageCachedMemoryReaderTest, ReadsInACachedRangeQueryTheSourceOnce) {
+    for (uint32_t i = 0; i < 64; ++i) {
+        const uint32_t value = i * 3;
+        source.write(kRegion + i * 4, &value, sizeof(value));
+    }
+
+    for (uint32_t i = 0; i < 64; ++i) {
+        uint32_t value = 0;
+        ASSERT_TRUE(reader.readValue(kRegion + i * 4, value));
+        EXPECT_EQ(value, i * 3);
+    }
+
+    EXPECT_EQ(source.getQueryCount(), 1u);
+    EXPECT_EQ(reader.getStats().misses, 1u);
+    EXPECT_EQ(reader.getStats().hits, 63u);
+}
+
+TEST_F(PageCachedMemoryReaderTest, ReadsMayCrossIntoAnAdjacentRange) {
+    source.map(kRegion + kRegionSize, kRegionSize);
+    const uint64_t value = 0x1122334455667788ull;
+    source.write(kRegion + kRegionSize - 4, &value, sizeof(value));
+
+    uint64_t read = 0;
+    ASSERT_TRUE(reader.readValue(kRegion + kRegionSize - 4, read));
+    EXPECT_EQ(read, value);
+    EXPECT_EQ(source.getQueryCount(), 2u);
+}
+
+TEST_F(PageCachedMemoryReaderTest, ReadsTouchingUnreadableMemoryFailWithoutCopying) {
+    uint64_t value = 0;
+    EXPECT_FALSE(reader.readValue(kRegion + kRegionSize - 4, value));
+    EXPECT_FALSE(reader.readValue(kRegion - 4, value));
+    EXPECT_FALSE(reader.readValue(uintptr_t{0}, value));
+    EXPECT_EQ(source.getCopyCount(), 0u);
+}
+
+TEST_F(PageCachedMemoryReaderTest, FailedCopyInvalidatesEveryCachedRange) {
+    constexpr uintptr_t kOther = 0x40000;
+    source.map(kOther, kRegionSize);
+    uint32_t value = 0;
+    ASSERT_TRUE(reader.readValue(kRegion, value));
+    ASSERT_TRUE(reader.readValue(kOther, value));
+    ASSERT_EQ(source.getQueryCount(), 2u);
+
+    // Freed after it was cached: the copy fails and nothing cached is trusted any more
+    source.unmap(kRegion);
+    EXPECT_FALSE(reader.readValue(kRegion, value));
+    EXPECT_EQ(reader.getStats().invalidations, 1u);
+
+    ASSERT_TRUE(reader.readValue(kOther, value));
+    EXPECT_EQ(source.getQueryCount(), 3u);
+    EXPECT_FALSE(reader.readValue(kRegion, value));
+    EXPECT_EQ(source.getQueryCount(), 4u);
+}
+
+TEST_F(PageCachedMemoryReaderTest, InvalidateForcesANewQuery) {
+    uint32_t value = 0;
+    ASSERT_TRUE(reader.readValue(kRegion, value));
+    reader.invalidate();
+    ASSERT_TRUE(reader.readValue(kRegion, value));
+    EXPECT_EQ(source.getQueryCount(), 2u);
+}
+
+TEST_F(PageCachedMemoryReaderTest, RangesBeyondTheCacheSizeAreReplaced) {
+    constexpr size_t kRegions = PageCachedMemoryReader::kCachedRanges + 8;
+    for (size_t i = 1; i < kRegions; ++i) {
+        source.map(kRegion + i * 0x10000, 0x100);
+    }
+
+    uint32_t value = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < kRegions; ++i) {
+            EXPECT_TRUE(reader.readValue(kRegion + i * 0x10000, value));
+        }
+    }
+    EXPECT_FALSE(reader.readValue(kRegion + kRegions * 0x10000, value));
+}
+
+TEST_F(PageCachedMemoryReaderTest, FindsTheTerminatorAroundChunkBoundaries) {
+    for (const size_t length : {kChunk - 1, kChunk, kChunk + 1, kChunk + 15, 2 * kChunk + 7}) {
+        const std::string text(length, 'a');
+        writeString(kRegion, text);
+
+        std::string read;
+        ASSERT_TRUE(reader.readString(kRegion, read, kRegionSize));
+        EXPECT_EQ(read, text) << "length " << length;
+    }
+}
+
+TEST_F(PageCachedMemoryReaderTest, StringsContinueIntoAnAdjacentRange) {
+    source.map(kRegion + kRegionSize, kRegionSize);
+    const std::string text = std::string(20, 'x') + std::string(20, 'y');
+    writeString(kRegion + kRegionSize - 20, text);
+
+    std::string read;
+    ASSERT_TRUE(reader.readString(kRegion + kRegionSize - 20, read, 1024));
+    EXPECT_EQ(read, text);
+}
+
+TEST_F(PageCachedMemoryReaderTest, StringsStopAtUnreadableMemoryAndAtTheLengthLimit) {
+    const std::string tail(16, 'z');
+    source.write(kRegion + kRegionSize - tail.size(), tail.data(), tail.size());
+
+    std::string read;
+    EXPECT_TRUE(reader.readString(kRegion + kRegionSize - tail.size(), read, 1024));
+    EXPECT_EQ(read, tail);
+
+    writeString(kRegion, std::string(300, 'q'));
+    EXPECT_TRUE(reader.readString(kRegion, read, 10));
+    EXPECT_EQ(read, std::string(10, 'q'));
+
+    EXPECT_FALSE(reader.readString(kRegion - 0x100, read, 1024));
+    EXPECT_TRUE(read.empty());
+}
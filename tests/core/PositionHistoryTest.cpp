@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <icecap/agent/core/PositionHistory.hpp>
+
+#include "support/FakeMemory.hpp"
+#include "support/FakeObjectManager.hpp"
+
+using icecap::agent::core::PositionHistory;
+using icecap::agent::core::PositionSample;
+using icecap::agent::tests::FakeMemory;
+using icecap::agent::tests::FakeObjectManager;
+
+namespace {
+
+FakeObjectManager::Object unit(uint64_t guid, float x) {
+    FakeObjectManager::Object object;
+    object.guid = guid;
+    object.x = x;
+    return object;
+}
+
+class PositionHistoryTest : public ::testing::Test {
+protected:
+    // Frame n is recorded at n milliseconds
+    void recordFrames(uint64_t first, uint64_t last) {
+        for (uint64_t frame = first; frame <= last; ++frame) {
+            history.record(frame, static_cast<int64_t>(frame) * 1000, memory);
+        }
+    }
+
+    std::vector<uint64_t> frames(uint64_t guid, uint64_t windowFrames, uint64_t windowMicros) {
+        std::vector<PositionSample> samples;
+        EXPECT_TRUE(history.query(guid, windowFrames, windowMicros, samples));
+        std::vector<uint64_t> result;
+        for (const auto& sample : samples) {
+            result.push_back(sample.frameNumber);
+        }
+        return result;
+    }
+
+    FakeMemory memory;
+    FakeObjectManager objects{memory};
+    PositionHistory history;
+};
+
+} // namespace
+
+TEST_F(PositionHistoryTest, RecordsTheLocalPlayerWithoutBeingAsked) {
+    const uint32_t address = objects.spawn(unit(7, 1.0f));
+    objects.setLocalPlayer(7);
+
+    EXPECT_EQ(history.getTrackCount(), 1u);
+    recordFrames(1, 2);
+    objects.update(address, unit(7, 2.0f));
+    recordFrames(3, 3);
+
+    std::vector<PositionSample> samples;
+    ASSERT_TRUE(history.query(PositionHistory::kLocalPlayer, 0, 0, samples));
+    ASSERT_EQ(samples.size(), 3u);
+    EXPECT_FLOAT_EQ(samples[0].x, 1.0f);
+    EXPECT_FLOAT_EQ(samples[2].x, 2.0f);
+    EXPECT_EQ(samples[2].timestampMicros, 3000);
+}
+
+TEST_F(PositionHistoryTest, WindowsSelectByFramesOrByTime) {
+    objects.spawn(unit(7, 1.0f));
+    objects.setLocalPlayer(7);
+    recordFrames(1, 10);
+
+    EXPECT_EQ(frames(PositionHistory::kLocalPlayer, 3, 0), (std::vector<uint64_t>{8, 9, 10}));
+    EXPECT_EQ(frames(PositionHistory::kLocalPlayer, 0, 2000), (std::vector<uint64_t>{8, 9, 10}));
+    EXPECT_EQ(frames(PositionHistory::kLocalPlayer, 2, 5000), (std::vector<uint64_t>{9, 10}));
+    EXPECT_EQ(frames(PositionHistory::kLocalPlayer, 0, 0).size(), 10u);
+}
+
+TEST_F(PositionHistoryTest, TrackedUnitsAreOptional) {
+    objects.spawn(unit(7, 1.0f));
+    objects.spawn(unit(9, 5.0f));
+    objects.setLocalPlayer(7);
+
+    std::vector<PositionSample> samples;
+    EXPECT_FALSE(history.query(9, 0, 0, samples));
+
+    ASSERT_TRUE(history.track(9, 0));
+    recordFrames(1, 1);
+    ASSERT_TRUE(history.query(9, 0, 0, samples));
+    ASSERT_EQ(samples.size(), 1u);
+    EXPECT_FLOAT_EQ(samples[0].x, 5.0f);
+
+    // The local player can be dropped like any other track
+    EXPECT_TRUE(history.untrack(PositionHistory::kLocalPlayer));
+    EXPECT_EQ(history.getTrackCount(), 1u);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include <icecap/agent/core/TaskScheduler.hpp>
+
+using icecap::agent::core::Task;
+using icecap::agent::core::TaskScheduler;
+using icecap::agent::core::WaitFrames;
+
+namespace {
+
+Task waitThenThrow(uint32_t frames) {
+    co_await WaitFrames{frames};
+    throw std::runtime_error("step exploded");
+}
+
+Task waitThenFinish(uint32_t frames, bool& finished) {
+    co_await WaitFrames{frames};
+    finished = true;
+}
+
+} // namespace
+
+TEST(TaskSchedulerTest, ReportsTaskThatThrows) {
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.spawn("op-1", waitThenThrow(2)));
+
+    std::vector<TaskScheduler::Failure> failures;
+    scheduler.tick(1, failures);
+    scheduler.tick(2, failures);
+    EXPECT_TRUE(failures.empty());
+
+    scheduler.tick(3, failures);
+    ASSERT_EQ(failures.size(), 1u);
+    EXPECT_EQ(failures[0].id, "op-1");
+    EXPECT_EQ(failures[0].error, "step exploded");
+    EXPECT_EQ(scheduler.getTaskCount(), 0u);
+}
+
+TEST(TaskSchedulerTest, FinishedAndCancelledTasksAreNotFailures) {
+    TaskScheduler scheduler;
+    bool finished = false;
+    ASSERT_TRUE(scheduler.spawn("done", waitThenFinish(1, finished)));
+    ASSERT_TRUE(scheduler.spawn("cancelled", waitThenThrow(1)));
+
+    std::vector<TaskScheduler::Failure> failures;
+    scheduler.tick(1, failures);
+    ASSERT_TRUE(scheduler.cancel("cancelled"));
+    scheduler.tick(2, failures);
+
+    EXPECT_TRUE(finished);
+    EXPECT_TRUE(failures.empty());
+    EXPECT_EQ(scheduler.getTaskCount(), 0u);
+}
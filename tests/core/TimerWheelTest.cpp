@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <icecap/agent/core/TimerWheel.hpp>
+
+using icecap::agent::core::TimerWheel;
+
+namespace {
+
+// Same bound as RecurringTaskManager::kMaxCatchUpTicks
+constexpr uint64_t kMaxCatchUpTicks = 1024;
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+    // Advance to `tick`, recording the tick each timer expired on
+    void advanceTo(uint64_t tick) {
+        while (wheel.getCurrentTick() < tick) {
+            advanceOnce();
+        }
+    }
+
+    // Advance at most `ticks` ticks, as one capped catch-up; returns the timers that expired
+    std::vector<TimerWheel::TimerId> catchUp(uint64_t ticks) {
+        std::vector<TimerWheel::TimerId> expired;
+        for (uint64_t i = 0; i < std::min(ticks, kMaxCatchUpTicks); ++i) {
+            wheel.advance(expired);
+        }
+        for (const auto timer : expired) {
+            fired[timer].push_back(wheel.getCurrentTick());
+        }
+        return expired;
+    }
+
+    void advanceOnce() {
+        std::vector<TimerWheel::TimerId> expired;
+        wheel.advance(expired);
+        for (const auto timer : expired) {
+            fired[timer].push_back(wheel.getCurrentTick());
+        }
+    }
+
+    TimerWheel wheel;
+    std::map<TimerWheel::TimerId, std::vector<uint64_t>> fired;
+};
+
+} // namespace
+
+TEST_F(TimerWheelTest, FiresOnItsTickAcrossLevelBoundaries) {
+    const std::vector<uint64_t> delays = {1, 63, 64, 65, 127, 4095, 4096, 4097, 262143, 262144, 262145, 300000};
+
+    // Unaligned starts put timers in higher-level slots that cascade before their level wraps
+    for (const uint64_t start : {0ull, 37ull, 4095ull, 262100ull}) {
+        wheel.clear();
+        fired.clear();
+        advanceTo(start);
+
+        std::map<TimerWheel::TimerId, uint64_t> expected;
+        for (const uint64_t delay : delays) {
+            const auto timer = wheel.create();
+            wheel.schedule(timer, delay);
+            expected[timer] = start + delay;
+        }
+
+        advanceTo(start + delays.back() + 1);
+        for (const auto& [timer, tick] : expected) {
+            ASSERT_EQ(fired[timer], std::vector<uint64_t>{tick}) << "start " << start << ", timer " << timer;
+        }
+    }
+}
+
+TEST_F(TimerWheelTest, DelaysAreClampedToTheWheel) {
+    const auto immediate = wheel.create();
+    const auto tooLong = wheel.create();
+    wheel.schedule(immediate, 0);
+    wheel.schedule(tooLong, TimerWheel::kMaxDelay + 1000);
+
+    advanceOnce();
+    EXPECT_EQ(fired[immediate], std::vector<uint64_t>{1});
+    EXPECT_TRUE(fired[tooLong].empty());
+}
+
+TEST_F(TimerWheelTest, RescheduleReplacesAndCancelDisarms) {
+    const auto moved = wheel.create();
+    const auto cancelled = wheel.create();
+    wheel.schedule(moved, 10);
+    wheel.schedule(cancelled, 10);
+
+    // Re-arm the same id further out and into another level
+    advanceTo(5);
+    wheel.schedule(moved, 100);
+    wheel.cancel(cancelled);
+    advanceTo(200);
+
+    EXPECT_EQ(fired[moved], std::vector<uint64_t>{105});
+    EXPECT_TRUE(fired[cancelled].empty());
+
+    // A cancelled timer can be armed again, and a destroyed id reused without firing its old schedule
+    wheel.schedule(cancelled, 3);
+    wheel.schedule(moved, 5);
+    wheel.destroy(moved);
+    const auto reused = wheel.create();
+    EXPECT_EQ(reused, moved);
+    advanceTo(300);
+
+    EXPECT_EQ(fired[cancelled], std::vector<uint64_t>{203});
+    EXPECT_EQ(fired[reused], std::vector<uint64_t>{105}); // Only the firing from before it was destroyed
+}
+
+TEST_F(TimerWheelTest, LongIdleGapFiresOnceOnItsTick) {
+    const auto pending = wheel.create();
+    wheel.schedule(pending, 70000);
+
+    // An idle wheel ticking past every level's wrap several times
+    advanceTo(1000000);
+    EXPECT_EQ(fired[pending], std::vector<uint64_t>{70000});
+
+    // A timer armed after the gap waits its full delay
+    const auto late = wheel.create();
+    wheel.schedule(late, 5000);
+    advanceTo(1010000);
+    EXPECT_EQ(fired[late], std::vector<uint64_t>{1005000});
+    EXPECT_EQ(fired[pending].size(), 1u);
+}
+
+TEST_F(TimerWheelTest, CappedCatchUpDelaysTimersWithoutLosingThem) {
+    const auto early = wheel.create();
+    const auto middle = wheel.create();
+    const auto late = wheel.create();
+    wheel.schedule(early, 10);
+    wheel.schedule(middle, 1000);
+    wheel.schedule(late, 3000);
+
+    // One stall of 5000 ticks, caught up kMaxCatchUpTicks at a time
+    EXPECT_EQ(catchUp(5000), (std::vector<TimerWheel::TimerId>{early, middle}));
+    EXPECT_EQ(wheel.getCurrentTick(), kMaxCatchUpTicks);
+    EXPECT_TRUE(catchUp(5000 - kMaxCatchUpTicks).empty());
+    EXPECT_EQ(catchUp(5000 - 2 * kMaxCatchUpTicks), std::vector<TimerWheel::TimerId>{late});
+    EXPECT_EQ(fired[late], std::vector<uint64_t>{3 * kMaxCatchUpTicks});
+}
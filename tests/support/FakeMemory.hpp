@@ -0,0 +1,82 @@
+#ifndef ICECAP_AGENT_TESTS_FAKE_MEMORY_HPP
+#define ICECAP_AGENT_TESTS_FAKE_MEMORY_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <icecap/agent/interfaces/IMemoryReader.hpp>
+
+namespace icecap::agent::tests {
+
+/**
+ * Sparse synthetic address space standing in for the game process. Only
+ * mapped regions are readable; a read that touches an unmapped byte fails
+ * the way an access violation would be reported by the real reader.
+ */
+class FakeMemory : public interfaces::IMemoryReader {
+public:
+    // Map `size` zeroed bytes at `address`; regions must not overlap
+    void map(uintptr_t address, size_t size) {
+        m_regions[address].assign(size, 0);
+    }
+
+    void unmap(uintptr_t address) {
+        m_regions.erase(address);
+    }
+
+    void write(uintptr_t address, const void* data, size_t size) {
+        uint8_t* target = locate(m_regions, address, size);
+        if (target == nullptr) {
+            throw std::out_of_range("FakeMemory: write outside the mapped regions");
+        }
+        std::memcpy(target, data, size);
+    }
+
+    template <typename T>
+    void writeValue(uintptr_t address, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "writeValue requires a trivially copyable type");
+        write(address, &value, sizeof(T));
+    }
+
+    bool read(uintptr_t address, void* out, size_t size) const override {
+        ++m_readCount;
+        const uint8_t* source = locate(m_regions, address, size);
+        if (source == nullptr) {
+            return false;
+        }
+        std::memcpy(out, source, size);
+        return true;
+    }
+
+    size_t getReadCount() const {
+        return m_readCount;
+    }
+
+private:
+    // Bytes backing [address, address + size), or null unless one region covers all of them
+    template <typename Regions>
+    static auto locate(Regions& regions, uintptr_t address, size_t size) -> decltype(regions.begin()->second.data()) {
+        auto it = regions.upper_bound(address);
+        if (it == regions.begin()) {
+            return nullptr;
+        }
+        --it;
+        auto& bytes = it->second;
+        const uintptr_t offset = address - it->first;
+        if (offset > bytes.size() || size > bytes.size() - offset) {
+            return nullptr;
+        }
+        return bytes.data() + offset;
+    }
+
+    std::map<uintptr_t, std::vector<uint8_t>> m_regions;
+    mutable size_t m_readCount{0};
+};
+
+} // namespace icecap::agent::tests
+
+#endif // ICECAP_AGENT_TESTS_FAKE_MEMORY_HPP
@@ -0,0 +1,122 @@
+#ifndef ICECAP_AGENT_TESTS_FAKE_OBJECT_MANAGER_HPP
+#define ICECAP_AGENT_TESTS_FAKE_OBJECT_MANAGER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <icecap/agent/core/ObjectSnapshot.hpp>
+
+#include "FakeMemory.hpp"
+
+namespace icecap::agent::tests {
+
+/**
+ * Builds the build 12340 object manager layout inside a FakeMemory image:
+ * client connection, object manager and a linked list of objects with their
+ * movement block and unit descriptors. Objects keep a fixed address for
+ * their lifetime, like in the client.
+ */
+class FakeObjectManager {
+public:
+    using Offsets = core::ObjectSnapshotEngine::Offsets;
+
+    static constexpr uintptr_t kConnection = 0x01000000;
+    static constexpr uintptr_t kManager = 0x02000000;
+    static constexpr uintptr_t kFirstObjectAddress = 0x10000000;
+    static constexpr uintptr_t kObjectStride = 0x1000;
+    static constexpr uintptr_t kDescriptorOffset = 0x800; // Descriptors live in the object's own block
+
+    struct Object {
+        uint64_t guid{0};
+        core::ObjectType type{core::ObjectType::UNIT};
+        float x{0.0f};
+        float y{0.0f};
+        float z{0.0f};
+        float facing{0.0f};
+        uint32_t health{0};
+        uint32_t maxHealth{0};
+        uint32_t level{0};
+        uint64_t targetGuid{0};
+    };
+
+    explicit FakeObjectManager(FakeMemory& memory) : m_memory(memory) {
+        m_memory.map(Offsets::kClientConnection, sizeof(uint32_t));
+        m_memory.map(kConnection, Offsets::kObjectManager + sizeof(uint32_t));
+        m_memory.map(kManager, Offsets::kLocalGuid + sizeof(uint64_t));
+        m_memory.writeValue(Offsets::kClientConnection, static_cast<uint32_t>(kConnection));
+        m_memory.writeValue(kConnection + Offsets::kObjectManager, static_cast<uint32_t>(kManager));
+    }
+
+    // Simulate the login screen: the client connection pointer is cleared
+    void leaveWorld() {
+        m_memory.writeValue(Offsets::kClientConnection, uint32_t{0});
+    }
+
+    void setLocalPlayer(uint64_t guid) {
+        m_memory.writeValue(kManager + Offsets::kLocalGuid, guid);
+    }
+
+    // Add an object at the end of the list and return its base address
+    uint32_t spawn(const Object& object) {
+        const auto address = static_cast<uint32_t>(kFirstObjectAddress + m_nextSlot++ * kObjectStride);
+        m_memory.map(address, kObjectStride);
+        m_memory.writeValue(address + Offsets::kObjectType, static_cast<uint32_t>(object.type));
+        m_memory.writeValue(address + Offsets::kObjectGuid, object.guid);
+        m_memory.writeValue(address + Offsets::kObjectDescriptors, static_cast<uint32_t>(address + kDescriptorOffset));
+        m_objects.push_back(address);
+        update(address, object);
+        relink();
+        return address;
+    }
+
+    // Rewrite the position and unit fields of a live object
+    void update(uint32_t address, const Object& object) {
+        // The client stores (Y, X, Z) relative to the contract
+        const float position[3] = {object.y, object.x, object.z};
+        if (object.type == core::ObjectType::GAMEOBJECT) {
+            m_memory.write(address + Offsets::kGameObjectPosition, position, sizeof(position));
+        } else {
+            m_memory.write(address + Offsets::kUnitPosition, position, sizeof(position));
+            m_memory.writeValue(address + Offsets::kUnitFacing, object.facing);
+        }
+
+        const uint32_t descriptors = address + kDescriptorOffset;
+        m_memory.writeValue(descriptors + Offsets::kUnitTarget, object.targetGuid);
+        m_memory.writeValue(descriptors + Offsets::kUnitHealth, object.health);
+        m_memory.writeValue(descriptors + Offsets::kUnitMaxHealth, object.maxHealth);
+        m_memory.writeValue(descriptors + Offsets::kUnitLevel, object.level);
+    }
+
+    // Remove an object from the list and unmap it
+    void despawn(uint32_t address) {
+        m_objects.erase(std::ranges::find(m_objects, address));
+        m_memory.unmap(address);
+        relink();
+    }
+
+    // End the list on `tail` instead of a null pointer
+    void setListTerminator(uint32_t tail) {
+        m_terminator = tail;
+        relink();
+    }
+
+private:
+    void relink() {
+        const uint32_t first = m_objects.empty() ? m_terminator : m_objects.front();
+        m_memory.writeValue(kManager + Offsets::kFirstObject, first);
+        for (size_t i = 0; i < m_objects.size(); ++i) {
+            const uint32_t next = i + 1 < m_objects.size() ? m_objects[i + 1] : m_terminator;
+            m_memory.writeValue(m_objects[i] + Offsets::kNextObject, next);
+        }
+    }
+
+    FakeMemory& m_memory;
+    std::vector<uint32_t> m_objects;
+    size_t m_nextSlot{0};
+    uint32_t m_terminator{0};
+};
+
+} // namespace icecap::agent::tests
+
+#endif // ICECAP_AGENT_TESTS_FAKE_OBJECT_MANAGER_HPP
@@ -0,0 +1,105 @@
+#ifndef ICECAP_AGENT_TESTS_FAKE_REGION_SOURCE_HPP
+#define ICECAP_AGENT_TESTS_FAKE_REGION_SOURCE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <icecap/agent/interfaces/IMemoryRegionSource.hpp>
+
+namespace icecap::agent::tests {
+
+/**
+ * Synthetic address space behind core::PageCachedMemoryReader. Regions play
+ * the part of VirtualQuery results; adjacent regions are contiguous memory,
+ * so a copy may cross from one into the next. Unmapping a region after the
+ * reader has cached it makes the next copy fail, like memory freed under a
+ * validated range.
+ */
+class FakeRegionSource : public interfaces::IMemoryRegionSource {
+public:
+    // Map `size` zeroed bytes at `address`; regions must not overlap
+    void map(uintptr_t address, size_t size) {
+        m_regions[address].assign(size, 0);
+    }
+
+    void unmap(uintptr_t address) {
+        m_regions.erase(address);
+    }
+
+    void write(uintptr_t address, const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        if (!transfer(m_regions, address, size, [&](uint8_t* region, size_t done, size_t length) {
+                std::memcpy(region, bytes + done, length);
+            })) {
+            throw std::out_of_range("FakeRegionSource: write outside the mapped regions");
+        }
+    }
+
+    bool queryReadableRegion(uintptr_t address, uintptr_t& begin, uintptr_t& end) const override {
+        ++m_queryCount;
+        const auto it = find(m_regions, address);
+        if (it == m_regions.end()) {
+            return false;
+        }
+        begin = it->first;
+        end = it->first + it->second.size();
+        return true;
+    }
+
+    bool copy(uintptr_t address, void* out, size_t size) const override {
+        ++m_copyCount;
+        auto* bytes = static_cast<uint8_t*>(out);
+        return transfer(m_regions, address, size, [&](const uint8_t* region, size_t done, size_t length) {
+            std::memcpy(bytes + done, region, length);
+        });
+    }
+
+    size_t getQueryCount() const {
+        return m_queryCount;
+    }
+
+    size_t getCopyCount() const {
+        return m_copyCount;
+    }
+
+private:
+    // Region containing `address`, or regions.end()
+    template <typename Regions>
+    static auto find(Regions& regions, uintptr_t address) -> decltype(regions.begin()) {
+        auto it = regions.upper_bound(address);
+        if (it == regions.begin()) {
+            return regions.end();
+        }
+        --it;
+        return address - it->first < it->second.size() ? it : regions.end();
+    }
+
+    // Visit [address, address + size) region by region; false if any byte is unmapped
+    template <typename Regions, typename Visit>
+    static bool transfer(Regions& regions, uintptr_t address, size_t size, Visit&& visit) {
+        for (size_t done = 0; done < size;) {
+            const auto it = find(regions, address + done);
+            if (it == regions.end()) {
+                return false;
+            }
+            auto& bytes = it->second;
+            const size_t offset = address + done - it->first;
+            const size_t length = std::min(size - done, bytes.size() - offset);
+            visit(bytes.data() + offset, done, length);
+            done += length;
+        }
+        return true;
+    }
+
+    std::map<uintptr_t, std::vector<uint8_t>> m_regions;
+    mutable size_t m_queryCount{0};
+    mutable size_t m_copyCount{0};
+};
+
+} // namespace icecap::agent::tests
+
+#endif // ICECAP_AGENT_TESTS_FAKE_REGION_SOURCE_HPP
@@ -0,0 +1,21 @@
+// Logger for the portable build: src/logging.cpp needs Windows for its writer thread. The level stays OFF,
+// so LOG_* calls in the sources under test format nothing and records are discarded.
+
+#include <icecap/agent/logging.hpp>
+
+namespace icecap::agent {
+
+class LogRing {};
+
+Logger::Logger() = default;
+
+Logger::~Logger() = default;
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+void Logger::log(LogLevel, std::string_view) {}
+
+} // namespace icecap::agent